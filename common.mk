@@ -1,6 +1,14 @@
 CUDA_ARCH = 35
 ARCH = -gencode arch=compute_${CUDA_ARCH},code=compute_${CUDA_ARCH}
-OPTIONS = -O3 -use_fast_math -w -std=c++11
+OPTIONS = -O3 -use_fast_math -w -std=c++11 -Xcompiler -fopenmp
+
+# Host SIMD for the CPU sorted-row intersections (intersectSimd), opt in
+# with e.g. make HOST_ARCH=-mavx2, -mavx512f or -march=native. Empty (the
+# default) builds the scalar merge, which runs on any host
+HOST_ARCH ?=
+ifneq ($(HOST_ARCH),)
+OPTIONS += -Xcompiler $(HOST_ARCH)
+endif
 
 MGPU_DIR = ext/moderngpu/include/
 CUB_DIR = ext/cub/cub/
@@ -15,4 +23,9 @@ LIBS = -L${BOOST_DEPS} \
 			 -lboost_program_options \
        -lcublas \
 			 -lcusparse \
-			 -lcurand
+			 -lcurand \
+			 -lgomp
+
+# Uncomment to enable NUMA interleave and replicate policies (needs libnuma)
+# OPTIONS += -DGRB_USE_NUMA
+# LIBS += -lnuma
@@ -0,0 +1,116 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/bc.hpp"
+#include "test/test.hpp"
+
+bool debug_;
+bool memory_;
+
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool transpose;
+  bool mtxinfo;
+  int  directed;
+  int  niter;
+  int  seed;
+  int  batch;
+  int  nsamples;
+  char* dat_name;
+  po::variables_map vm;
+
+  // Read in sparse matrix
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug      = vm["debug"    ].as<bool>();
+    transpose  = vm["transpose"].as<bool>();
+    mtxinfo    = vm["mtxinfo"  ].as<bool>();
+    directed   = vm["directed" ].as<int>();
+    niter      = vm["niter"    ].as<int>();
+    seed       = vm["seed"     ].as<int>();
+    batch      = vm["bcbatch"  ].as<int>();
+    nsamples   = vm["bcsamples"].as<int>();
+
+    readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows, &ncols,
+        &nvals, directed, mtxinfo, &dat_name);
+  }
+
+  // Descriptor desc
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  if (transpose)
+    CHECK(desc.toggle(graphblas::GrB_INP1));
+
+  // Betweenness centrality only runs on the CPU backend
+  CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  values.clear();
+  values.resize(nvals, 1.f);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL,
+      dat_name));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Sources: every vertex, or a sample of them
+  std::vector<graphblas::Index> sources;
+  graphblas::algorithm::bcSources(&sources, nrows, nsamples, seed);
+
+  // Vector v
+  graphblas::Vector<float> v(nrows);
+
+  // Warmup
+  CpuTimer warmup;
+  warmup.Start();
+  graphblas::algorithm::bc(&v, &a, sources, batch, &desc);
+  warmup.Stop();
+
+  std::vector<float> h_bc;
+  CHECK(v.extractTuples(&h_bc, &nrows));
+  graphblas::algorithm::verifyBc(&a, sources, h_bc);
+
+  // Benchmark
+  CpuTimer bc;
+  bc.Start();
+  float tight = 0.f;
+  for (int i = 0; i < niter; i++)
+    tight += graphblas::algorithm::bc(&v, &a, sources, batch, &desc);
+  bc.Stop();
+
+  // Each source traverses every edge once, as in Graph500 and GAP
+  double edges = static_cast<double>(sources.size())*nvals;
+  std::cout << "sources, " << sources.size() << "\n";
+  std::cout << "warmup, " << warmup.ElapsedMillis() << "\n";
+  std::cout << "tight, " << tight/niter << "\n";
+  std::cout << "bc, " << bc.ElapsedMillis()/niter << "\n";
+  if (niter) {
+    std::cout << "mteps, " << edges/(bc.ElapsedMillis()/niter)/1000.0
+        << "\n";
+    CHECK(v.extractTuples(&h_bc, &nrows));
+    graphblas::algorithm::verifyBc(&a, sources, h_bc);
+  }
+
+  return 0;
+}
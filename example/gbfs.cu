@@ -29,6 +29,7 @@ int main(int argc, char** argv) {
   bool debug;
   bool transpose;
   bool mtxinfo;
+  bool parent;
   int  directed;
   int  niter;
   int  source;
@@ -44,6 +45,7 @@ int main(int argc, char** argv) {
     debug     = vm["debug"    ].as<bool>();
     transpose = vm["transpose"].as<bool>();
     mtxinfo   = vm["mtxinfo"  ].as<bool>();
+    parent    = vm["parent"   ].as<bool>();
     directed  = vm["directed" ].as<int>();
     niter     = vm["niter"    ].as<int>();
     source    = vm["source"   ].as<int>();
@@ -71,7 +73,7 @@ int main(int argc, char** argv) {
   if (debug) CHECK(a.print());
 
   // Vector v
-  graphblas::Vector<float> v(nrows);
+  graphblas::Vector<int> v(nrows);
 
   // Cpu BFS
   CpuTimer bfs_cpu;
@@ -85,22 +87,47 @@ int main(int argc, char** argv) {
   // Warmup
   CpuTimer warmup;
   warmup.Start();
-  graphblas::algorithm::bfs(&v, &a, source, &desc);
+  graphblas::algorithm::bfs<int, float, bool>(&v, &a, source, &desc);
   warmup.Stop();
 
-  std::vector<float> h_bfs_gpu;
+  std::vector<int> h_bfs_gpu;
   CHECK(v.extractTuples(&h_bfs_gpu, &nrows));
   VERIFY_LIST(h_bfs_cpu, h_bfs_gpu, nrows);
 
+  // BFS tree
+  if (parent) {
+    graphblas::Vector<graphblas::Index> p(nrows);
+    graphblas::Vector<int> w(nrows);
+    CpuTimer parent_gpu;
+    parent_gpu.Start();
+    graphblas::algorithm::bfsParent(&p, &w, &a, source, &desc);
+    parent_gpu.Stop();
+
+    std::vector<int> h_depth;
+    std::vector<graphblas::Index> h_parent;
+    CHECK(w.extractTuples(&h_depth, &nrows));
+    CHECK(p.extractTuples(&h_parent, &nrows));
+    VERIFY_LIST(h_bfs_cpu, h_depth, nrows);
+
+    const graphblas::Index* h_rowPtr = (transpose) ?
+        a.matrix_.sparse_.h_cscColPtr_ : a.matrix_.sparse_.h_csrRowPtr_;
+    const graphblas::Index* h_colInd = (transpose) ?
+        a.matrix_.sparse_.h_cscRowInd_ : a.matrix_.sparse_.h_csrColInd_;
+    int errors = graphblas::algorithm::SimpleVerifyBfsParent(nrows, h_rowPtr,
+        h_colInd, h_depth.data(), h_parent.data(), source);
+    std::cout << "parent, " << parent_gpu.ElapsedMillis() << ", " << errors
+        << " errors\n";
+  }
+
   // Benchmark
-  graphblas::Vector<float> y(nrows);
+  graphblas::Vector<int> y(nrows);
   CpuTimer vxm_gpu;
   // cudaProfilerStart();
   vxm_gpu.Start();
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::bfs(&y, &a, source, &desc);
+    val = graphblas::algorithm::bfs<int, float, bool>(&y, &a, source, &desc);
     tight += val;
   }
   // cudaProfilerStop();
@@ -115,7 +142,7 @@ int main(int argc, char** argv) {
   std::cout << "vxm, " << elapsed_vxm/niter << "\n";
 
   if (niter) {
-    std::vector<float> h_bfs_gpu2;
+    std::vector<int> h_bfs_gpu2;
     CHECK(y.extractTuples(&h_bfs_gpu2, &nrows));
     VERIFY_LIST(h_bfs_cpu, h_bfs_gpu2, nrows);
   }
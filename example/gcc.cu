@@ -92,8 +92,7 @@ int main(int argc, char** argv) {
   if (cc_algo == 0) {
     graphblas::algorithm::cc(&v, &A, seed, &desc);
   } else if (cc_algo == 1) {
-    std::cout << "Error: CC algorithm 1 not implemented!\n";
-    //graphblas::algorithm::ccMIS(&v, &A, seed, &desc);
+    graphblas::algorithm::ccAfforest(&v, &A, seed, &desc);
   } else if (cc_algo == 2) {
     std::cout << "Error: CC algorithm 2 not implemented!\n";
     //graphblas::algorithm::ccIS(&v, &A, seed, &desc);
@@ -117,8 +116,7 @@ int main(int argc, char** argv) {
     if (cc_algo == 0) {
       val = graphblas::algorithm::cc(&v, &A, seed, &desc);
     } else if (cc_algo == 1) {
-      std::cout << "Error: CC algorithm 1 not implemented!\n";
-      //val = graphblas::algorithm::ccMIS(&v, &A, seed, &desc);
+      val = graphblas::algorithm::ccAfforest(&v, &A, seed, &desc);
     } else if (cc_algo == 2) {
       std::cout << "Error: CC algorithm 2 not implemented!\n";
       //val = graphblas::algorithm::ccIS(&v, &A, seed, &desc);
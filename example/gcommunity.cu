@@ -0,0 +1,132 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/community.hpp"
+#include "test/test.hpp"
+
+bool debug_;
+bool memory_;
+
+// Runs the community detection picked by --communityalgo
+float community(graphblas::Vector<int>*         v,
+                const graphblas::Matrix<float>* a,
+                int                             algo,
+                graphblas::Descriptor*          desc) {
+  if (algo == 0)
+    return graphblas::algorithm::louvain(v, a, desc);
+  return graphblas::algorithm::lpa(v, a, algo == 2, desc);
+}
+
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool transpose;
+  bool mtxinfo;
+  int  directed;
+  int  niter;
+  int  algo;
+  char* dat_name;
+  po::variables_map vm;
+
+  // Read in sparse matrix
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug     = vm["debug"        ].as<bool>();
+    transpose = vm["transpose"    ].as<bool>();
+    mtxinfo   = vm["mtxinfo"      ].as<bool>();
+    directed  = vm["directed"     ].as<int>();
+    niter     = vm["niter"        ].as<int>();
+    algo      = vm["communityalgo"].as<int>();
+
+    readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows, &ncols,
+        &nvals, directed, mtxinfo, &dat_name);
+  }
+
+  // Descriptor desc
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  if (transpose)
+    CHECK(desc.toggle(graphblas::GrB_INP1));
+
+  // Community detection only runs on the CPU backend
+  CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  values.clear();
+  values.resize(nvals, 1.f);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL,
+      dat_name));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Vector v
+  graphblas::Vector<int> v(nrows);
+
+  // Cpu Louvain, for the modularity it reaches. Louvain must get close to
+  // it, label propagation settles on coarser optima and gets more slack
+  CpuTimer louvain_cpu;
+  std::vector<int> h_comm_cpu;
+  louvain_cpu.Start();
+  double q_cpu = graphblas::algorithm::louvainCpu(&a, &h_comm_cpu);
+  louvain_cpu.Stop();
+  double q_tol = (algo == 0) ? 0.05 : 0.25;
+
+  // Warmup
+  CpuTimer warmup;
+  warmup.Start();
+  community(&v, &a, algo, &desc);
+  warmup.Stop();
+
+  double q;
+  std::vector<int> h_comm;
+  CHECK(graphblas::modularity(&q, &a, &v, &desc));
+  CHECK(v.extractTuples(&h_comm, &nrows));
+  graphblas::algorithm::verifyCommunity(&a, h_comm, q, q_cpu, q_tol);
+
+  // Benchmark
+  CpuTimer cd;
+  cd.Start();
+  float tight = 0.f;
+  for (int i = 0; i < niter; i++)
+    tight += community(&v, &a, algo, &desc);
+  cd.Stop();
+
+  std::sort(h_comm.begin(), h_comm.end());
+  std::cout << "communities, " << std::unique(h_comm.begin(), h_comm.end()) -
+      h_comm.begin() << "\n";
+  std::cout << "modularity, " << q << "\n";
+  std::cout << "cpu modularity, " << q_cpu << "\n";
+  std::cout << "cpu, " << louvain_cpu.ElapsedMillis() << "\n";
+  std::cout << "warmup, " << warmup.ElapsedMillis() << "\n";
+  std::cout << "tight, " << tight/niter << "\n";
+  std::cout << "community, " << cd.ElapsedMillis()/niter << "\n";
+
+  if (niter) {
+    CHECK(graphblas::modularity(&q, &a, &v, &desc));
+    CHECK(v.extractTuples(&h_comm, &nrows));
+    graphblas::algorithm::verifyCommunity(&a, h_comm, q, q_cpu, q_tol);
+  }
+
+  return 0;
+}
@@ -0,0 +1,140 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/gc.hpp"
+#include "test/test.hpp"
+
+bool debug_;
+bool memory_;
+
+// side x side grid where each point is adjacent to its 8 surrounding points
+void buildMesh(int                            side,
+               std::vector<graphblas::Index>* row_indices,
+               std::vector<graphblas::Index>* col_indices,
+               graphblas::Index*              nrows,
+               graphblas::Index*              nvals) {
+  row_indices->clear();
+  col_indices->clear();
+  for (int i = 0; i < side; ++i) {
+    for (int j = 0; j < side; ++j) {
+      for (int di = -1; di <= 1; ++di) {
+        for (int dj = -1; dj <= 1; ++dj) {
+          int ni = i + di;
+          int nj = j + dj;
+          if ((di == 0 && dj == 0) || ni < 0 || ni >= side || nj < 0 ||
+              nj >= side)
+            continue;
+          row_indices->push_back(i*side + j);
+          col_indices->push_back(ni*side + nj);
+        }
+      }
+    }
+  }
+  *nrows = side*side;
+  *nvals = row_indices->size();
+}
+
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<int> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool transpose;
+  bool mtxinfo;
+  bool partial;
+  int  directed;
+  int  niter;
+  int  mesh;
+  char* dat_name = NULL;
+  po::variables_map vm;
+
+  // Read in sparse matrix, or build a mesh
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug      = vm["debug"    ].as<bool>();
+    transpose  = vm["transpose"].as<bool>();
+    mtxinfo    = vm["mtxinfo"  ].as<bool>();
+    partial    = vm["partial"  ].as<bool>();
+    directed   = vm["directed" ].as<int>();
+    niter      = vm["niter"    ].as<int>();
+    mesh       = vm["mesh"     ].as<int>();
+
+    if (mesh > 0) {
+      buildMesh(mesh, &row_indices, &col_indices, &nrows, &nvals);
+      ncols = nrows;
+    } else {
+      readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows,
+          &ncols, &nvals, directed, mtxinfo, &dat_name);
+    }
+  }
+
+  // Descriptor desc
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  if (transpose)
+    CHECK(desc.toggle(graphblas::GrB_INP1));
+
+  // Distance-2 coloring only runs on the CPU backend
+  CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
+
+  // Matrix A
+  graphblas::Matrix<int> a(nrows, ncols);
+  values.clear();
+  values.resize(nvals, 1.f);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL,
+      dat_name));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Vector v
+  graphblas::Vector<int> v(ncols);
+
+  // Warmup
+  CpuTimer warmup;
+  warmup.Start();
+  graphblas::algorithm::gcDistance2(&v, &a, partial, &desc);
+  warmup.Stop();
+
+  std::vector<int> h_gc;
+  CHECK(v.extractTuples(&h_gc, &ncols));
+  graphblas::algorithm::verifyD2Gc(&a, h_gc, partial);
+
+  // Benchmark
+  CpuTimer d2gc;
+  d2gc.Start();
+  float tight = 0.f;
+  for (int i = 0; i < niter; i++)
+    tight += graphblas::algorithm::gcDistance2(&v, &a, partial, &desc);
+  d2gc.Stop();
+
+  int ncolors = *std::max_element(h_gc.begin(), h_gc.end());
+  std::cout << "colors, " << ncolors << "\n";
+  std::cout << "warmup, " << warmup.ElapsedMillis() << "\n";
+  std::cout << "tight, " << tight/niter << "\n";
+  std::cout << "d2gc, " << d2gc.ElapsedMillis()/niter << "\n";
+
+  if (niter) {
+    CHECK(v.extractTuples(&h_gc, &ncols));
+    graphblas::algorithm::verifyD2Gc(&a, h_gc, partial);
+  }
+
+  return 0;
+}
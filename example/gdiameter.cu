@@ -72,9 +72,6 @@ int main(int argc, char** argv) {
   CHECK(a.nvals(&nvals));
   if (debug) CHECK(a.print());
 
-  // Vector v
-  graphblas::Vector<float> v(nrows);
-
   // Cpu BFS
   /*CpuTimer bfs_cpu;
   graphblas::Index* h_bfs_cpu = reinterpret_cast<graphblas::Index*>(
@@ -92,7 +89,7 @@ int main(int argc, char** argv) {
   source_end   = std::max(0, std::min(nrows-1, source_end));
   CpuTimer warmup;
   warmup.Start();
-  std::pair<int, int> val = graphblas::algorithm::diameter(&v, &a, source_start,
+  std::pair<int, int> val = graphblas::algorithm::diameter(&a, source_start,
       source_end, &desc);
   warmup.Stop();
 
@@ -100,5 +97,16 @@ int main(int argc, char** argv) {
     source_end - source_start << ", " << warmup.ElapsedMillis()/(source_end - source_start) << ", \n";
   std::cout << "diameter " << source_start << ":" << source_end << ": " << val.first << " from " << val.second << std::endl;
 
+  // Exact diameter by iFUB
+  graphblas::Index exact, u, v;
+  CpuTimer ifub;
+  ifub.Start();
+  CHECK(graphblas::algorithm::diameterExact(&exact, &u, &v, GrB_NULL, &a,
+      &desc));
+  ifub.Stop();
+  std::cout << "ifub, " << ifub.ElapsedMillis() << ", \n";
+  std::cout << "diameter exact: " << exact << " between " << u << " and " <<
+      v << std::endl;
+
   return 0;
 }
@@ -34,6 +34,7 @@ int main(int argc, char** argv) {
   int  seed;
   int  max_colors;
   int  gc_algo;
+  int  gc_order;
   char* dat_name;
   po::variables_map vm;
 
@@ -51,6 +52,7 @@ int main(int argc, char** argv) {
     seed       = vm["seed"     ].as<int>();
     max_colors = vm["maxcolors"].as<int>();
     gc_algo    = vm["gcalgo"   ].as<int>();
+    gc_order   = vm["gcorder"  ].as<int>();
 
     // This is an imperfect solution, because this should happen in
     // desc.loadArgs(vm) instead of application code!
@@ -97,6 +99,8 @@ int main(int argc, char** argv) {
     graphblas::algorithm::gcMIS(&v, &a, seed, max_colors, &desc);
   else if (gc_algo == 2)
     graphblas::algorithm::gcIS(&v, &a, seed, max_colors, &desc);
+  else if (gc_algo == 3)
+    graphblas::algorithm::gcGreedy(&v, &a, seed, max_colors, gc_order, &desc);
   else
     std::cout << "Error: Invalid graph coloring algorithm selected!\n";
   warmup.Stop();
@@ -119,6 +123,9 @@ int main(int argc, char** argv) {
       val = graphblas::algorithm::gcMIS(&v, &a, seed, max_colors, &desc);
     } else if (gc_algo == 2) {
       val = graphblas::algorithm::gcIS(&v, &a, seed, max_colors, &desc);
+    } else if (gc_algo == 3) {
+      val = graphblas::algorithm::gcGreedy(&v, &a, seed, max_colors, gc_order,
+          &desc);
     } else {
       std::cout << "Error: Invalid graph coloring algorithm selected!\n";
       break;
@@ -0,0 +1,121 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/kcore.hpp"
+#include "test/test.hpp"
+
+bool debug_;
+bool memory_;
+
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<int> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool transpose;
+  bool mtxinfo;
+  int  directed;
+  int  niter;
+  int  kcore_algo;
+  char* dat_name;
+  po::variables_map vm;
+
+  // Read in sparse matrix
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug      = vm["debug"    ].as<bool>();
+    transpose  = vm["transpose"].as<bool>();
+    mtxinfo    = vm["mtxinfo"  ].as<bool>();
+    directed   = vm["directed" ].as<int>();
+    niter      = vm["niter"    ].as<int>();
+    kcore_algo = vm["kcorealgo"].as<int>();
+
+    readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows, &ncols,
+        &nvals, directed, mtxinfo, &dat_name);
+  }
+
+  // Descriptor desc
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  if (transpose)
+    CHECK(desc.toggle(graphblas::GrB_INP1));
+
+  // Bucket peeling only runs on the CPU backend
+  if (kcore_algo == 1)
+    CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
+
+  // Matrix A
+  graphblas::Matrix<int> a(nrows, ncols);
+  values.clear();
+  values.resize(nvals, 1);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL,
+      dat_name));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Vector v
+  graphblas::Vector<int> v(nrows);
+
+  // Cpu k-core
+  CpuTimer kcore_cpu;
+  std::vector<int> h_kcore_cpu;
+  kcore_cpu.Start();
+  int max_core = graphblas::algorithm::kcoreCpu(&a, &h_kcore_cpu);
+  kcore_cpu.Stop();
+
+  // Warmup
+  CpuTimer warmup;
+  warmup.Start();
+  if (kcore_algo == 1)
+    graphblas::algorithm::kcore(&v, &a, &desc);
+  else
+    graphblas::algorithm::kcoreGrb(&v, &a, &desc);
+  warmup.Stop();
+
+  std::vector<int> h_kcore;
+  CHECK(v.extractTuples(&h_kcore, &nrows));
+  graphblas::algorithm::SimpleVerifyKcore(h_kcore_cpu, h_kcore);
+
+  // Benchmark
+  CpuTimer kcore;
+  kcore.Start();
+  float tight = 0.f;
+  for (int i = 0; i < niter; i++) {
+    if (kcore_algo == 1)
+      tight += graphblas::algorithm::kcore(&v, &a, &desc);
+    else
+      tight += graphblas::algorithm::kcoreGrb(&v, &a, &desc);
+  }
+  kcore.Stop();
+
+  std::cout << "max core, " << max_core << "\n";
+  std::cout << "cpu, " << kcore_cpu.ElapsedMillis() << "\n";
+  std::cout << "warmup, " << warmup.ElapsedMillis() << "\n";
+  std::cout << "tight, " << tight/niter << "\n";
+  std::cout << "kcore, " << kcore.ElapsedMillis()/niter << "\n";
+
+  if (niter) {
+    CHECK(v.extractTuples(&h_kcore, &nrows));
+    graphblas::algorithm::SimpleVerifyKcore(h_kcore_cpu, h_kcore);
+  }
+
+  return 0;
+}
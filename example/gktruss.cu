@@ -0,0 +1,118 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/ktruss.hpp"
+#include "test/test.hpp"
+
+bool debug_;
+bool memory_;
+
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<int> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool transpose;
+  bool mtxinfo;
+  int  directed;
+  int  niter;
+  int  k;
+  char* dat_name;
+  po::variables_map vm;
+
+  // Read in sparse matrix
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug     = vm["debug"    ].as<bool>();
+    transpose = vm["transpose"].as<bool>();
+    mtxinfo   = vm["mtxinfo"  ].as<bool>();
+    directed  = vm["directed" ].as<int>();
+    niter     = vm["niter"    ].as<int>();
+    k         = vm["ktrussk"  ].as<int>();
+
+    readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows, &ncols,
+        &nvals, directed, mtxinfo, &dat_name);
+  }
+
+  // Descriptor desc
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  if (transpose)
+    CHECK(desc.toggle(graphblas::GrB_INP1));
+
+  // Support peeling only runs on the CPU backend
+  CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
+
+  // Matrix A
+  graphblas::Matrix<int> a(nrows, ncols);
+  values.clear();
+  values.resize(nvals, 1);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL,
+      dat_name));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Matrix C
+  graphblas::Matrix<int> c(nrows, ncols);
+
+  // Cpu k-truss
+  CpuTimer ktruss_cpu;
+  std::vector<graphblas::Index> h_row_cpu, h_col_cpu;
+  std::vector<int> h_val_cpu;
+  ktruss_cpu.Start();
+  int result = graphblas::algorithm::ktrussCpu(&a, k, &h_row_cpu, &h_col_cpu,
+      &h_val_cpu);
+  ktruss_cpu.Stop();
+
+  // Warmup
+  CpuTimer warmup;
+  warmup.Start();
+  graphblas::algorithm::ktruss(&c, &a, k, &desc);
+  warmup.Stop();
+
+  graphblas::algorithm::verifyKtruss(&a, k, &c);
+
+  // Benchmark
+  CpuTimer ktruss;
+  ktruss.Start();
+  float tight = 0.f;
+  for (int i = 0; i < niter; i++)
+    tight += graphblas::algorithm::ktruss(&c, &a, k, &desc);
+  ktruss.Stop();
+
+  // Each undirected edge is stored twice in A
+  double edges = nvals/2.0;
+  if (k == 0)
+    std::cout << "max truss, " << result << "\n";
+  else
+    std::cout << "truss edges, " << result/2 << "\n";
+  std::cout << "cpu, " << ktruss_cpu.ElapsedMillis() << "\n";
+  std::cout << "warmup, " << warmup.ElapsedMillis() << "\n";
+  std::cout << "tight, " << tight/niter << "\n";
+  std::cout << "ktruss, " << ktruss.ElapsedMillis()/niter << "\n";
+  if (niter) {
+    std::cout << "medges/s, " << edges/(ktruss.ElapsedMillis()/niter)/1000.0
+        << "\n";
+    graphblas::algorithm::verifyKtruss(&a, k, &c);
+  }
+
+  return 0;
+}
@@ -33,6 +33,7 @@ int main(int argc, char** argv) {
   int  niter;
   int  max_niter;
   int  source;
+  int  lgcalgo;
   char* dat_name;
   po::variables_map vm;
 
@@ -49,6 +50,7 @@ int main(int argc, char** argv) {
     niter     = vm["niter"    ].as<int>();
     max_niter = vm["max_niter"].as<int>();
     source    = vm["source"   ].as<int>();
+    lgcalgo   = vm["lgcalgo"  ].as<int>();
 
     /*!
      * This is an imperfect solution, because this should happen in 
@@ -90,14 +92,34 @@ int main(int argc, char** argv) {
       transpose);
   lgc_cpu.Stop();
 
+  // Batched seeds start at source, whose column is checked
+  std::vector<graphblas::Index> seeds;
+  for (int k = 0; k < std::min(nrows, 32); ++k)
+    seeds.push_back((source + k) % nrows);
+  graphblas::Matrix<float> p(nrows, seeds.size());
+
   // Warmup
   CpuTimer warmup;
   warmup.Start();
-  graphblas::algorithm::lgc(&v, &a, source, alpha, eps, &desc);
+  if (lgcalgo == 0)
+    graphblas::algorithm::lgc(&v, &a, source, alpha, eps, &desc);
+  else if (lgcalgo == 3)
+    graphblas::algorithm::lgcAcl(&v, &a, source, alpha, eps, &desc);
+  else
+    graphblas::algorithm::batchPpr(&p, &a, seeds, alpha, eps, lgcalgo == 2,
+        &desc);
   warmup.Stop();
 
   std::vector<float> h_lgc_gpu;
-  CHECK(v.extractTuples(&h_lgc_gpu, &nrows));
+  if (lgcalgo == 0 || lgcalgo == 3) {
+    CHECK(v.extractTuples(&h_lgc_gpu, &nrows));
+  } else {
+    std::vector<float> h_ppr_gpu;
+    graphblas::Index   nvals_p = nrows*seeds.size();
+    CHECK(p.extractTuples(&h_ppr_gpu, &nvals_p));
+    for (graphblas::Index i = 0; i < nrows; ++i)
+      h_lgc_gpu.push_back(h_ppr_gpu[i*seeds.size()]);
+  }
   VERIFY_LIST_FLOAT(h_lgc_cpu, h_lgc_gpu, nrows);
 
   // Benchmark
@@ -108,7 +130,13 @@ int main(int argc, char** argv) {
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::lgc(&y, &a, source, alpha, eps, &desc);
+    if (lgcalgo == 0)
+      val = graphblas::algorithm::lgc(&y, &a, source, alpha, eps, &desc);
+    else if (lgcalgo == 3)
+      val = graphblas::algorithm::lgcAcl(&y, &a, source, alpha, eps, &desc);
+    else
+      val = graphblas::algorithm::batchPpr(&p, &a, seeds, alpha, eps,
+          lgcalgo == 2, &desc);
     tight += val;
   }
   // cudaProfilerStop();
@@ -122,7 +150,7 @@ int main(int argc, char** argv) {
   std::cout << "tight, " << tight/niter << "\n";
   std::cout << "vxm, " << elapsed_vxm/niter << "\n";
 
-  if (niter) {
+  if (niter && (lgcalgo == 0 || lgcalgo == 3)) {
     std::vector<float> h_lgc_gpu2;
     CHECK(y.extractTuples(&h_lgc_gpu2, &nrows));
     VERIFY_LIST_FLOAT(h_lgc_cpu, h_lgc_gpu2, nrows);
@@ -32,6 +32,7 @@ int main(int argc, char** argv) {
   int  directed;
   int  niter;
   int  source;
+  int  mis_algo;
   char* dat_name;
   po::variables_map vm;
 
@@ -47,6 +48,7 @@ int main(int argc, char** argv) {
     directed   = vm["directed" ].as<int>();
     niter      = vm["niter"    ].as<int>();
     source     = vm["source"   ].as<int>();
+    mis_algo   = vm["misalgo"  ].as<int>();
 
     // This is an imperfect solution, because this should happen in
     // desc.loadArgs(vm) instead of application code!
@@ -87,7 +89,10 @@ int main(int argc, char** argv) {
   // Warmup
   CpuTimer warmup;
   warmup.Start();
-  graphblas::algorithm::mis(&v, &a, source, &desc);
+  if (mis_algo == 1)
+    graphblas::algorithm::misBitmap(&v, &a, source, &desc);
+  else
+    graphblas::algorithm::mis(&v, &a, source, &desc);
   warmup.Stop();
 
   std::vector<int> h_mis_gpu;
@@ -102,7 +107,10 @@ int main(int argc, char** argv) {
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::mis(&v, &a, source, &desc);
+    if (mis_algo == 1)
+      val = graphblas::algorithm::misBitmap(&v, &a, source, &desc);
+    else
+      val = graphblas::algorithm::mis(&v, &a, source, &desc);
     tight += val;
   }
   // cudaProfilerStop();
@@ -32,6 +32,7 @@ int main(int argc, char** argv) {
   int  directed;
   int  niter;
   int  max_niter;
+  int  pralgo;
   char* dat_name;
   po::variables_map vm;
 
@@ -47,6 +48,7 @@ int main(int argc, char** argv) {
     directed  = vm["directed" ].as<int>();
     niter     = vm["niter"    ].as<int>();
     max_niter = vm["max_niter"].as<int>();
+    pralgo    = vm["pralgo"   ].as<int>();
 
     /*!
      * This is an imperfect solution, because this should happen in 
@@ -113,7 +115,10 @@ int main(int argc, char** argv) {
   // Warmup
   CpuTimer warmup;
   warmup.Start();
-  graphblas::algorithm::pr(&v, &a, alpha, eps, &desc);
+  if (pralgo == 0)
+    graphblas::algorithm::pr(&v, &a, alpha, eps, &desc);
+  else
+    graphblas::algorithm::prDelta(&v, &a, alpha, eps, pralgo == 2, &desc);
   warmup.Stop();
 
   std::vector<float> h_pr_gpu;
@@ -128,7 +133,11 @@ int main(int argc, char** argv) {
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::pr(&y, &a, alpha, eps, &desc);
+    if (pralgo == 0)
+      val = graphblas::algorithm::pr(&y, &a, alpha, eps, &desc);
+    else
+      val = graphblas::algorithm::prDelta(&y, &a, alpha, eps, pralgo == 2,
+          &desc);
     tight += val;
   }
   // cudaProfilerStop();
@@ -33,6 +33,7 @@ int main(int argc, char** argv) {
   int  niter;
   int  source;
   int  seed;
+  float delta;
   char* dat_name;
   po::variables_map vm;
 
@@ -49,6 +50,7 @@ int main(int argc, char** argv) {
     niter     = vm["niter"    ].as<int>();
     source    = vm["source"   ].as<int>();
     seed      = vm["seed"     ].as<int>();
+    delta     = vm["delta"    ].as<float>();
 
     /*!
      * This is an imperfect solution, because this should happen in
@@ -99,7 +101,10 @@ int main(int argc, char** argv) {
   // Warmup
   CpuTimer warmup;
   warmup.Start();
-  graphblas::algorithm::sssp(&v, &a, source, &desc);
+  if (delta >= 0.f)
+    graphblas::algorithm::ssspDelta(&v, &a, source, delta, &desc);
+  else
+    graphblas::algorithm::sssp(&v, &a, source, &desc);
   warmup.Stop();
 
   std::vector<float> h_sssp_gpu;
@@ -114,7 +119,10 @@ int main(int argc, char** argv) {
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::sssp(&y, &a, source, &desc);
+    if (delta >= 0.f)
+      val = graphblas::algorithm::ssspDelta(&y, &a, source, delta, &desc);
+    else
+      val = graphblas::algorithm::sssp(&y, &a, source, &desc);
     tight += val;
   }
   // cudaProfilerStop();
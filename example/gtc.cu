@@ -33,6 +33,7 @@ int main(int argc, char** argv) {
   int  directed;
   int  niter;
   int  max_niter;
+  int  tcalgo;
   char* dat_name;
   po::variables_map vm;
 
@@ -49,6 +50,7 @@ int main(int argc, char** argv) {
     directed        = vm["directed"       ].as<int>();
     niter           = vm["niter"          ].as<int>();
     max_niter       = vm["max_niter"      ].as<int>();
+    tcalgo          = vm["tcalgo"         ].as<int>();
 
     /*!
      * This is an imperfect solution, because this should happen in 
@@ -76,6 +78,11 @@ int main(int argc, char** argv) {
   CHECK(a.ncols(&ncols));
   CHECK(a.nvals(&nvals));
 
+  // Degree-ordered TC starts from the full matrix
+  graphblas::Matrix<int> full(nrows, ncols);
+  if (tcalgo > 0)
+    CHECK(full.dup(&a));
+
   // Get lower triangular of matrix A
   CHECK(desc.set(GrB_BACKEND, GrB_SEQUENTIAL));
   graphblas::tril<int, int>(&a, &a, &desc);
@@ -84,6 +91,7 @@ int main(int argc, char** argv) {
   if (debug) CHECK(a.print());
 
   graphblas::Matrix<int> b(nrows, ncols);
+  graphblas::Matrix<int> l(nrows, ncols);
 
   // Cpu PR
   CpuTimer tc_cpu;
@@ -98,7 +106,11 @@ int main(int argc, char** argv) {
   CpuTimer warmup;
   int ntris_gpu;
   warmup.Start();
-  graphblas::algorithm::tc(&ntris_gpu, &a, &b, &desc);
+  if (tcalgo == 0)
+    graphblas::algorithm::tc(&ntris_gpu, &a, &b, &desc);
+  else
+    graphblas::algorithm::tcDegree(&ntris_gpu, &full, &l, &b, tcalgo == 2,
+        &desc);
   warmup.Stop();
   if (!skip_cpu_verify)
     VERIFY(ntris_cpu, ntris_gpu);
@@ -111,7 +123,11 @@ int main(int argc, char** argv) {
   float tight = 0.f;
   float val;
   for (int i = 0; i < niter; i++) {
-    val = graphblas::algorithm::tc(&ntris_gpu, &a, &b, &desc);
+    if (tcalgo == 0)
+      val = graphblas::algorithm::tc(&ntris_gpu, &a, &b, &desc);
+    else
+      val = graphblas::algorithm::tcDegree(&ntris_gpu, &full, &l, &b,
+          tcalgo == 2, &desc);
     tight += val;
   }
   // cudaProfilerStop();
@@ -0,0 +1,75 @@
+#ifndef GRAPHBLAS_ALGORITHM_BC_HPP_
+#define GRAPHBLAS_ALGORITHM_BC_HPP_
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "graphblas/algorithm/test_bc.hpp"
+#include "graphblas/backend/cuda/util.hpp"
+
+namespace graphblas {
+namespace algorithm {
+
+// Sources for bc: every vertex if nsamples <= 0 or nsamples >= nrows (exact
+// betweenness centrality), else nsamples distinct vertices drawn with seed
+void bcSources(std::vector<Index>* sources,
+               Index               nrows,
+               Index               nsamples,
+               int                 seed) {
+  sources->resize(nrows);
+  std::iota(sources->begin(), sources->end(), 0);
+  if (nsamples <= 0 || nsamples >= nrows)
+    return;
+  std::mt19937 gen(seed);
+  std::shuffle(sources->begin(), sources->end(), gen);
+  sources->resize(nsamples);
+  std::sort(sources->begin(), sources->end());
+}
+
+// Betweenness centrality from sources, batch sources at a time, on the CPU
+// backend. Sampled sources are scaled by nrows/sources.size() to estimate
+// the exact score. The caller can report sources.size()*nvals edges over the
+// returned time as TEPS.
+template <typename T, typename a>
+float bc(Vector<T>*                v,
+         const Matrix<a>*          A,
+         const std::vector<Index>& sources,
+         Index                     batch,
+         Descriptor*               desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+  double scale = static_cast<double>(A_nrows)/sources.size();
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(bcBatch<T, a>(v, A, &sources, batch, scale, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "bc, " << sources.size() << ", " << batch << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+template <typename a>
+void bcCpu(const Matrix<a>*          A,
+           const std::vector<Index>& sources,
+           std::vector<double>*      h_bc_cpu) {
+  SimpleReferenceBc(A->matrix_.nrows_, A->matrix_.sparse_.h_csrRowPtr_,
+      A->matrix_.sparse_.h_csrColInd_, sources,
+      static_cast<double>(A->matrix_.nrows_)/sources.size(), h_bc_cpu);
+}
+
+template <typename T, typename a>
+int verifyBc(const Matrix<a>*          A,
+             const std::vector<Index>& sources,
+             const std::vector<T>&     h_bc) {
+  std::vector<double> h_bc_cpu;
+  bcCpu(A, sources, &h_bc_cpu);
+  return SimpleVerifyBc(h_bc_cpu, h_bc);
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_BC_HPP_
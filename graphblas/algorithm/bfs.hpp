@@ -10,34 +10,39 @@
 namespace graphblas {
 namespace algorithm {
 
-// Use float for now for both v and A
-float bfs(Vector<float>*       v,
-          const Matrix<float>* A,
-          Index                s,
-          Descriptor*          desc) {
+// Depths are written to v as T (e.g. int), A is only read for its structure
+// so any value type works, and frontiers are stored as F (e.g. bool or
+// uint8_t). F defaults to T so that existing callers are unchanged.
+template <typename T, typename a, typename F = T>
+float bfs(Vector<T>*       v,
+          const Matrix<a>* A,
+          Index            s,
+          Descriptor*      desc) {
   Index A_nrows;
   CHECK(A->nrows(&A_nrows));
 
-  // Visited vector (use float for now)
-  CHECK(v->fill(0.f));
+  // Visited vector
+  CHECK(v->fill(static_cast<T>(0)));
 
-  // Frontier vectors (use float for now)
-  Vector<float> f1(A_nrows);
-  Vector<float> f2(A_nrows);
+  // Frontier vectors
+  Vector<F> f1(A_nrows);
+  Vector<F> f2(A_nrows);
 
   Desc_value desc_value;
   CHECK(desc->get(GrB_MXVMODE, &desc_value));
   if (desc_value == GrB_PULLONLY) {
-    CHECK(f1.fill(0.f));
-    CHECK(f1.setElement(1.f, s));
+    CHECK(f1.fill(static_cast<F>(0)));
+    CHECK(f1.setElement(static_cast<F>(1), s));
   } else {
     std::vector<Index> indices(1, s);
-    std::vector<float>  values(1, 1.f);
+    std::vector<F>     values(1, static_cast<F>(1));
     CHECK(f1.build(&indices, &values, 1, GrB_NULL));
   }
+  Desc_value repl_mode;
+  CHECK(desc->get(GrB_OUTP, &repl_mode));
 
-  float iter;
-  float succ = 0.f;
+  Index iter;
+  Index succ = 0;
   Index unvisited = A_nrows;
   backend::GpuTimer gpu_tight;
   float gpu_tight_time = 0.f;
@@ -59,18 +64,22 @@ float bfs(Vector<float>*       v,
             << gpu_tight.ElapsedMillis() << "\n";
       gpu_tight_time += gpu_tight.ElapsedMillis();
     }
-    unvisited -= static_cast<int>(succ);
+    unvisited -= succ;
     gpu_tight.Start();
 
-    assign<float, float, float, Index>(v, &f1, GrB_NULL, iter, GrB_ALL, A_nrows,
-        desc);
+    assign<T, F, T, Index>(v, &f1, GrB_NULL, static_cast<T>(iter), GrB_ALL,
+        A_nrows, desc);
+    // Next frontier and its size in one pass when the backend can fuse them.
+    // f2 still holds an old frontier, so visited rows must be cleared
     CHECK(desc->toggle(GrB_MASK));
-    vxm<float, float, float, float>(&f2, v, GrB_NULL,
-        LogicalOrAndSemiring<float>(), &f1, A, desc);
+    CHECK(desc->set(GrB_OUTP, GrB_REPLACE));
+    Info info = vxmReduce<F, Index, T, F, a>(&f2, &succ, v, GrB_NULL,
+        PlusMonoid<Index>(), LogicalOrAndSemiring<F, a, F>(), &f1, A, desc);
+    CHECK(desc->set(GrB_OUTP, repl_mode));
     CHECK(desc->toggle(GrB_MASK));
+    CHECK(info);
 
     CHECK(f2.swap(&f1));
-    reduce<float, float>(&succ, GrB_NULL, PlusMonoid<float>(), &f1, desc);
 
     if (desc->descriptor_.debug())
       std::cout << "succ: " << succ << std::endl;
@@ -88,13 +97,138 @@ float bfs(Vector<float>*       v,
   return gpu_tight_time;
 }
 
+// Body of bfsParent, run with structure-only cleared
+template <typename T, typename a>
+float bfsParentInner(Vector<Index>*   p,
+                     Vector<T>*       v,
+                     const Matrix<a>* A,
+                     Index            s,
+                     Descriptor*      desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+
+  // Visited vector
+  CHECK(v->fill(static_cast<T>(0)));
+
+  // Parent vector (offset by one until the end)
+  CHECK(p->fill(0));
+  CHECK(p->setElement(s + 1, s));
+
+  // Vertex ids offset by one
+  Vector<Index> ids(A_nrows);
+  CHECK(ids.fillAscending(A_nrows));
+  CHECK(eWiseAdd<Index, Index, Index, Index>(&ids, GrB_NULL, GrB_NULL,
+      PlusMultipliesSemiring<Index>(), &ids, 1, desc));
+
+  // Frontier vectors
+  Vector<Index> f1(A_nrows);
+  Vector<Index> f2(A_nrows);
+
+  Desc_value desc_value;
+  CHECK(desc->get(GrB_MXVMODE, &desc_value));
+  if (desc_value == GrB_PULLONLY) {
+    CHECK(f1.fill(0));
+    CHECK(f1.setElement(s + 1, s));
+  } else {
+    std::vector<Index> indices(1, s);
+    std::vector<Index> values(1, s + 1);
+    CHECK(f1.build(&indices, &values, 1, GrB_NULL));
+  }
+
+  Index iter;
+  Index succ = 1;
+  backend::GpuTimer gpu_tight;
+  float gpu_tight_time = 0.f;
+  gpu_tight.Start();
+
+  for (iter = 1; iter <= desc->descriptor_.max_niter_; ++iter) {
+    if (desc->descriptor_.debug()) {
+      std::cout << "=====BFS Parent Iteration " << iter - 1 << "=====\n";
+      v->print();
+      f1.print();
+    }
+    gpu_tight.Stop();
+    if (iter > 1) {
+      std::string vxm_mode = (desc->descriptor_.lastmxv_ == GrB_PUSHONLY) ?
+          "push" : "pull";
+      if (desc->descriptor_.timing_ == 1)
+        std::cout << iter - 1 << ", " << vxm_mode << ", "
+            << gpu_tight.ElapsedMillis() << "\n";
+      gpu_tight_time += gpu_tight.ElapsedMillis();
+    }
+    gpu_tight.Start();
+
+    CHECK(assign<T, Index, T, Index>(v, &f1, GrB_NULL, static_cast<T>(iter),
+        GrB_ALL, A_nrows, desc));
+    CHECK(desc->toggle(GrB_MASK));
+    Info info = vxm<Index, T, Index, a>(&f2, v, GrB_NULL,
+        MaximumSelectSecondSemiring<a, Index, Index>(), &f1, A, desc);
+    CHECK(desc->toggle(GrB_MASK));
+    CHECK(info);
+
+    // f2 holds the parent of each newly discovered vertex: record it, then
+    // replace it by the vertex's own id for the next step
+    CHECK(eWiseAdd<Index, Index, Index, Index>(p, GrB_NULL, GrB_NULL,
+        MaximumSelectSecondSemiring<Index>(), p, &f2, desc));
+    CHECK(eWiseMult<Index, Index, Index, Index>(&f1, GrB_NULL, GrB_NULL,
+        MaximumSelectSecondSemiring<Index>(), &f2, &ids, desc));
+
+    // Ids are positive, so the largest one is 0 iff the frontier is empty
+    CHECK(reduce<Index, Index>(&succ, GrB_NULL, MaximumMonoid<Index>(), &f1,
+        desc));
+
+    if (desc->descriptor_.debug())
+      std::cout << "succ: " << succ << std::endl;
+    if (succ == 0)
+      break;
+  }
+
+  // Undo the offset, which also maps unreached vertices to -1
+  CHECK(eWiseAdd<Index, Index, Index, Index>(p, GrB_NULL, GrB_NULL,
+      PlusMultipliesSemiring<Index>(), p, -1, desc));
+
+  gpu_tight.Stop();
+  std::string vxm_mode = (desc->descriptor_.lastmxv_ == GrB_PUSHONLY) ?
+      "push" : "pull";
+  if (desc->descriptor_.timing_ == 1)
+    std::cout << iter << ", " << vxm_mode << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  gpu_tight_time += gpu_tight.ElapsedMillis();
+  return gpu_tight_time;
+}
+
+// BFS that also returns the BFS tree: p(i) is the parent of i on a shortest
+// path from s, p(s) = s, and p(i) = -1 if i is unreachable. Depths are written
+// to v as in bfs.
+//
+// Frontier values carry vertex ids offset by one, so that 0 stays the
+// MaximumMonoid identity and frontiers still work as value masks. Each
+// vxm with MaximumSelectSecondSemiring then gives every discovered vertex
+// the id of a neighbour in the frontier, i.e. its parent. In pull direction
+// with early exit that is the first neighbour found rather than the largest.
+template <typename T, typename a>
+float bfsParent(Vector<Index>*   p,
+                Vector<T>*       v,
+                const Matrix<a>* A,
+                Index            s,
+                Descriptor*      desc) {
+  // Parents are key-value, so the structure-only push path cannot be used.
+  // The caller's setting comes back on every return, errors included
+  bool struconly = desc->descriptor_.struconly_;
+  desc->descriptor_.struconly_ = false;
+  float gpu_tight_time = bfsParentInner(p, v, A, s, desc);
+  desc->descriptor_.struconly_ = struconly;
+  return gpu_tight_time;
+}
+
 template <typename T, typename a>
 int bfsCpu(Index        source,
            Matrix<a>*   A,
            T*           h_bfs_cpu,
            Index        depth,
-           bool         transpose = false) {
-  Index* reference_check_preds = NULL;
+           bool         transpose = false,
+           Index*       h_parent_cpu = NULL) {
+  Index* reference_check_preds = h_parent_cpu;
   int max_depth;
 
   if (transpose)
@@ -135,6 +135,28 @@ float cc(Vector<int>*       v,
   return 0.f;
 }
 
+// Connected components by Afforest on the CPU backend. Falls back to cc on
+// the GPU. Code is based on the algorithm described in the following paper.
+// Sutton, Ben-Nun, Barak. Optimizing Parallel Graph Connectivity
+// Computation via Subgraph Sampling (IPDPS 2018).
+float ccAfforest(Vector<int>*       v,
+                 const Matrix<int>* A,
+                 int                seed,
+                 Descriptor*        desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return cc(v, A, seed, desc);
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(afforest<int, int>(v, A, seed, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "afforest, " << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename a>
 int ccCpu(Index             seed,
           Matrix<a>*        A,
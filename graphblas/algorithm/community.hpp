@@ -0,0 +1,162 @@
+#ifndef GRAPHBLAS_ALGORITHM_COMMUNITY_HPP_
+#define GRAPHBLAS_ALGORITHM_COMMUNITY_HPP_
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "graphblas/algorithm/test_community.hpp"
+#include "graphblas/backend/cuda/util.hpp"
+
+namespace graphblas {
+namespace algorithm {
+
+/*!
+ * \brief Label propagation community detection, which only runs on the CPU
+ *        backend. Neighbour labels are counted in thread-local hash maps.
+ * \param v output vector which stores the label of each vertex
+ * \param A adjacency matrix of graph, symmetric
+ * \param async update labels in place instead of once per iteration
+ * \param desc pointer to descriptor
+ */
+float lpa(Vector<int>*         v,
+          const Matrix<float>* A,
+          bool                 async,
+          Descriptor*          desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(labelProp<int, float>(v, A, async, desc));
+  gpu_tight.Stop();
+
+  if (desc->descriptor_.timing_ > 0) {
+    double q;
+    CHECK(modularity<float, int>(&q, A, v, desc));
+    std::cout << "lpa, " << gpu_tight.ElapsedMillis() << ", modularity "
+        << q << "\n";
+  }
+  return gpu_tight.ElapsedMillis();
+}
+
+/*!
+ * \brief Multi-level Louvain community detection, which only runs on the
+ *        CPU backend. Each level moves vertices of the current graph G into
+ *        communities, then coarsens G into P^T G P by two SpGEMMs, where
+ *        P(i, c) = 1 if vertex i of G is in community c. Levels repeat until
+ *        the moving phase merges nothing. The moving and coarsening phases
+ *        of every level are timed separately.
+ * \param v output vector which stores the community of each vertex
+ * \param A adjacency matrix of graph, symmetric, may be weighted
+ * \param desc pointer to descriptor
+ */
+float louvain(Vector<int>*         v,
+              const Matrix<float>* A,
+              Descriptor*          desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+
+  // Community of each vertex of A, and the graph of the current level (G)
+  std::vector<int> h_label(A_nrows);
+  for (Index i = 0; i < A_nrows; ++i)
+    h_label[i] = i;
+  Matrix<float> G;
+  CHECK(G.dup(A));
+
+  int   level        = 0;
+  float move_time    = 0.f;
+  float coarsen_time = 0.f;
+  Index G_nrows      = A_nrows;
+  std::vector<int>   h_comm;
+  std::vector<Index> row_indices;
+  std::vector<Index> col_indices;
+  backend::GpuTimer gpu_tight;
+  backend::GpuTimer gpu_phase;
+  gpu_tight.Start();
+  while (level < desc->descriptor_.max_niter_) {
+    // 1) Local moving: community of each vertex of G
+    gpu_phase.Start();
+    Vector<int> comm(G_nrows);
+    CHECK(louvainMove<int, float>(&comm, &G, desc));
+    CHECK(comm.extractTuples(&h_comm, &G_nrows));
+    gpu_phase.Stop();
+    move_time += gpu_phase.ElapsedMillis();
+    float level_move = gpu_phase.ElapsedMillis();
+
+    Index ncomm = *std::max_element(h_comm.begin(), h_comm.end()) + 1;
+    for (Index i = 0; i < A_nrows; ++i)
+      h_label[i] = h_comm[h_label[i]];
+
+    double q = 0.;
+    if (desc->descriptor_.timing_ > 0)
+      CHECK(modularity<float, int>(&q, &G, &comm, desc));
+    if (ncomm == G_nrows) {
+      if (desc->descriptor_.timing_ > 0)
+        std::cout << "louvain level " << level << ", " << G_nrows << " -> "
+            << ncomm << ", move " << level_move << ", modularity " << q
+            << "\n";
+      break;
+    }
+
+    // 2) Coarsening: G = P^T G P, with P^T built directly so neither
+    // product needs a transpose
+    gpu_phase.Start();
+    row_indices.resize(G_nrows);
+    col_indices.resize(G_nrows);
+    for (Index i = 0; i < G_nrows; ++i) {
+      row_indices[i] = i;
+      col_indices[i] = h_comm[i];
+    }
+    std::vector<float> ones(G_nrows, 1.f);
+    Matrix<float> P(G_nrows, ncomm);
+    Matrix<float> PT(ncomm, G_nrows);
+    CHECK(P.build(&row_indices, &col_indices, &ones, G_nrows, GrB_NULL));
+    CHECK(PT.build(&col_indices, &row_indices, &ones, G_nrows, GrB_NULL));
+
+    Matrix<float> GP(G_nrows, ncomm);
+    Matrix<float> G_next(ncomm, ncomm);
+    CHECK(mxm<float, float, float, float>(&GP, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<float>(), &G, &P, desc));
+    CHECK(mxm<float, float, float, float>(&G_next, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<float>(), &PT, &GP, desc));
+    CHECK(G.dup(&G_next));
+    gpu_phase.Stop();
+    coarsen_time += gpu_phase.ElapsedMillis();
+
+    if (desc->descriptor_.timing_ > 0)
+      std::cout << "louvain level " << level << ", " << G_nrows << " -> "
+          << ncomm << ", move " << level_move << ", coarsen "
+          << gpu_phase.ElapsedMillis() << ", modularity " << q << "\n";
+    G_nrows = ncomm;
+    level++;
+  }
+  CHECK(v->build(&h_label, A_nrows));
+  gpu_tight.Stop();
+
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "louvain, " << level + 1 << " levels, move " << move_time
+        << ", coarsen " << coarsen_time << ", " << gpu_tight.ElapsedMillis()
+        << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+template <typename a>
+double louvainCpu(Matrix<a>*        A,
+                  std::vector<int>* h_comm_cpu) {
+  return SimpleReferenceLouvain(A->matrix_.nrows_,
+      A->matrix_.sparse_.h_csrRowPtr_, A->matrix_.sparse_.h_csrColInd_,
+      A->matrix_.sparse_.h_csrVal_, h_comm_cpu);
+}
+
+template <typename a>
+int verifyCommunity(Matrix<a>*              A,
+                    const std::vector<int>& h_comm,
+                    double                  q,
+                    double                  q_ref,
+                    double                  tol) {
+  return SimpleVerifyCommunity(A->matrix_.nrows_,
+      A->matrix_.sparse_.h_csrRowPtr_, A->matrix_.sparse_.h_csrColInd_,
+      A->matrix_.sparse_.h_csrVal_, h_comm, q, q_ref, tol);
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_COMMUNITY_HPP_
@@ -1,76 +1,205 @@
 #ifndef GRAPHBLAS_ALGORITHM_DIAMETER_HPP_
 #define GRAPHBLAS_ALGORITHM_DIAMETER_HPP_
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 #include <utility>
 
-#include "graphblas/algorithm/test_bfs.hpp"
+#include "graphblas/algorithm/bfs.hpp"
+#include "graphblas/algorithm/msbfs.hpp"
 #include "graphblas/backend/cuda/util.hpp"
 
 namespace graphblas {
 namespace algorithm {
 
-// Use float for now for both v and A
-std::pair<int, int> diameter(Vector<float>*       v,
-                             const Matrix<float>* A,
-                             Index                s_start,
-                             Index                s_end,
-                             Descriptor*          desc) {
-  Index A_nrows;
-  A->nrows(&A_nrows);
+// Largest eccentricity over sources [s_start, s_end) and the last source
+// that has it. Sources are searched in multi-source BFS batches of 512.
+template <typename a>
+std::pair<int, int> diameter(const Matrix<a>* A,
+                             Index            s_start,
+                             Index            s_end,
+                             Descriptor*      desc) {
+  std::vector<Index> sources;
+  for (Index s = s_start; s < s_end; ++s)
+    sources.push_back(s);
 
-  // Frontier vectors (use float for now)
-  Vector<float> q1(A_nrows);
-  Vector<float> q2(A_nrows);
+  std::vector<Index> ecc;
+  eccentricity(&ecc, A, sources, desc);
 
   int diameter_max = 0;
   int diameter_ind = -1;
-
-  for (int s = s_start; s < s_end; ++s) {
-    v->fill(0.f);
-
-    std::vector<Index> indices(1, s);
-    std::vector<float>  values(1, 1.f);
-    q1.build(&indices, &values, 1, GrB_NULL);
-
-    int iter = 1;
-    float succ = 0.f;
-    do {
-      assign<float, float, float, Index>(v, &q1, GrB_NULL,
-          static_cast<float>(iter), GrB_ALL, A_nrows, desc);
-      desc->toggle(GrB_MASK);
-      vxm<float, float, float, float>(&q2, v, GrB_NULL,
-          LogicalOrAndSemiring<float>(), &q1, A, desc);
-      desc->toggle(GrB_MASK);
-      q2.swap(&q1);
-      reduce<float, float>(&succ, GrB_NULL, PlusMonoid<float>(), &q1, desc);
-      iter++;
-    } while (succ > 0);
-    diameter_max = std::max(diameter_max, iter - 2);
-    diameter_ind = (iter - 2 == diameter_max) ? s : diameter_ind;
+  for (Index k = 0; k < sources.size(); ++k) {
+    diameter_max = std::max(diameter_max, static_cast<int>(ecc[k]));
+    diameter_ind = (static_cast<int>(ecc[k]) == diameter_max) ? sources[k] :
+        diameter_ind;
   }
   return std::make_pair(diameter_max, diameter_ind);
 }
 
-template <typename T, typename a>
-int bfsCpu(Index        source,
-           Matrix<a>*   A,
-           T*           h_bfs_cpu,
-           Index        depth,
-           bool         transpose = false) {
-  Index* reference_check_preds = NULL;
-  int max_depth;
-
-  if (transpose)
-    max_depth = SimpleReferenceBfs<T>(A->matrix_.nrows_,
-        A->matrix_.sparse_.h_cscColPtr_, A->matrix_.sparse_.h_cscRowInd_,
-        h_bfs_cpu, reference_check_preds, source, depth);
-  else
-    max_depth = SimpleReferenceBfs<T>(A->matrix_.nrows_,
-        A->matrix_.sparse_.h_csrRowPtr_, A->matrix_.sparse_.h_csrColInd_,
-        h_bfs_cpu, reference_check_preds, source, depth);
-
-  return max_depth;
+// BFS distances in edges from each of sources, with -1 if unreachable. Row k
+// of dist is sources[k].
+template <typename a>
+Info diameterSweep(std::vector<Index>*       dist,
+                   const Matrix<a>*          A,
+                   const std::vector<Index>& sources,
+                   Descriptor*               desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+  Matrix<Index> V(sources.size(), A_nrows);
+  CHECK(msBfs<Index, a>(&V, GrB_NULL, A, &sources, desc));
+
+  Index V_nvals = sources.size()*A_nrows;
+  CHECK(V.extractTuples(dist, &V_nvals));
+  for (Index i = 0; i < V_nvals; ++i)
+    (*dist)[i] -= 1;
+  return GrB_SUCCESS;
+}
+
+// Farthest vertex in one row of distances
+inline Index diameterFarthest(const std::vector<Index>& dist,
+                              Index                     row,
+                              Index                     A_nrows) {
+  return std::max_element(dist.begin() + row*A_nrows,
+      dist.begin() + (row+1)*A_nrows) - (dist.begin() + row*A_nrows);
+}
+
+/*!
+ * Exact diameter of an undirected graph, with a peripheral pair (u, v) at
+ * that distance.
+ *
+ * Without ecc, this is iFUB (Crescenzi et al.): a double sweep a -> b gives a
+ * lower bound, the BFS is rooted at the midpoint of that path, and the
+ * fringes of the root's BFS tree are searched from the deepest level up,
+ * stopping once no shallower fringe can beat the bound. Only the component
+ * of vertex 0 is considered.
+ *
+ * With ecc, every eccentricity is computed with Takes and Kosters' bounds:
+ * each BFS from v tightens max(d(v,w), e(v)-d(v,w)) <= e(w) <= e(v)+d(v,w)
+ * for all w, and the next sources are the unresolved vertices with the
+ * largest upper and the smallest lower bound. Unreachable vertices get no
+ * update, so this covers all components.
+ *
+ * Each fringe or pair of sources is one multi-source BFS.
+ */
+template <typename a>
+Info diameterExact(Index*              diameter,
+                   Index*              u,
+                   Index*              v,
+                   std::vector<Index>* ecc,
+                   const Matrix<a>*    A,
+                   Descriptor*         desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+  if (A_nrows == 0)
+    return GrB_INVALID_VALUE;
+
+  std::vector<Index> dist;
+  std::vector<Index> sources;
+  std::vector<Index> fringe_ecc;
+  Index nsweeps = 0;
+  Index lb = 0;
+  Index lb_ind = 0;
+
+  if (ecc == NULL) {
+    // Double sweep 0 -> a -> b, then the BFS from b to find the midpoint
+    sources.assign(1, 0);
+    CHECK(diameterSweep(&dist, A, sources, desc));
+    Index va = diameterFarthest(dist, 0, A_nrows);
+    sources.assign(1, va);
+    CHECK(diameterSweep(&dist, A, sources, desc));
+    std::vector<Index> dist_a = dist;
+    Index vb = diameterFarthest(dist_a, 0, A_nrows);
+    lb = dist_a[vb];
+    lb_ind = va;
+    sources.assign(1, vb);
+    CHECK(diameterSweep(&dist, A, sources, desc));
+    Index root = va;
+    for (Index i = 0; i < A_nrows; ++i) {
+      if (dist_a[i] == lb / 2 && dist_a[i] + dist[i] == lb) {
+        root = i;
+        break;
+      }
+    }
+    sources.assign(1, root);
+    CHECK(diameterSweep(&dist, A, sources, desc));
+    nsweeps = 4;
+
+    Index level = *std::max_element(dist.begin(), dist.end());
+    if (level > lb) {
+      lb = level;
+      lb_ind = root;
+    }
+    Index ub = 2*level;
+    for (; ub > lb && level > 0; --level) {
+      sources.clear();
+      for (Index i = 0; i < A_nrows; ++i)
+        if (dist[i] == level)
+          sources.push_back(i);
+      CHECK(eccentricity(&fringe_ecc, A, sources, desc));
+      nsweeps += sources.size();
+      for (Index k = 0; k < sources.size(); ++k) {
+        if (fringe_ecc[k] > lb) {
+          lb = fringe_ecc[k];
+          lb_ind = sources[k];
+        }
+      }
+      ub = 2*(level - 1);
+    }
+  } else {
+    const Index inf = std::numeric_limits<Index>::max();
+    std::vector<Index> lo(A_nrows, 0);
+    std::vector<Index> hi(A_nrows, inf);
+    std::vector<bool>  done(A_nrows, false);
+    Index nleft = A_nrows;
+    while (nleft > 0) {
+      // Unresolved vertices with the largest upper and smallest lower bound
+      Index hi_ind = -1, lo_ind = -1;
+      for (Index i = 0; i < A_nrows; ++i) {
+        if (done[i])
+          continue;
+        if (hi_ind == -1 || hi[i] > hi[hi_ind])
+          hi_ind = i;
+        if (lo_ind == -1 || lo[i] < lo[lo_ind])
+          lo_ind = i;
+      }
+      sources.assign(1, hi_ind);
+      if (lo_ind != hi_ind)
+        sources.push_back(lo_ind);
+      CHECK(diameterSweep(&dist, A, sources, desc));
+      nsweeps += sources.size();
+
+      for (Index k = 0; k < sources.size(); ++k) {
+        const Index* dist_k = dist.data() + k*A_nrows;
+        Index e = *std::max_element(dist_k, dist_k + A_nrows);
+        for (Index i = 0; i < A_nrows; ++i) {
+          if (done[i] || dist_k[i] < 0)
+            continue;
+          lo[i] = std::max(lo[i], std::max(dist_k[i], e - dist_k[i]));
+          hi[i] = std::min(hi[i], e + dist_k[i]);
+          if (lo[i] == hi[i]) {
+            done[i] = true;
+            nleft--;
+          }
+        }
+      }
+    }
+
+    *ecc = lo;
+    lb_ind = std::max_element(lo.begin(), lo.end()) - lo.begin();
+    lb = lo[lb_ind];
+  }
+
+  // The other end of the peripheral pair
+  sources.assign(1, lb_ind);
+  CHECK(diameterSweep(&dist, A, sources, desc));
+  *diameter = lb;
+  *u = lb_ind;
+  *v = diameterFarthest(dist, 0, A_nrows);
+
+  if (desc->descriptor_.debug())
+    std::cout << "diameter: " << lb << " in " << nsweeps + 1 << " BFS\n";
+  return GrB_SUCCESS;
 }
 }  // namespace algorithm
 }  // namespace graphblas
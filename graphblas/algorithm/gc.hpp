@@ -405,6 +405,54 @@ float gcJP(Vector<int>*       v,
   return 0.f;
 }
 
+// Speculative greedy coloring with conflict resolution on the CPU backend,
+// in natural (0), largest-first (1) or smallest-last (2) order. Falls back to
+// gcJP on the GPU. Code is based on the algorithm described in the following
+// paper.
+// Catalyurek, Feo, Gebremedhin, Halappanavar, Pothen. Graph Coloring
+// Algorithms for Multi-core and Massively Multithreaded Architectures
+// (Parallel Computing 2012).
+float gcGreedy(Vector<int>*       v,
+               const Matrix<int>* A,
+               int                seed,
+               int                max_colors,
+               int                order,
+               Descriptor*        desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return gcJP(v, A, seed, max_colors, desc);
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(greedyColor<int, int>(v, A, order, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "greedy, " << order << ", " << gpu_tight.ElapsedMillis()
+        << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+// Speculative distance-2 coloring on the CPU backend, or partial distance-2
+// coloring of the columns if partial. Code is based on the algorithm
+// described in the following paper.
+// Bozdag, Catalyurek, Gebremedhin, Manne, Boman, Ozguner. Distributed-Memory
+// Parallel Algorithms for Distance-2 Coloring and Related Problems in
+// Derivative Computation (SISC 2010).
+float gcDistance2(Vector<int>*       v,
+                  const Matrix<int>* A,
+                  bool               partial,
+                  Descriptor*        desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(distance2Color<int, int>(v, A, partial, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "distance-2, " << partial << ", " << gpu_tight.ElapsedMillis()
+        << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename a>
 int gcCpu(Index             seed,
           Matrix<a>*        A,
@@ -421,6 +469,14 @@ int verifyGc(const Matrix<a>*        A,
   SimpleVerifyGc(A->matrix_.nrows_, A->matrix_.sparse_.h_csrRowPtr_,
       A->matrix_.sparse_.h_csrColInd_, h_gc_cpu, suppress_zero);
 }
+
+template <typename a>
+int verifyD2Gc(const Matrix<a>*        A,
+               const std::vector<int>& h_gc_cpu,
+               bool                    partial = false) {
+  return SimpleVerifyD2Gc(A->matrix_.nrows_, A->matrix_.sparse_.h_csrRowPtr_,
+      A->matrix_.sparse_.h_csrColInd_, h_gc_cpu, partial);
+}
 }  // namespace algorithm
 }  // namespace graphblas
 
@@ -0,0 +1,132 @@
+#ifndef GRAPHBLAS_ALGORITHM_KCORE_HPP_
+#define GRAPHBLAS_ALGORITHM_KCORE_HPP_
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "graphblas/algorithm/test_kcore.hpp"
+#include "graphblas/backend/cuda/util.hpp"
+
+namespace graphblas {
+namespace algorithm {
+
+/*!
+ * \brief k-core decomposition in GraphBLAS operations. Each iteration peels
+ *        every vertex whose remaining degree is at most k, and k grows when
+ *        there are none. The remaining degree is d - r, where r counts the
+ *        peeled neighbours and is accumulated by a vxm masked to the
+ *        vertices still alive.
+ * \param v output vector which stores the core number of each vertex
+ * \param A adjacency matrix of graph, symmetric with values 1
+ * \param desc pointer to descriptor
+ */
+float kcoreGrb(Vector<int>*       v,
+               const Matrix<int>* A,
+               Descriptor*        desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+
+  // Degree (d), set to the largest int once a vertex is peeled
+  Vector<int> d(A_nrows);
+  reduce<int, int, int>(&d, GrB_NULL, GrB_NULL, PlusMonoid<int>(), A, desc);
+
+  // Peeled neighbours (r), vertices not yet peeled (alive), frontier (f),
+  // threshold (t) and k + 1 (k1)
+  Vector<int> r(A_nrows);
+  CHECK(r.fill(0));
+  Vector<int> alive(A_nrows);
+  CHECK(alive.fill(1));
+  Vector<int> f(A_nrows);
+  Vector<int> t(A_nrows);
+  Vector<int> k1(A_nrows);
+  CHECK(v->fill(0));
+
+  int   k         = 0;
+  int   succ      = 0;
+  int   iter      = 1;
+  Index remaining = A_nrows;
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(k1.fill(k + 1));
+  while (remaining > 0 && iter <= desc->descriptor_.max_niter_) {
+    // f = (r + k + 1 > d), i.e. the remaining degree is at most k
+    eWiseAdd<int, int, int, int>(&t, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<int>(), &r, &k1, desc);
+    eWiseAdd<int, int, int, int>(&f, GrB_NULL, GrB_NULL,
+        GreaterPlusSemiring<int>(), &t, &d, desc);
+    reduce<int, int>(&succ, GrB_NULL, PlusMonoid<int>(), &f, desc);
+
+    if (desc->descriptor_.debug())
+      std::cout << "=====k-core Iteration " << iter << ": k " << k << ", "
+          << succ << " peeled=====\n";
+    if (succ == 0) {
+      k++;
+      CHECK(k1.fill(k + 1));
+      continue;
+    }
+    remaining -= succ;
+
+    // Core number of the frontier is k, and it never peels again
+    assign<int, int, int, Index>(v, &f, GrB_NULL, k, GrB_ALL, A_nrows, desc);
+    assign<int, int, int, Index>(&d, &f, GrB_NULL,
+        std::numeric_limits<int>::max(), GrB_ALL, A_nrows, desc);
+    assign<int, int, int, Index>(&alive, &f, GrB_NULL, 0, GrB_ALL, A_nrows,
+        desc);
+
+    // r += f^T A on the vertices still alive
+    vxm<int, int, int, int>(&r, &alive, plus<int>(),
+        PlusMultipliesSemiring<int>(), &f, A, desc);
+    iter++;
+  }
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "kcore, " << iter << ", " << k << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+// k-core by parallel bucket peeling on the CPU backend, with degrees from
+// reduce. Falls back to kcoreGrb on the GPU.
+float kcore(Vector<int>*       v,
+            const Matrix<int>* A,
+            Descriptor*        desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return kcoreGrb(v, A, desc);
+
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  Vector<int> degree(A_nrows);
+  reduce<int, int, int>(&degree, GrB_NULL, GrB_NULL, PlusMonoid<int>(), A,
+      desc);
+  CHECK(kcorePeel<int, int, int>(v, A, &degree, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "peel, " << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+template <typename a>
+int kcoreCpu(Matrix<a>*        A,
+             std::vector<int>* h_kcore_cpu) {
+  return SimpleReferenceKcore(A->matrix_.nrows_,
+      A->matrix_.sparse_.h_csrRowPtr_, A->matrix_.sparse_.h_csrColInd_,
+      h_kcore_cpu);
+}
+
+template <typename a>
+int verifyKcore(Matrix<a>*              A,
+                const std::vector<int>& h_kcore) {
+  std::vector<int> h_kcore_cpu;
+  kcoreCpu(A, &h_kcore_cpu);
+  return SimpleVerifyKcore(h_kcore_cpu, h_kcore);
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_KCORE_HPP_
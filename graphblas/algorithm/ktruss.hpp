@@ -0,0 +1,65 @@
+#ifndef GRAPHBLAS_ALGORITHM_KTRUSS_HPP_
+#define GRAPHBLAS_ALGORITHM_KTRUSS_HPP_
+
+#include <string>
+#include <vector>
+
+#include "graphblas/algorithm/test_ktruss.hpp"
+#include "graphblas/backend/cuda/util.hpp"
+
+namespace graphblas {
+namespace algorithm {
+
+/*!
+ * \brief k-truss by support peeling, which only runs on the CPU backend.
+ *        Support comes from masked SpGEMM by row intersection, and after
+ *        each removal only the triangles of removed edges are counted again.
+ * \param C output matrix with the edges of the k-truss valued by support,
+ *          or with k == 0, every edge valued by its truss number
+ * \param A adjacency matrix of graph, symmetric with sorted rows
+ * \param k keep edges in at least k - 2 triangles, or 0 for decomposition
+ * \param desc pointer to descriptor
+ */
+float ktruss(Matrix<int>*       C,
+             const Matrix<int>* A,
+             int                k,
+             Descriptor*        desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(graphblas::ktruss<int, int>(C, A, k, desc));
+  gpu_tight.Stop();
+
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "ktruss, " << k << ", " << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+template <typename a>
+int ktrussCpu(Matrix<a>*          A,
+              int                 k,
+              std::vector<Index>* h_row_cpu,
+              std::vector<Index>* h_col_cpu,
+              std::vector<int>*   h_val_cpu) {
+  return SimpleReferenceKtruss(A->matrix_.nrows_,
+      A->matrix_.sparse_.h_csrRowPtr_, A->matrix_.sparse_.h_csrColInd_, k,
+      h_row_cpu, h_col_cpu, h_val_cpu);
+}
+
+template <typename a>
+int verifyKtruss(Matrix<a>*   A,
+                 int          k,
+                 Matrix<int>* C) {
+  std::vector<Index> h_row_cpu, h_col_cpu, h_row, h_col;
+  std::vector<int>   h_val_cpu, h_val;
+  ktrussCpu(A, k, &h_row_cpu, &h_col_cpu, &h_val_cpu);
+
+  Index C_nvals;
+  CHECK(C->nvals(&C_nvals));
+  CHECK(C->extractTuples(&h_row, &h_col, &h_val, &C_nvals));
+  return SimpleVerifyKtruss(h_row_cpu, h_col_cpu, h_val_cpu, h_row, h_col,
+      h_val);
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_KTRUSS_HPP_
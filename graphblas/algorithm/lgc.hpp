@@ -10,77 +10,78 @@
 namespace graphblas {
 namespace algorithm {
 
-// Use float for now for both p and A
-float lgc(Vector<float>*       p,      // PageRank result
-          const Matrix<float>* A,      // graph
-          Index                s,      // source vertex
-          double               alpha,  // teleportation constant in (0,1]
-          double               eps,    // tolerance
-          Descriptor*          desc) {
+// PageRank, residual and frontier are kept in T; A is read as a
+template <typename T, typename a>
+float lgc(Vector<T>*       p,      // PageRank result
+          const Matrix<a>* A,      // graph
+          Index            s,      // source vertex
+          double           alpha,  // teleportation constant in (0,1]
+          double           eps,    // tolerance
+          Descriptor*      desc) {
   Index A_nrows;
   CHECK(A->nrows(&A_nrows));
 
   // degrees: compute the degree of each node
-  Vector<float> degrees(A_nrows);
-  reduce<float, float, float>(&degrees, GrB_NULL, GrB_NULL,
-      PlusMonoid<float>(), A, desc);
+  Vector<T> degrees(A_nrows);
+  reduce<T, T, a>(&degrees, GrB_NULL, GrB_NULL, PlusMonoid<T>(), A, desc);
 
   // pagerank (p): initialized to 0
-  CHECK(p->fill(0.f));
+  CHECK(p->fill(static_cast<T>(0)));
 
   // residual (r): initialized to 0 except source to 1
-  Vector<float> r(A_nrows);
+  Vector<T> r(A_nrows);
   std::vector<Index> indices(1, s);
-  std::vector<float> values(1, 1.f);
+  std::vector<T>     values(1, static_cast<T>(1));
 
   // residual2 (r2)
-  Vector<float> r2(A_nrows);
-  CHECK(r2.fill(0.f));
+  Vector<T> r2(A_nrows);
+  CHECK(r2.fill(static_cast<T>(0)));
 
   Desc_value desc_value;
   CHECK(desc->get(GrB_MXVMODE, &desc_value));
   if (desc_value == GrB_PULLONLY) {
-    CHECK(r.fill(0.f));
-    CHECK(r.setElement(1.f, s));
+    CHECK(r.fill(static_cast<T>(0)));
+    CHECK(r.setElement(static_cast<T>(1), s));
   } else {
     CHECK(r.build(&indices, &values, 1, GrB_NULL));
   }
 
   // degrees_eps (d x eps): precompute degree of each node times eps
-  Vector<float> eps_vector(A_nrows);
-  Vector<float> degrees_eps(A_nrows);
+  Vector<T> eps_vector(A_nrows);
+  Vector<T> degrees_eps(A_nrows);
   CHECK(eps_vector.fill(eps));
-  eWiseMult<float, float, float, float>(&degrees_eps, GrB_NULL, GrB_NULL,
-      PlusMultipliesSemiring<float>(), &degrees, &eps_vector, desc);
+  eWiseMult<T, T, T, T>(&degrees_eps, GrB_NULL, GrB_NULL,
+      PlusMultipliesSemiring<T>(), &degrees, &eps_vector, desc);
 
   // frontier (f): portion of r(v) >= degrees(v) x eps
-  // (use float for now)
-  Vector<float> f(A_nrows);
+  Vector<T> f(A_nrows);
   CHECK(f.build(&indices, &values, 1, GrB_NULL));
 
   // alpha: TODO(@ctcyang): introduce vector-constant eWiseMult
-  Vector<float> alpha_vector(A_nrows);
+  Vector<T> alpha_vector(A_nrows);
   CHECK(alpha_vector.fill(alpha));
-  Vector<float> alpha_vector2(A_nrows);
+  Vector<T> alpha_vector2(A_nrows);
   CHECK(alpha_vector2.fill((1.-alpha)/2.));
 
   Index nvals;
   CHECK(f.nvals(&nvals));
 
-  std::cout << "frontier (f): " << std::endl;
-  CHECK(f.print());
-  std::cout << "residual (r): " << std::endl;
-  CHECK(r.print());
-  std::cout << "pagerank (p): " << std::endl;
-  CHECK(p->print());
-  std::cout << "degrees (d): " << std::endl;
-  CHECK(degrees.print());
-  std::cout << "degrees_eps (d x eps): " << std::endl;
-  CHECK(degrees_eps.print());
+  if (desc->descriptor_.debug()) {
+    std::cout << "frontier (f): " << std::endl;
+    CHECK(f.print());
+    std::cout << "residual (r): " << std::endl;
+    CHECK(r.print());
+    std::cout << "pagerank (p): " << std::endl;
+    CHECK(p->print());
+    std::cout << "degrees (d): " << std::endl;
+    CHECK(degrees.print());
+    std::cout << "degrees_eps (d x eps): " << std::endl;
+    CHECK(degrees_eps.print());
+  }
 
   Index iter = 1;
   Index unvisited = A_nrows;
-  float succ;
+  T succ;
   backend::GpuTimer gpu_tight;
   float gpu_tight_time = 0.f;
   if (desc->descriptor_.timing_ > 0)
@@ -104,36 +105,36 @@ float lgc(Vector<float>*       p,      // PageRank result
 
     // p = p + alpha * r .* f
     CHECK(desc->toggle(GrB_MASK));
-    eWiseMult<float, float, float, float>(&r2, &f, GrB_NULL,
-        PlusMultipliesSemiring<float>(), &r, &alpha_vector, desc);
+    eWiseMult<T, T, T, T>(&r2, &f, GrB_NULL,
+        PlusMultipliesSemiring<T>(), &r, &alpha_vector, desc);
     CHECK(desc->toggle(GrB_MASK));
-    eWiseAdd<float, float, float, float>(p, GrB_NULL, GrB_NULL,
-        PlusMultipliesSemiring<float>(), p, &r2, desc);
+    eWiseAdd<T, T, T, T>(p, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<T>(), p, &r2, desc);
 
     // r = (1 - alpha)/2 * r
-    eWiseMult<float, float, float, float>(&r, &f, GrB_NULL,
-        PlusMultipliesSemiring<float>(), &r, &alpha_vector2, desc);
+    eWiseMult<T, T, T, T>(&r, &f, GrB_NULL,
+        PlusMultipliesSemiring<T>(), &r, &alpha_vector2, desc);
 
     // r2 = r/d .* f
     CHECK(desc->toggle(GrB_MASK));
-    // eWiseMult<float, float, float, float>(&r2, &f, GrB_NULL, divides<float>(),
+    // eWiseMult<T, T, T, T>(&r2, &f, GrB_NULL, divides<T>(),
     //     &r, &degrees, desc);
-    eWiseMult<float, float, float, float>(&r2, &f, GrB_NULL,
-        PlusDividesSemiring<float>(), &r, &degrees, desc);
+    eWiseMult<T, T, T, T>(&r2, &f, GrB_NULL,
+        PlusDividesSemiring<T>(), &r, &degrees, desc);
     CHECK(desc->toggle(GrB_MASK));
 
     // r = r + A^T * r2
-    mxv<float, float, float, float>(&r, GrB_NULL, PlusMonoid<float>(),
-        PlusMultipliesSemiring<float>(), A, &r2, desc);
+    mxv<T, T, a, T>(&r, GrB_NULL, PlusMonoid<T>(),
+        PlusMultipliesSemiring<a, T, T>(), A, &r2, desc);
 
     // f = {v | r(v) >= d*eps}
-    // eWiseAdd<float, float, float, float>(&f, GrB_NULL, GrB_NULL,
-    //     GreaterPlusSemiring<float>(), &r, &degrees_eps, desc);
-    eWiseMult<float, float, float, float>(&f, GrB_NULL, GrB_NULL,
-        PlusGreaterSemiring<float>(), &r, &degrees_eps, desc);
+    // eWiseAdd<T, T, T, T>(&f, GrB_NULL, GrB_NULL,
+    //     GreaterPlusSemiring<T>(), &r, &degrees_eps, desc);
+    eWiseMult<T, T, T, T>(&f, GrB_NULL, GrB_NULL,
+        PlusGreaterSemiring<T>(), &r, &degrees_eps, desc);
 
     // Update frontier size
-    reduce<float, float>(&succ, GrB_NULL, PlusMonoid<float>(), &f, desc);
+    reduce<T, T>(&succ, GrB_NULL, PlusMonoid<T>(), &f, desc);
 
     iter++;
 
@@ -162,6 +163,51 @@ float lgc(Vector<float>*       p,      // PageRank result
   return 0.f;
 }
 
+// lgc by ACL push on the CPU backend. p stays sparse and no length-n vector
+// is filled, so the cost follows the cluster found. Falls back to lgc on the
+// GPU.
+template <typename T, typename a>
+float lgcAcl(Vector<T>*       p,
+             const Matrix<a>* A,
+             Index            s,
+             double           alpha,
+             double           eps,
+             Descriptor*      desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return lgc(p, A, s, alpha, eps, desc);
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(lgcPush<T, a>(p, A, s, alpha, eps, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "acl, " << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+// Batched lgc: column j of P gets the PageRank personalized to seeds[j].
+// push = false runs all seeds as one dense residual matrix through SpMM,
+// push = true pushes a sparse residual per seed (CPU backend only).
+template <typename T, typename a>
+float batchPpr(Matrix<T>*                P,
+               const Matrix<a>*          A,
+               const std::vector<Index>& seeds,
+               double                    alpha,
+               double                    eps,
+               bool                      push,
+               Descriptor*               desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(pprBatch<T, a>(P, A, &seeds, alpha, eps, push, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "batch, " << seeds.size() << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename T, typename a>
 void lgcCpu(T*               h_lgc_cpu,
             const Matrix<a>* A,
@@ -140,6 +140,27 @@ float mis(Vector<int>*       v,
   return 0.f;
 }
 
+// Luby MIS on the CPU backend with a candidate bitmap and list that shrink
+// every round, and priorities hashed per round instead of stored. Falls back
+// to mis on the GPU.
+float misBitmap(Vector<int>*       v,
+                const Matrix<int>* A,
+                int                seed,
+                Descriptor*        desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return mis(v, A, seed, desc);
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(lubyMis<int, int>(v, A, seed, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "luby, " << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename a>
 int misCpu(Index             seed,
            Matrix<a>*        A,
@@ -0,0 +1,53 @@
+#ifndef GRAPHBLAS_ALGORITHM_MSBFS_HPP_
+#define GRAPHBLAS_ALGORITHM_MSBFS_HPP_
+
+#include <algorithm>
+#include <vector>
+
+#include "graphblas/backend/cuda/util.hpp"
+
+namespace graphblas {
+namespace algorithm {
+
+// Batched BFS: row k of V gets the depths from sources[k], as bfs would give
+// for that source. All sources share each adjacency scan, so a batch costs
+// about as much as the deepest single BFS in it. At most 512 sources.
+template <typename T, typename a>
+float batchBfs(Matrix<T>*                V,
+               const Matrix<a>*          A,
+               const std::vector<Index>& sources,
+               Descriptor*               desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(msBfs<T, a>(V, GrB_NULL, A, &sources, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "batch, " << sources.size() << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+// Eccentricity of each source, running multi-source BFS 512 sources at a
+// time
+template <typename a>
+Info eccentricity(std::vector<Index>*       ecc,
+                  const Matrix<a>*          A,
+                  const std::vector<Index>& sources,
+                  Descriptor*               desc) {
+  const Index nsources = sources.size();
+  ecc->resize(nsources);
+
+  std::vector<Index> batch;
+  std::vector<Index> batch_ecc;
+  for (Index k = 0; k < nsources; k += backend::kMsBfsMaxSources) {
+    Index k_end = std::min(nsources, k + backend::kMsBfsMaxSources);
+    batch.assign(sources.begin() + k, sources.begin() + k_end);
+    CHECK(msBfs<Index, a>(GrB_NULL, &batch_ecc, A, &batch, desc));
+    std::copy(batch_ecc.begin(), batch_ecc.end(), ecc->begin() + k);
+  }
+  return GrB_SUCCESS;
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_MSBFS_HPP_
@@ -1,6 +1,8 @@
 #ifndef GRAPHBLAS_ALGORITHM_PR_HPP_
 #define GRAPHBLAS_ALGORITHM_PR_HPP_
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 #include <string>
@@ -11,36 +13,39 @@
 namespace graphblas {
 namespace algorithm {
 
-// Use float for now for both v and A
-float pr(Vector<float>*       p,
-         const Matrix<float>* A,     // column stochastic matrix
-         float                alpha, // teleportation constant
-         float                eps,   // threshold
-         Descriptor*          desc) {
+// Ranks, residuals and the error are kept in T, so PageRank can run in
+// double when float does not converge below eps
+template <typename T, typename a>
+float pr(Vector<T>*       p,
+         const Matrix<a>* A,      // column stochastic matrix
+         double           alpha,  // teleportation constant
+         double           eps,    // threshold
+         Descriptor*      desc) {
   // Get number of vertices
   Index A_nrows;
   CHECK(A->nrows(&A_nrows));
 
   // Pagerank vector (p)
   CHECK(p->clear());
-  CHECK(p->fill(1.f/A_nrows));
+  CHECK(p->fill(static_cast<T>(1)/A_nrows));
 
   // Previous pagerank vector (p_prev)
-  Vector<float> p_prev(A_nrows);
+  Vector<T> p_prev(A_nrows);
 
   // Temporary pagerank (p_temp)
-  Vector<float> p_swap(A_nrows);
+  Vector<T> p_swap(A_nrows);
 
   // Residual vector (r)
-  Vector<float> r(A_nrows);
-  r.fill(1.f);
+  Vector<T> r(A_nrows);
+  r.fill(static_cast<T>(1));
 
   // Temporary residual (r_temp)
-  Vector<float> r_temp(A_nrows);
+  Vector<T> r_temp(A_nrows);
 
   int iter;
-  float error_last = 0.f;
-  float error = 1.f;
+  T p_sum, p_swap_sum;
+  T error_last = static_cast<T>(0);
+  T error = static_cast<T>(1);
   Index unvisited = A_nrows;
 
   backend::GpuTimer gpu_tight;
@@ -65,19 +70,25 @@ float pr(Vector<float>*       p,
     error_last = error;
     p_prev = *p;
 
-    // p = A*p + (1-alpha)*1
-    vxm<float, float, float, float>(&p_swap, GrB_NULL, GrB_NULL,
-        PlusMultipliesSemiring<float>(), &p_prev, A, desc);
-    eWiseAdd<float, float, float, float>(p, GrB_NULL, GrB_NULL,
-        PlusMultipliesSemiring<float>(), &p_swap, (1.f-alpha)/A_nrows, desc);
+    // p = A*p + (1-alpha)*1 + dangling*1, where rank on vertices without
+    // out-edges is spread evenly: every other row of A sums to alpha, so the
+    // rank that vxm loses is exactly alpha times the dangling rank
+    vxm<T, T, T, a>(&p_swap, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<T, a, T>(), &p_prev, A, desc);
+    reduce<T, T>(&p_sum, GrB_NULL, PlusMonoid<T>(), &p_prev, desc);
+    reduce<T, T>(&p_swap_sum, GrB_NULL, PlusMonoid<T>(), &p_swap, desc);
+    T dangling = std::max(static_cast<T>(alpha)*p_sum - p_swap_sum,
+        static_cast<T>(0));
+    eWiseAdd<T, T, T, T>(p, GrB_NULL, GrB_NULL, PlusMultipliesSemiring<T>(),
+        &p_swap, static_cast<T>((1.-alpha)/A_nrows) + dangling/A_nrows, desc);
 
     // error = l2loss(p, p_prev)
-    eWiseMult<float, float, float, float>(&r, GrB_NULL, GrB_NULL,
-        PlusMinusSemiring<float>(), p, &p_prev, desc);
-    eWiseAdd<float, float, float, float>(&r_temp, GrB_NULL, GrB_NULL,
-        MultipliesMultipliesSemiring<float>(), &r, &r, desc);
-    reduce<float, float>(&error, GrB_NULL, PlusMonoid<float>(), &r_temp, desc);
-    error = sqrt(error);
+    eWiseMult<T, T, T, T>(&r, GrB_NULL, GrB_NULL, PlusMinusSemiring<T>(), p,
+        &p_prev, desc);
+    eWiseAdd<T, T, T, T>(&r_temp, GrB_NULL, GrB_NULL,
+        MultipliesMultipliesSemiring<T>(), &r, &r, desc);
+    reduce<T, T>(&error, GrB_NULL, PlusMonoid<T>(), &r_temp, desc);
+    error = std::sqrt(error);
 
     if (desc->descriptor_.debug())
       std::cout << "error: " << error_last << std::endl;
@@ -93,6 +104,112 @@ float pr(Vector<float>*       p,
   return gpu_tight_time;
 }
 
+/*!
+ * Residual-push (delta) PageRank on the same alpha*A/outdegree matrix as pr.
+ * Every vertex starts with residual (1-alpha)/n and only vertices whose
+ * residual is above eps are pushed: their residual moves into p and is
+ * multiplied through A into their out-neighbours' residuals. The frontier
+ * is dense with zeros for settled vertices, so vxm switches to push once it
+ * is sparse enough, as in bfs.
+ *
+ * Rank pushed from dangling vertices is pooled and spread over all residuals
+ * once it is worth more than eps per vertex.
+ *
+ * in_place uses the CPU pageRankPush op, which applies each push to the
+ * residuals right away (Gauss-Seidel) instead of once per iteration. It
+ * needs the GrB_SEQUENTIAL backend and is ignored otherwise.
+ */
+template <typename T, typename a>
+float prDelta(Vector<T>*       p,
+              const Matrix<a>* A,
+              double           alpha,
+              double           eps,
+              bool             in_place,
+              Descriptor*      desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (in_place && backend == GrB_SEQUENTIAL) {
+    CHECK(pageRankPush<T, a>(p, A, alpha, eps, desc));
+    gpu_tight.Stop();
+    return gpu_tight.ElapsedMillis();
+  }
+
+  CHECK(p->fill(static_cast<T>(0)));
+
+  // Residual (r), threshold (r_eps) and residual above it (m)
+  Vector<T> r(A_nrows);
+  Vector<T> r_temp(A_nrows);
+  Vector<T> r_eps(A_nrows);
+  Vector<T> m(A_nrows);
+  CHECK(r.fill(static_cast<T>((1.-alpha)/A_nrows)));
+  CHECK(r_eps.fill(static_cast<T>(eps)));
+
+  // Frontier (f) and what it pushes (t)
+  Vector<T> f(A_nrows);
+  Vector<T> t(A_nrows);
+
+  Index iter;
+  Index nactive = A_nrows;
+  T     f_sum, t_sum;
+  T     dangling = static_cast<T>(0);
+
+  for (iter = 1; iter <= desc->descriptor_.max_niter_; ++iter) {
+    // m = r > eps
+    eWiseAdd<T, T, T, T>(&m, GrB_NULL, GrB_NULL, GreaterPlusSemiring<T>(), &r,
+        &r_eps, desc);
+    reduce<Index, T>(&nactive, GrB_NULL, PlusMonoid<Index>(), &m, desc);
+    if (desc->descriptor_.debug())
+      std::cout << "=====PR Delta Iteration " << iter - 1 << ": " << nactive
+          << " active=====\n";
+    if (nactive == 0)
+      break;
+
+    // f = r .* m, r(m) = 0, p = p + f. The dense eWiseMult writes 0 wherever
+    // either side is 0, so r - f is not an eWiseMult: clear r under m instead
+    eWiseMult<T, T, T, T>(&f, GrB_NULL, GrB_NULL, PlusMultipliesSemiring<T>(),
+        &r, &m, desc);
+    CHECK(assign<T, T, T, Index>(&r, &m, GrB_NULL, static_cast<T>(0), GrB_ALL,
+        A_nrows, desc));
+    eWiseAdd<T, T, T, T>(p, GrB_NULL, GrB_NULL, PlusMultipliesSemiring<T>(), p,
+        &f, desc);
+
+    // r = r + f*A
+    vxm<T, T, T, a>(&t, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<T, a, T>(), &f, A, desc);
+    eWiseAdd<T, T, T, T>(&r, GrB_NULL, GrB_NULL, PlusMultipliesSemiring<T>(),
+        &r, &t, desc);
+
+    // Rows of A sum to alpha except at dangling vertices
+    reduce<T, T>(&f_sum, GrB_NULL, PlusMonoid<T>(), &f, desc);
+    reduce<T, T>(&t_sum, GrB_NULL, PlusMonoid<T>(), &t, desc);
+    dangling += std::max(static_cast<T>(alpha)*f_sum - t_sum,
+        static_cast<T>(0));
+    if (dangling/A_nrows > eps) {
+      eWiseAdd<T, T, T, T>(&r_temp, GrB_NULL, GrB_NULL,
+          PlusMultipliesSemiring<T>(), &r, dangling/A_nrows, desc);
+      CHECK(r.swap(&r_temp));
+      dangling = static_cast<T>(0);
+    }
+  }
+
+  if (dangling > static_cast<T>(0)) {
+    eWiseAdd<T, T, T, T>(&r_temp, GrB_NULL, GrB_NULL,
+        PlusMultipliesSemiring<T>(), p, dangling/A_nrows, desc);
+    CHECK(p->swap(&r_temp));
+  }
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "pr delta, " << iter << ", " << gpu_tight.ElapsedMillis()
+        << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename T, typename a>
 int prCpu(T*         h_pr_cpu,
           Matrix<a>* A,
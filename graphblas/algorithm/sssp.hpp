@@ -11,41 +11,42 @@
 namespace graphblas {
 namespace algorithm {
 
-// Use float for now for both v and A
-float sssp(Vector<float>*       v,
-           const Matrix<float>* A,
-           Index                s,
-           Descriptor*          desc) {
+// Distances are stored as T and edge weights are read as a, so integer
+// weights can be relaxed in int without a round trip through float
+template <typename T, typename a>
+float sssp(Vector<T>*       v,
+           const Matrix<a>* A,
+           Index            s,
+           Descriptor*      desc) {
   Index A_nrows;
   CHECK(A->nrows(&A_nrows));
 
-  // Visited vector (use float for now)
-  CHECK(v->fill(std::numeric_limits<float>::max()));
-  CHECK(v->setElement(0.f, s));
+  // Visited vector
+  CHECK(v->fill(backend::ssspInfinity<T>()));
+  CHECK(v->setElement(static_cast<T>(0), s));
 
-  // Frontier vectors (use float for now)
-  Vector<float> f1(A_nrows);
-  Vector<float> f2(A_nrows);
+  // Frontier vectors
+  Vector<T> f1(A_nrows);
+  Vector<T> f2(A_nrows);
 
   Desc_value desc_value;
   CHECK(desc->get(GrB_MXVMODE, &desc_value));
 
-  // Visited vector (use float for now)
   if (desc_value == GrB_PULLONLY) {
-    CHECK(f1.fill(std::numeric_limits<float>::max()));
-    CHECK(f1.setElement(0.f, s));
+    CHECK(f1.fill(backend::ssspInfinity<T>()));
+    CHECK(f1.setElement(static_cast<T>(0), s));
   } else {
     std::vector<Index> indices(1, s);
-    std::vector<float>  values(1, 0.f);
+    std::vector<T>     values(1, static_cast<T>(0));
     CHECK(f1.build(&indices, &values, 1, GrB_NULL));
   }
 
   // Mask vector
-  Vector<float> m(A_nrows);
+  Vector<T> m(A_nrows);
 
   Index iter;
   Index f1_nvals = 1;
-  float succ = 1.f;
+  T succ = static_cast<T>(1);
   backend::GpuTimer gpu_tight;
   float gpu_tight_time = 0.f;
   gpu_tight.Start();
@@ -64,28 +65,28 @@ float sssp(Vector<float>*       v,
     }
     gpu_tight.Start();
 
-    vxm<float, float, float, float>(&f2, GrB_NULL, GrB_NULL,
-        MinimumPlusSemiring<float>(), &f1, A, desc);
+    vxm<T, T, T, a>(&f2, GrB_NULL, GrB_NULL, MinimumPlusSemiring<T, a, T>(),
+        &f1, A, desc);
 
-    //eWiseMult<float, float, float, float>(&m, GrB_NULL, GrB_NULL,
-    //    PlusLessSemiring<float>(), &f2, v, desc);
-    eWiseAdd<float, float, float, float>(&m, GrB_NULL, GrB_NULL,
-        CustomLessPlusSemiring<float>(), &f2, v, desc);
+    //eWiseMult<T, T, T, T>(&m, GrB_NULL, GrB_NULL,
+    //    PlusLessSemiring<T>(), &f2, v, desc);
+    eWiseAdd<T, T, T, T>(&m, GrB_NULL, GrB_NULL, CustomLessPlusSemiring<T>(),
+        &f2, v, desc);
 
-    eWiseAdd<float, float, float, float>(v, GrB_NULL, GrB_NULL,
-        MinimumPlusSemiring<float>(), v, &f2, desc);
+    eWiseAdd<T, T, T, T>(v, GrB_NULL, GrB_NULL, MinimumPlusSemiring<T>(), v,
+        &f2, desc);
 
     // Similar to BFS, except we need to filter out the unproductive vertices
     // here rather than as part of masked vxm
     CHECK(desc->toggle(GrB_MASK));
-    assign<float, float, float, Index>(&f2, &m, GrB_NULL,
-        std::numeric_limits<float>::max(), GrB_ALL, A_nrows, desc);
+    assign<T, T, T, Index>(&f2, &m, GrB_NULL, backend::ssspInfinity<T>(),
+        GrB_ALL, A_nrows, desc);
     CHECK(desc->toggle(GrB_MASK));
 
     CHECK(f2.swap(&f1));
 
     CHECK(f1.nvals(&f1_nvals));
-    reduce<float, float>(&succ, GrB_NULL, PlusMonoid<float>(), &m, desc);
+    reduce<T, T>(&succ, GrB_NULL, PlusMonoid<T>(), &m, desc);
 
     if (desc->descriptor_.debug())
       std::cout << succ << std::endl;
@@ -102,6 +103,80 @@ float sssp(Vector<float>*       v,
   return gpu_tight_time;
 }
 
+// Delta-stepping: vertices are settled a bucket of width delta at a time,
+// so long weighted paths take a few relaxations per bucket instead of one
+// Bellman-Ford iteration per hop. delta <= 0 picks it from the weights. Runs
+// on the CPU backend; other backends fall back to sssp.
+template <typename T, typename a>
+float ssspDelta(Vector<T>*       v,
+                const Matrix<a>* A,
+                Index            s,
+                T                delta,
+                Descriptor*      desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL)
+    return sssp(v, A, s, desc);
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(deltaStepping<T, a>(v, A, s, delta, desc));
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "delta, " << delta << ", " << gpu_tight.ElapsedMillis()
+        << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
+// Batched SSSP: column k of D (A_nrows x sources.size()) gets the distances
+// from sources[k]. Each iteration is one min-plus SpMM of A^T with the
+// columns of D that changed in the last one, so finished sources drop out
+// and the rest share every pass over A.
+template <typename T, typename a>
+float batchSssp(Matrix<T>*                D,
+                const Matrix<a>*          A,
+                const std::vector<Index>& sources,
+                Descriptor*               desc) {
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+  const Index nsources = sources.size();
+
+  std::vector<T> dist(A_nrows*nsources, backend::ssspInfinity<T>());
+  for (Index k = 0; k < nsources; ++k)
+    dist[sources[k]*nsources + k] = static_cast<T>(0);
+  CHECK(D->build(&dist, dist.size()));
+
+  // Columns still changing
+  Vector<int> active(nsources);
+  CHECK(active.fill(1));
+  Index nactive = nsources;
+
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  // The caller's GrB_INP0 is restored before any error is returned
+  CHECK(desc->toggle(GrB_INP0));
+  Info  info = GrB_SUCCESS;
+  Index iter;
+  for (iter = 1; iter <= desc->descriptor_.max_niter_; ++iter) {
+    info = mxmAccumMask<T, int, a, T>(D, &active, &nactive, minimum<T>(),
+        MinimumPlusSemiring<a, T, T>(), A, D, desc);
+    if (info != GrB_SUCCESS)
+      break;
+    if (desc->descriptor_.debug())
+      std::cout << "=====Batch SSSP Iteration " << iter << ": " << nactive
+          << "/" << nsources << " sources active=====\n";
+    if (nactive == 0)
+      break;
+  }
+  CHECK(desc->toggle(GrB_INP0));
+  CHECK(info);
+  gpu_tight.Stop();
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "batch, " << nsources << ", " << iter << ", "
+        << gpu_tight.ElapsedMillis() << "\n";
+  return gpu_tight.ElapsedMillis();
+}
+
 template <typename T, typename a>
 int ssspCpu(Index        source,
             Matrix<a>*   A,
@@ -40,6 +40,7 @@ float tc(int*               ntris,
 
   // ntris = reduce(B)
   reduce<int, int>(ntris, GrB_NULL, PlusMonoid<int>(), B, desc);
+  CHECK(desc->toggle(graphblas::GrB_INP1));
 
   if (desc->descriptor_.debug())
     std::cout << "ntris: " << *ntris << std::endl;
@@ -53,6 +54,42 @@ float tc(int*               ntris,
   return gpu_tight_time;
 }
 
+// Degree-ordered TC on the full symmetric A. Preprocessing relabels by
+// degree and orients into L, then triangles are counted by masked SpGEMM
+// (B is its buffer) or, with merge, by merge intersection of rows of L.
+// Preprocessing and counting are timed separately.
+float tcDegree(int*               ntris,
+               const Matrix<int>* A,
+               Matrix<int>*       L,
+               Matrix<int>*       B,
+               bool               merge,
+               Descriptor*        desc) {
+  backend::GpuTimer gpu_tight;
+  gpu_tight.Start();
+  CHECK(trilDegree<int, int>(L, GrB_NULL, A, desc));
+  gpu_tight.Stop();
+  float preprocess_time = gpu_tight.ElapsedMillis();
+
+  float count_time;
+  if (merge) {
+    gpu_tight.Start();
+    CHECK(tcIntersect<int, int>(ntris, L, desc));
+    gpu_tight.Stop();
+    count_time = gpu_tight.ElapsedMillis();
+  } else {
+    // tc prints its own timing
+    int timing = desc->descriptor_.timing_;
+    desc->descriptor_.timing_ = 0;
+    count_time = tc(ntris, L, B, desc);
+    desc->descriptor_.timing_ = timing;
+  }
+
+  if (desc->descriptor_.timing_ > 0)
+    std::cout << "preprocess, " << preprocess_time << "\ncount, "
+        << count_time << "\n";
+  return preprocess_time + count_time;
+}
+
 template <typename T, typename a>
 int tcCpu(T*         ntris,
           Matrix<a>* A,
@@ -0,0 +1,89 @@
+#ifndef GRAPHBLAS_ALGORITHM_TEST_BC_HPP_
+#define GRAPHBLAS_ALGORITHM_TEST_BC_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace algorithm {
+
+// A simple CPU-based reference betweenness centrality implementation of
+// Brandes' algorithm, one BFS from each source along the rows of the CSR
+void SimpleReferenceBc(Index                     nrows,
+                       const Index*              h_csrRowPtr,
+                       const Index*              h_csrColInd,
+                       const std::vector<Index>& sources,
+                       double                    scale,
+                       std::vector<double>*      h_bc_cpu) {
+  h_bc_cpu->assign(nrows, 0.);
+  std::vector<Index>  order(nrows);
+  std::vector<Index>  depth(nrows);
+  std::vector<double> sigma(nrows);
+  std::vector<double> delta(nrows);
+
+  for (Index k = 0; k < sources.size(); ++k) {
+    Index src = sources[k];
+    std::fill(depth.begin(), depth.end(), -1);
+    std::fill(sigma.begin(), sigma.end(), 0.);
+    std::fill(delta.begin(), delta.end(), 0.);
+    depth[src] = 0;
+    sigma[src] = 1.;
+
+    // BFS, keeping the vertices in the order they are dequeued
+    Index head = 0;
+    Index tail = 0;
+    order[tail++] = src;
+    while (head < tail) {
+      Index row = order[head++];
+      for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+        Index col = h_csrColInd[j];
+        if (depth[col] == -1) {
+          depth[col] = depth[row] + 1;
+          order[tail++] = col;
+        }
+        if (depth[col] == depth[row] + 1)
+          sigma[col] += sigma[row];
+      }
+    }
+
+    // Dependencies in reverse BFS order
+    for (Index i = tail - 1; i > 0; --i) {
+      Index row = order[i];
+      for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+        Index col = h_csrColInd[j];
+        if (depth[col] == depth[row] + 1)
+          delta[row] += sigma[row]/sigma[col]*(1. + delta[col]);
+      }
+      (*h_bc_cpu)[row] += scale*delta[row];
+    }
+  }
+}
+
+// Compares betweenness centrality to the reference within a relative
+// tolerance
+template <typename T>
+int SimpleVerifyBc(const std::vector<double>& h_bc_cpu,
+                   const std::vector<T>&      h_bc,
+                   double                     tol = 1e-4) {
+  int num_error = 0;
+  for (Index i = 0; i < h_bc_cpu.size(); ++i) {
+    double diff = std::fabs(h_bc_cpu[i] - static_cast<double>(h_bc[i]));
+    if (diff > tol*std::max(1., std::fabs(h_bc_cpu[i]))) {
+      if (num_error == 0)
+        std::cout << "\nINCORRECT: [" << i << "]: " << h_bc[i] << " != "
+            << h_bc_cpu[i] << "\n";
+      num_error++;
+    }
+  }
+  if (num_error == 0)
+    std::cout << "\nCORRECT\n";
+  else
+    std::cout << num_error << " errors occurred.\n";
+  return num_error;
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_TEST_BC_HPP_
@@ -2,6 +2,7 @@
 #define GRAPHBLAS_ALGORITHM_TEST_BFS_HPP_
 
 #include <deque>
+#include <iostream>
 
 namespace graphblas {
 namespace algorithm {
@@ -19,6 +20,11 @@ int SimpleReferenceBfs(Index        nrows,
   for (Index i = 0; i < nrows; ++i)
     source_path[i] = 0;
   source_path[src] = 1;
+  if (predecessor != NULL) {
+    for (Index i = 0; i < nrows; ++i)
+      predecessor[i] = -1;
+    predecessor[src] = src;
+  }
   Index search_depth = 1;
 
   // Initialize queue for managing previously-discovered nodes
@@ -45,6 +51,8 @@ int SimpleReferenceBfs(Index        nrows,
       Index neighbor = h_colInd[edge];
       if (source_path[neighbor] == 0) {
         source_path[neighbor] = neighbor_dist;
+        if (predecessor != NULL)
+          predecessor[neighbor] = dequeued_node;
         if (search_depth < neighbor_dist)
           search_depth = neighbor_dist;
         frontier.push_back(neighbor);
@@ -59,6 +67,45 @@ int SimpleReferenceBfs(Index        nrows,
 
   return search_depth;
 }
+
+// Graph500-style check of a BFS tree: the source is its own parent, every
+// other vertex has a parent iff it was reached, and that parent is one level
+// closer to the source and joined to it by an edge. Returns the number of
+// vertices that fail.
+template <typename T>
+int SimpleVerifyBfsParent(Index        nrows,
+                          const Index* h_rowPtr,
+                          const Index* h_colInd,
+                          const T*     depth,
+                          const Index* parent,
+                          Index        src) {
+  int errors = 0;
+  for (Index i = 0; i < nrows; ++i) {
+    Index p = parent[i];
+    bool valid;
+    if (i == src) {
+      valid = (p == src);
+    } else if (depth[i] == 0) {
+      valid = (p == -1);
+    } else if (p < 0 || p >= nrows || depth[p] + 1 != depth[i]) {
+      valid = false;
+    } else {
+      valid = false;
+      for (Index j = h_rowPtr[p]; j < h_rowPtr[p+1]; ++j) {
+        if (h_colInd[j] == i) {
+          valid = true;
+          break;
+        }
+      }
+    }
+    if (!valid) {
+      if (errors < 10)
+        std::cout << "Invalid parent " << p << " of vertex " << i << "\n";
+      errors++;
+    }
+  }
+  return errors;
+}
 }  // namespace algorithm
 }  // namespace graphblas
 
@@ -0,0 +1,172 @@
+#ifndef GRAPHBLAS_ALGORITHM_TEST_COMMUNITY_HPP_
+#define GRAPHBLAS_ALGORITHM_TEST_COMMUNITY_HPP_
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace graphblas {
+namespace algorithm {
+
+// A simple CPU-based reference modularity: sum over communities of the
+// weight inside over 2m, minus the squared weighted degree over 2m
+template <typename a>
+double SimpleReferenceModularity(Index                   nrows,
+                                 const Index*            h_csrRowPtr,
+                                 const Index*            h_csrColInd,
+                                 const a*                h_csrVal,
+                                 const std::vector<int>& h_comm) {
+  std::vector<double> tot(nrows, 0.);
+  double m2     = 0.;
+  double inside = 0.;
+  for (Index row = 0; row < nrows; ++row) {
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+      m2 += h_csrVal[j];
+      tot[h_comm[row]] += h_csrVal[j];
+      if (h_comm[h_csrColInd[j]] == h_comm[row])
+        inside += h_csrVal[j];
+    }
+  }
+  if (m2 == 0.)
+    return 0.;
+  double q = inside/m2;
+  for (Index c = 0; c < nrows; ++c)
+    q -= (tot[c]/m2)*(tot[c]/m2);
+  return q;
+}
+
+// A simple CPU-based reference Louvain implementation: vertices move one at
+// a time, in order, to the neighbouring community of largest gain until a
+// sweep moves none, then communities are merged into vertices of the next
+// level. Returns the modularity of the final partition.
+template <typename a>
+double SimpleReferenceLouvain(Index             nrows,
+                              const Index*      h_csrRowPtr,
+                              const Index*      h_csrColInd,
+                              const a*          h_csrVal,
+                              std::vector<int>* h_comm_cpu) {
+  typedef std::map<Index, double> Row;
+  std::vector<Row> graph(nrows);
+  h_comm_cpu->resize(nrows);
+  for (Index row = 0; row < nrows; ++row) {
+    (*h_comm_cpu)[row] = row;
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j)
+      graph[row][h_csrColInd[j]] += h_csrVal[j];
+  }
+
+  while (true) {
+    const Index n = graph.size();
+    std::vector<double> k(n, 0.);
+    std::vector<double> tot(n);
+    std::vector<Index>  comm(n);
+    double m2 = 0.;
+    for (Index u = 0; u < n; ++u) {
+      for (Row::iterator it = graph[u].begin(); it != graph[u].end(); ++it)
+        k[u] += it->second;
+      tot[u]  = k[u];
+      comm[u] = u;
+      m2     += k[u];
+    }
+    if (m2 == 0.)
+      break;
+
+    bool moved_any = false;
+    bool moved     = true;
+    while (moved) {
+      moved = false;
+      for (Index u = 0; u < n; ++u) {
+        Row weight;
+        for (Row::iterator it = graph[u].begin(); it != graph[u].end(); ++it)
+          if (it->first != u)
+            weight[comm[it->first]] += it->second;
+        Index cu = comm[u];
+        tot[cu] -= k[u];
+        Index  best      = cu;
+        double best_gain = weight[cu] - k[u]*tot[cu]/m2;
+        for (Row::iterator it = weight.begin(); it != weight.end(); ++it) {
+          double gain = it->second - k[u]*tot[it->first]/m2;
+          if (gain > best_gain + 1e-12) {
+            best      = it->first;
+            best_gain = gain;
+          }
+        }
+        tot[best] += k[u];
+        if (best != cu) {
+          comm[u]   = best;
+          moved     = true;
+          moved_any = true;
+        }
+      }
+    }
+    if (!moved_any)
+      break;
+
+    std::vector<Index> id(n, -1);
+    Index ncomm = 0;
+    for (Index u = 0; u < n; ++u)
+      if (id[comm[u]] == -1)
+        id[comm[u]] = ncomm++;
+    for (Index row = 0; row < nrows; ++row)
+      (*h_comm_cpu)[row] = id[comm[(*h_comm_cpu)[row]]];
+    std::vector<Row> coarse(ncomm);
+    for (Index u = 0; u < n; ++u)
+      for (Row::iterator it = graph[u].begin(); it != graph[u].end(); ++it)
+        coarse[id[comm[u]]][id[comm[it->first]]] += it->second;
+    graph.swap(coarse);
+  }
+  return SimpleReferenceModularity(nrows, h_csrRowPtr, h_csrColInd, h_csrVal,
+      *h_comm_cpu);
+}
+
+// Checks that every label is a vertex id, that q is the modularity of the
+// labels, and that q is positive and at most tol below q_ref, the
+// modularity the reference Louvain reaches. Communities themselves are not
+// unique, so they are not compared to a reference.
+template <typename a>
+int SimpleVerifyCommunity(Index                   nrows,
+                          const Index*            h_csrRowPtr,
+                          const Index*            h_csrColInd,
+                          const a*                h_csrVal,
+                          const std::vector<int>& h_comm,
+                          double                  q,
+                          double                  q_ref,
+                          double                  tol) {
+  int num_error = 0;
+  for (Index i = 0; i < nrows; ++i) {
+    if (h_comm[i] < 0 || h_comm[i] >= nrows) {
+      if (num_error == 0)
+        std::cout << "\nINCORRECT: [" << i << "]: label " << h_comm[i]
+            << " out of range\n";
+      num_error++;
+    }
+  }
+  if (num_error == 0) {
+    double q_cpu = SimpleReferenceModularity(nrows, h_csrRowPtr, h_csrColInd,
+        h_csrVal, h_comm);
+    if (std::fabs(q - q_cpu) > 1e-4) {
+      std::cout << "\nINCORRECT: modularity " << q << " != " << q_cpu << "\n";
+      num_error++;
+    }
+  }
+  // Singletons, or any partition no better than one, have q <= 0
+  if (num_error == 0 && h_csrRowPtr[nrows] > 0 && q <= 0.) {
+    std::cout << "\nINCORRECT: modularity " << q << " is not positive\n";
+    num_error++;
+  }
+  if (num_error == 0 && q < q_ref - tol) {
+    std::cout << "\nINCORRECT: modularity " << q << " < reference " << q_ref
+        << " - " << tol << "\n";
+    num_error++;
+  }
+  if (num_error == 0)
+    std::cout << "\nCORRECT\n";
+  else
+    std::cout << num_error << " errors occurred.\n";
+  return num_error;
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_TEST_COMMUNITY_HPP_
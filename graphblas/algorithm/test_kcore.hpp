@@ -0,0 +1,73 @@
+#ifndef GRAPHBLAS_ALGORITHM_TEST_KCORE_HPP_
+#define GRAPHBLAS_ALGORITHM_TEST_KCORE_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace graphblas {
+namespace algorithm {
+
+// A simple CPU-based reference k-core implementation: repeatedly remove the
+// vertex of smallest remaining degree, using a heap with lazy deletion
+int SimpleReferenceKcore(Index             nrows,
+                         const Index*      h_csrRowPtr,
+                         const Index*      h_csrColInd,
+                         std::vector<int>* h_kcore_cpu) {
+  typedef std::pair<Index, Index> DegreeIndex;
+  std::priority_queue<DegreeIndex, std::vector<DegreeIndex>,
+      std::greater<DegreeIndex> > heap;
+  std::vector<Index> degree(nrows);
+  std::vector<bool>  removed(nrows, false);
+  h_kcore_cpu->assign(nrows, 0);
+  for (Index i = 0; i < nrows; ++i) {
+    degree[i] = h_csrRowPtr[i+1] - h_csrRowPtr[i];
+    heap.push(std::make_pair(degree[i], i));
+  }
+
+  int k = 0;
+  while (!heap.empty()) {
+    DegreeIndex top = heap.top();
+    heap.pop();
+    Index row = top.second;
+    if (removed[row] || top.first != degree[row])
+      continue;
+    removed[row] = true;
+    k = std::max(k, static_cast<int>(degree[row]));
+    (*h_kcore_cpu)[row] = k;
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+      Index col = h_csrColInd[j];
+      if (!removed[col]) {
+        degree[col]--;
+        heap.push(std::make_pair(degree[col], col));
+      }
+    }
+  }
+  return k;
+}
+
+// Compares core numbers to the reference
+int SimpleVerifyKcore(const std::vector<int>& h_kcore_cpu,
+                      const std::vector<int>& h_kcore) {
+  int num_error = 0;
+  for (Index i = 0; i < h_kcore_cpu.size(); ++i) {
+    if (h_kcore_cpu[i] != h_kcore[i]) {
+      if (num_error == 0)
+        std::cout << "\nINCORRECT: [" << i << "]: " << h_kcore[i] << " != "
+            << h_kcore_cpu[i] << "\n";
+      num_error++;
+    }
+  }
+  if (num_error == 0)
+    std::cout << "\nCORRECT\n";
+  else
+    std::cout << num_error << " errors occurred.\n";
+  return num_error;
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_TEST_KCORE_HPP_
@@ -0,0 +1,128 @@
+#ifndef GRAPHBLAS_ALGORITHM_TEST_KTRUSS_HPP_
+#define GRAPHBLAS_ALGORITHM_TEST_KTRUSS_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace algorithm {
+
+// Support of every live entry of a symmetric CSR pattern, counting common
+// live neighbours of its two endpoints
+void SimpleReferenceSupport(Index                    nrows,
+                            const Index*             h_csrRowPtr,
+                            const Index*             h_csrColInd,
+                            const std::vector<bool>& alive,
+                            std::vector<int>*        support) {
+  std::vector<bool> mark(nrows, false);
+  support->assign(h_csrRowPtr[nrows], 0);
+  for (Index row = 0; row < nrows; ++row) {
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j)
+      if (alive[j])
+        mark[h_csrColInd[j]] = true;
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+      Index col = h_csrColInd[j];
+      if (!alive[j])
+        continue;
+      for (Index l = h_csrRowPtr[col]; l < h_csrRowPtr[col+1]; ++l)
+        if (alive[l] && mark[h_csrColInd[l]])
+          (*support)[j]++;
+    }
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j)
+      mark[h_csrColInd[j]] = false;
+  }
+}
+
+// A simple CPU-based reference k-truss implementation: recount the support
+// of every edge and drop those below k - 2 until none is dropped. With
+// k == 0, this runs for k = 3, 4, ... and the values are truss numbers.
+// Outputs the tuples of the result in row-major order, and returns the
+// largest truss number (or the number of tuples for k > 0).
+int SimpleReferenceKtruss(Index               nrows,
+                          const Index*        h_csrRowPtr,
+                          const Index*        h_csrColInd,
+                          int                 k,
+                          std::vector<Index>* h_row,
+                          std::vector<Index>* h_col,
+                          std::vector<int>*   h_val) {
+  const Index nvals = h_csrRowPtr[nrows];
+  std::vector<bool> alive(nvals);
+  std::vector<int>  truss(nvals, 0);
+  std::vector<int>  support;
+  Index remaining = 0;
+  for (Index row = 0; row < nrows; ++row) {
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+      alive[j]   = (h_csrColInd[j] != row);
+      remaining += alive[j];
+    }
+  }
+
+  int k_level = (k == 0) ? 3 : k;
+  for (; remaining > 0; ++k_level) {
+    bool dropped = true;
+    while (dropped) {
+      dropped = false;
+      SimpleReferenceSupport(nrows, h_csrRowPtr, h_csrColInd, alive,
+          &support);
+      for (Index j = 0; j < nvals; ++j) {
+        if (alive[j] && support[j] < k_level - 2) {
+          alive[j] = false;
+          truss[j] = k_level - 1;
+          dropped  = true;
+          remaining--;
+        }
+      }
+    }
+    if (k != 0)
+      break;
+  }
+
+  h_row->clear();
+  h_col->clear();
+  h_val->clear();
+  for (Index row = 0; row < nrows; ++row) {
+    for (Index j = h_csrRowPtr[row]; j < h_csrRowPtr[row+1]; ++j) {
+      if (h_csrColInd[j] == row || (k != 0 && !alive[j]))
+        continue;
+      h_row->push_back(row);
+      h_col->push_back(h_csrColInd[j]);
+      h_val->push_back((k == 0) ? truss[j] : support[j]);
+    }
+  }
+  return (k == 0) ? k_level - 2 : h_val->size();
+}
+
+// Compares the tuples of a k-truss to the reference
+int SimpleVerifyKtruss(const std::vector<Index>& h_row_cpu,
+                       const std::vector<Index>& h_col_cpu,
+                       const std::vector<int>&   h_val_cpu,
+                       const std::vector<Index>& h_row,
+                       const std::vector<Index>& h_col,
+                       const std::vector<int>&   h_val) {
+  int num_error = 0;
+  if (h_row.size() != h_row_cpu.size()) {
+    std::cout << "\nINCORRECT: " << h_row.size() << " != " << h_row_cpu.size()
+        << " edges\n";
+    return 1;
+  }
+  for (Index i = 0; i < h_row_cpu.size(); ++i) {
+    if (h_row_cpu[i] != h_row[i] || h_col_cpu[i] != h_col[i] ||
+        h_val_cpu[i] != h_val[i]) {
+      if (num_error == 0)
+        std::cout << "\nINCORRECT: [" << h_row[i] << ", " << h_col[i]
+            << "]: " << h_val[i] << " != [" << h_row_cpu[i] << ", "
+            << h_col_cpu[i] << "]: " << h_val_cpu[i] << "\n";
+      num_error++;
+    }
+  }
+  if (num_error == 0)
+    std::cout << "\nCORRECT\n";
+  else
+    std::cout << num_error << " errors occurred.\n";
+  return num_error;
+}
+}  // namespace algorithm
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_ALGORITHM_TEST_KTRUSS_HPP_
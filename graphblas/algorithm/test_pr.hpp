@@ -38,10 +38,18 @@ int SimpleReferencePr(Index        nrows,
   CpuTimer cpu_timer;
   cpu_timer.Start();
   for (int i = 0; i < max_niter; ++i) {
+    // Rank on vertices without out-edges is spread over all vertices
+    T dangling = 0.f;
     for (Index node = 0; node < nrows; ++node)
-      pagerank[node] = (1.f-alpha)/nrows;
+      if (outdegrees[node] == 0)
+        dangling += source_path[node];
+    for (Index node = 0; node < nrows; ++node)
+      pagerank[node] = (1.f-alpha)/nrows + alpha*dangling/nrows;
 
     for (Index node = 0; node < nrows; ++node) {
+      if (outdegrees[node] == 0)
+        continue;
+
       // Contribution
       T contrib = source_path[node]/outdegrees[node];
 
@@ -24,7 +24,7 @@ int SimpleReferenceSssp(Index        nrows,
 
   // Initialize distances
   for (Index i = 0; i < nrows; ++i)
-    source_path[i] = std::numeric_limits<T>::max();
+    source_path[i] = backend::ssspInfinity<T>();
   source_path[src] = 0.f;
   Index search_depth = 0;
 
@@ -56,7 +56,7 @@ int SimpleReferenceSssp(Index        nrows,
         Index neighbor = h_colInd[edge];
         T distance_to_neighbor = h_val[edge];
         if (!processed[neighbor] &&
-            distance_to_neighbor != std::numeric_limits<T>::max()) {
+            distance_to_neighbor != backend::ssspInfinity<T>()) {
           T new_distance = distance + distance_to_neighbor;
           if (new_distance < source_path[neighbor]) {
             source_path[neighbor] = new_distance;
@@ -0,0 +1,236 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_BC_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_BC_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+/*!
+ * Batched Brandes betweenness centrality on the CPU, in the multi-source
+ * linear algebra form of Buluc and Gilbert (Combinatorial BLAS). A batch of
+ * nb sources keeps n x nb dense matrices stored row-major, so a neighbour
+ * adds one contiguous nb-wide row and the inner loops vectorize:
+ *   1) forward, one level at a time: the frontier F holds the path counts
+ *      of the entries found in the last level, and the next frontier is the
+ *      PlusTimes product A^T F under the complement of the visited mask.
+ *      Only vertices with unvisited entries left pull over their in-edges,
+ *      and only in-neighbours in the frontier are read.
+ *   2) backward, deepest level first: the dependencies of the entries at
+ *      depth d are sigma .* (A W), where W = (1 + delta) ./ sigma is kept
+ *      for the entries at depth d+1. This pulls over out-edges, again only
+ *      reading neighbours with an entry at depth d+1.
+ *
+ * v(i) gets scale times the sum over all sources of their dependency on i.
+ */
+template <typename T, typename a>
+Info bcBatchCpu(DenseVector<T>*        v,
+                const SparseMatrix<a>* A,
+                bool                   use_tran,
+                const Index*           sources,
+                Index                  nsources,
+                Index                  batch,
+                double                 scale,
+                Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index  nb_max = std::min(batch, nsources);
+  const size_t nvals  = static_cast<size_t>(A_nrows)*nb_max;
+  std::vector<double> sigma(nvals);
+  std::vector<double> frontier(nvals);
+  std::vector<double> next_front(nvals, 0.);
+  std::vector<Index>  depth(nvals);
+  std::vector<char>   in_front(A_nrows, 0);
+  std::vector<double> bc(A_nrows, 0.);
+
+  // Vertices with an entry first reached at depth d are
+  // level_vert[level_ptr[d], level_ptr[d+1])
+  std::vector<Index> level_ptr;
+  std::vector<Index> level_vert;
+  std::vector<Index> pending;
+  std::vector<Index> next;
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > found_t(nthreads);
+  std::vector<std::vector<Index> > pending_t(nthreads);
+
+  long long nedges = 0;
+  for (Index s0 = 0; s0 < nsources; s0 += batch) {
+    const Index  nb   = std::min(batch, nsources - s0);
+    const size_t n_nb = static_cast<size_t>(A_nrows)*nb;
+    std::fill(sigma.begin(),    sigma.begin() + n_nb,    0.);
+    std::fill(frontier.begin(), frontier.begin() + n_nb, 0.);
+    std::fill(depth.begin(),    depth.begin() + n_nb,    -1);
+
+    level_vert.clear();
+    level_ptr.assign(1, 0);
+    for (Index k = 0; k < nb; ++k) {
+      Index  s   = sources[s0 + k];
+      size_t ind = static_cast<size_t>(s)*nb + k;
+      sigma[ind]    = 1.;
+      frontier[ind] = 1.;
+      depth[ind]    = 0;
+      if (!in_front[s]) {
+        in_front[s] = 1;
+        level_vert.push_back(s);
+      }
+    }
+    level_ptr.push_back(level_vert.size());
+
+    pending.resize(A_nrows);
+    #pragma omp parallel for
+    for (Index i = 0; i < A_nrows; ++i)
+      pending[i] = i;
+
+    // 1) Forward: next frontier = !visited .* (A^T F)
+    Index d;
+    for (d = 0; level_ptr[d+1] > level_ptr[d] && !pending.empty(); ++d) {
+      #pragma omp parallel reduction(+:nedges)
+      {
+        const int tid = threadId();
+        const Index* A_cscColPtr;
+        const Index* A_cscRowInd;
+        const a*     A_cscVal;
+        spmvCpuArrays(A, use_tran, &A_cscColPtr, &A_cscRowInd, &A_cscVal);
+
+        #pragma omp for schedule(dynamic, 256)
+        for (Index idx = 0; idx < pending.size(); ++idx) {
+          Index   row   = pending[idx];
+          size_t  off   = static_cast<size_t>(row)*nb;
+          double* acc   = &next_front[off];
+          Index*  d_row = &depth[off];
+          for (Index j = A_cscColPtr[row]; j < A_cscColPtr[row+1]; ++j) {
+            Index col = A_cscRowInd[j];
+            if (!in_front[col])
+              continue;
+            const double* f_row = &frontier[static_cast<size_t>(col)*nb];
+            for (Index k = 0; k < nb; ++k)
+              acc[k] += f_row[k];
+          }
+          nedges += A_cscColPtr[row+1] - A_cscColPtr[row];
+
+          bool found = false;
+          bool left  = false;
+          for (Index k = 0; k < nb; ++k) {
+            if (d_row[k] == -1 && acc[k] != 0.) {
+              sigma[off + k] = acc[k];
+              d_row[k] = d + 1;
+              found = true;
+            } else {
+              acc[k] = 0.;
+              left |= (d_row[k] == -1);
+            }
+          }
+          if (found)
+            found_t[tid].push_back(row);
+          if (left)
+            pending_t[tid].push_back(row);
+        }
+      }
+
+      // Old frontier rows are cleared so the buffers can swap
+      for (Index idx = level_ptr[d]; idx < level_ptr[d+1]; ++idx) {
+        Index row = level_vert[idx];
+        in_front[row] = 0;
+        std::fill_n(&frontier[static_cast<size_t>(row)*nb], nb, 0.);
+      }
+      frontier.swap(next_front);
+      next.clear();
+      for (int t = 0; t < nthreads; ++t) {
+        for (Index idx = 0; idx < found_t[t].size(); ++idx) {
+          in_front[found_t[t][idx]] = 1;
+          level_vert.push_back(found_t[t][idx]);
+        }
+        next.insert(next.end(), pending_t[t].begin(), pending_t[t].end());
+        found_t[t].clear();
+        pending_t[t].clear();
+      }
+      level_ptr.push_back(level_vert.size());
+      pending.swap(next);
+
+      if (desc->debug())
+        std::cout << "bc forward " << d + 1 << ": "
+            << level_ptr[d+2] - level_ptr[d+1] << " vertices found, "
+            << pending.size() << " pending\n";
+    }
+    for (Index idx = level_ptr[d]; idx < level_ptr[d+1]; ++idx) {
+      Index row = level_vert[idx];
+      in_front[row] = 0;
+      std::fill_n(&frontier[static_cast<size_t>(row)*nb], nb, 0.);
+    }
+
+    // 2) Backward: delta = sigma .* (A W) at each depth, and the frontier
+    // buffer holds W = (1 + delta) ./ sigma
+    std::vector<double>& weight = frontier;
+    const Index nlevels = level_ptr.size() - 1;
+    for (d = nlevels - 1; d >= 1; --d) {
+      if (d < nlevels - 1)
+        for (Index idx = level_ptr[d+1]; idx < level_ptr[d+2]; ++idx)
+          in_front[level_vert[idx]] = 1;
+
+      #pragma omp parallel reduction(+:nedges)
+      {
+        const Index* A_csrRowPtr;
+        const Index* A_csrColInd;
+        const a*     A_csrVal;
+        spmvCpuArrays(A, !use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+        std::vector<double> acc(nb);
+
+        #pragma omp for schedule(dynamic, 256)
+        for (Index idx = level_ptr[d]; idx < level_ptr[d+1]; ++idx) {
+          Index        row   = level_vert[idx];
+          size_t       off   = static_cast<size_t>(row)*nb;
+          const Index* d_row = &depth[off];
+          std::fill(acc.begin(), acc.end(), 0.);
+          if (d < nlevels - 1) {
+            for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+              Index col = A_csrColInd[j];
+              if (!in_front[col])
+                continue;
+              size_t        c_off = static_cast<size_t>(col)*nb;
+              const Index*  d_col = &depth[c_off];
+              const double* w_col = &weight[c_off];
+              for (Index k = 0; k < nb; ++k)
+                acc[k] += (d_col[k] == d + 1) ? w_col[k] : 0.;
+            }
+            nedges += A_csrRowPtr[row+1] - A_csrRowPtr[row];
+          }
+
+          double sum = 0.;
+          for (Index k = 0; k < nb; ++k) {
+            if (d_row[k] != d)
+              continue;
+            double delta = sigma[off + k]*acc[k];
+            weight[off + k] = (1. + delta)/sigma[off + k];
+            sum += delta;
+          }
+          bc[row] += sum;
+        }
+      }
+
+      if (d < nlevels - 1)
+        for (Index idx = level_ptr[d+1]; idx < level_ptr[d+2]; ++idx)
+          in_front[level_vert[idx]] = 0;
+    }
+
+    if (desc->debug())
+      std::cout << "bc batch " << s0/batch << ": " << nb << " sources, "
+          << nlevels << " levels\n";
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "bc, " << nsources << " sources, " << nedges
+        << " edges read\n";
+
+  T* v_val = v->h_val_;
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    v_val[i] = static_cast<T>(scale*bc[i]);
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_BC_HPP_
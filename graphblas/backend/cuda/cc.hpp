@@ -0,0 +1,158 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_CC_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_CC_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Neighbours each vertex links in the sampling rounds of Afforest
+const Index kAfforestNeighborRounds = 2;
+
+// Vertices sampled to find the giant component
+const Index kAfforestSamples = 1024;
+
+/*!
+ * Hooks the trees of u and v together, the higher root under the lower one.
+ * Lock-free: a root is only rewritten by a compare-and-swap that expects it
+ * to still be a root, and a failed swap retries from the new parents.
+ */
+inline void afforestLink(Index* comp, Index u, Index v) {
+  Index p1 = __atomic_load_n(&comp[u], __ATOMIC_RELAXED);
+  Index p2 = __atomic_load_n(&comp[v], __ATOMIC_RELAXED);
+  while (p1 != p2) {
+    Index high   = std::max(p1, p2);
+    Index low    = std::min(p1, p2);
+    Index p_high = __atomic_load_n(&comp[high], __ATOMIC_RELAXED);
+    if (p_high == low)
+      break;
+    if (p_high == high && __atomic_compare_exchange_n(&comp[high], &p_high,
+        low, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      break;
+    p1 = __atomic_load_n(&comp[__atomic_load_n(&comp[high],
+        __ATOMIC_RELAXED)], __ATOMIC_RELAXED);
+    p2 = __atomic_load_n(&comp[low], __ATOMIC_RELAXED);
+  }
+}
+
+// Points every vertex straight at its root
+inline void afforestCompress(Index* comp, Index n) {
+  #pragma omp parallel for schedule(dynamic, 16384)
+  for (Index i = 0; i < n; ++i) {
+    while (comp[i] != comp[comp[i]])
+      comp[i] = comp[comp[i]];
+  }
+}
+
+// Most frequent root among kAfforestSamples random vertices
+inline Index afforestSampleGiant(const Index* comp, Index n, Index seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<Index> dist(0, n - 1);
+  std::unordered_map<Index, Index> count;
+  for (Index i = 0; i < kAfforestSamples; ++i)
+    count[comp[dist(gen)]]++;
+
+  Index giant = 0;
+  Index most  = 0;
+  for (std::unordered_map<Index, Index>::const_iterator it = count.begin();
+      it != count.end(); ++it) {
+    if (it->second > most || (it->second == most && it->first < giant)) {
+      giant = it->first;
+      most  = it->second;
+    }
+  }
+  return giant;
+}
+
+/*!
+ * Afforest connected components on the CPU (Sutton, Ben-Nun, Barak, IPDPS
+ * 2018). Each vertex first links its first kAfforestNeighborRounds
+ * neighbours, one round at a time with a compress after each. The most
+ * common root among sampled vertices is taken to be the giant component,
+ * and only vertices outside it link their remaining neighbours. Edges of the
+ * giant component are then never read again: any edge leaving it is seen
+ * from the other end. If A is not symmetric, those vertices also link their
+ * in-neighbours from the CSC, giving weakly connected components.
+ *
+ * v(i) gets the smallest vertex id in the component of i.
+ */
+template <typename T, typename a>
+Info afforestCpu(DenseVector<T>*        v,
+                 const SparseMatrix<a>* A,
+                 bool                   A_symmetric,
+                 Index                  seed,
+                 Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+  const Index* A_cscColPtr = NULL;
+  const Index* A_cscRowInd = NULL;
+  const a*     A_cscVal;
+  if (!A_symmetric)
+    spmvCpuArrays(A, true, &A_cscColPtr, &A_cscRowInd, &A_cscVal);
+
+  std::vector<Index> comp(A_nrows);
+  Index* comp_val = comp.data();
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    comp_val[i] = i;
+
+  // 1) Link a few sampled neighbours per vertex
+  long long edges = 0;
+  for (Index r = 0; r < kAfforestNeighborRounds; ++r) {
+    #pragma omp parallel for schedule(dynamic, 16384) reduction(+:edges)
+    for (Index u = 0; u < A_nrows; ++u) {
+      Index j = A_csrRowPtr[u] + r;
+      if (j < A_csrRowPtr[u+1]) {
+        afforestLink(comp_val, u, A_csrColInd[j]);
+        edges++;
+      }
+    }
+    afforestCompress(comp_val, A_nrows);
+  }
+
+  // 2) Find the giant component by sampling
+  Index giant = (A_nrows > 0) ?
+      afforestSampleGiant(comp_val, A_nrows, seed) : 0;
+
+  // 3) Finish the vertices outside it
+  #pragma omp parallel for schedule(dynamic, 16384) reduction(+:edges)
+  for (Index u = 0; u < A_nrows; ++u) {
+    if (comp_val[u] == giant)
+      continue;
+    Index row_start = A_csrRowPtr[u] + kAfforestNeighborRounds;
+    Index row_end   = A_csrRowPtr[u+1];
+    for (Index j = row_start; j < row_end; ++j)
+      afforestLink(comp_val, u, A_csrColInd[j]);
+    edges += std::max(row_end - row_start, 0);
+    if (!A_symmetric) {
+      for (Index j = A_cscColPtr[u]; j < A_cscColPtr[u+1]; ++j)
+        afforestLink(comp_val, u, A_cscRowInd[j]);
+      edges += A_cscColPtr[u+1] - A_cscColPtr[u];
+    }
+  }
+  afforestCompress(comp_val, A_nrows);
+
+  if (desc->timing_ > 0)
+    std::cout << "afforest, " << edges << "/" << A->nvals_
+        << " edges traversed\n";
+
+  T* v_val = v->h_val_;
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    v_val[i] = static_cast<T>(comp_val[i]);
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_CC_HPP_
@@ -4,6 +4,8 @@
 #include <cuda.h>
 #include <cusparse.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -87,6 +89,344 @@ Info cusparse_color(DenseVector<W>*        w,
   return GrB_SUCCESS;
 }
 
+// Vertex orders for greedyColorCpu
+enum GreedyColorOrder {
+  kColorNatural,
+  kColorLargestFirst,
+  kColorSmallestLast
+};
+
+/*!
+ * Degeneracy (smallest-last) peeling by bucket sort (Batagelj, Zaversnik).
+ * Vertices are removed in order of their current degree, smallest first.
+ * removed gets the removal order and core (if not NULL) the core number of
+ * each vertex. O(n + nvals), sequential.
+ */
+inline void degeneracyOrder(std::vector<Index>* removed,
+                            std::vector<Index>* core,
+                            const Index*        A_csrRowPtr,
+                            const Index*        A_csrColInd,
+                            Index               A_nrows) {
+  std::vector<Index> degree(A_nrows);
+  Index max_degree = 0;
+  for (Index v = 0; v < A_nrows; ++v) {
+    degree[v]  = A_csrRowPtr[v+1] - A_csrRowPtr[v];
+    max_degree = std::max(max_degree, degree[v]);
+  }
+
+  // bin[d] is the first position of degree d in vert
+  std::vector<Index> bin(max_degree+1, 0);
+  for (Index v = 0; v < A_nrows; ++v)
+    bin[degree[v]]++;
+  Index start = 0;
+  for (Index d = 0; d <= max_degree; ++d) {
+    Index count = bin[d];
+    bin[d] = start;
+    start += count;
+  }
+  std::vector<Index>& vert = *removed;
+  std::vector<Index>  pos(A_nrows);
+  vert.resize(A_nrows);
+  for (Index v = 0; v < A_nrows; ++v) {
+    pos[v] = bin[degree[v]]++;
+    vert[pos[v]] = v;
+  }
+  for (Index d = max_degree; d > 0; --d)
+    bin[d] = bin[d-1];
+  bin[0] = 0;
+
+  // Removing v moves each neighbour with a higher degree down one bin
+  for (Index i = 0; i < A_nrows; ++i) {
+    Index v = vert[i];
+    for (Index j = A_csrRowPtr[v]; j < A_csrRowPtr[v+1]; ++j) {
+      Index u = A_csrColInd[j];
+      if (degree[u] > degree[v]) {
+        Index d_u = degree[u];
+        Index p_u = pos[u];
+        Index p_w = bin[d_u];
+        Index w   = vert[p_w];
+        if (u != w) {
+          pos[u] = p_w;
+          pos[w] = p_u;
+          vert[p_u] = w;
+          vert[p_w] = u;
+        }
+        bin[d_u]++;
+        degree[u]--;
+      }
+    }
+  }
+  if (core != NULL)
+    core->swap(degree);
+}
+
+/*!
+ * Speculative greedy coloring on the CPU (Gebremedhin, Manne; Catalyurek et
+ * al.). Every round colors the worklist in parallel, first-fit, with a
+ * thread-local bitset of the colors taken by neighbours. Neighbours colored
+ * in the same round may pick the same color, so each such conflict is then
+ * found in parallel and the vertex later in the order is recolored in the
+ * next round. The pattern of A must be symmetric.
+ *
+ * Colors start at 1. The order decides who keeps a color: natural order,
+ * largest degree first, or smallest-last (reverse degeneracy) order.
+ */
+template <typename W, typename a>
+Info greedyColorCpu(DenseVector<W>*        w,
+                    const SparseMatrix<a>* A,
+                    GreedyColorOrder       order_type,
+                    Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  std::vector<Index> degree(A_nrows);
+  Index max_degree = 0;
+  #pragma omp parallel for reduction(max:max_degree)
+  for (Index v = 0; v < A_nrows; ++v) {
+    degree[v]  = A_csrRowPtr[v+1] - A_csrRowPtr[v];
+    max_degree = std::max(max_degree, degree[v]);
+  }
+
+  std::vector<Index> worklist;
+  if (order_type == kColorLargestFirst) {
+    trilDegreeOrder(&worklist, degree);
+  } else if (order_type == kColorSmallestLast) {
+    degeneracyOrder(&worklist, NULL, A_csrRowPtr, A_csrColInd, A_nrows);
+    std::reverse(worklist.begin(), worklist.end());
+  } else {
+    worklist.resize(A_nrows);
+    for (Index v = 0; v < A_nrows; ++v)
+      worklist[v] = v;
+  }
+  std::vector<Index> rank(A_nrows);
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    rank[worklist[i]] = i;
+
+  std::vector<Index> color(A_nrows, 0);
+  Index* color_val = color.data();
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > next_t(nthreads);
+  std::vector<Index> next;
+
+  // A vertex of degree d never needs a color above d+1
+  const Index nwords = (max_degree + 2 + 63) / 64;
+  Index round;
+  for (round = 1; !worklist.empty(); ++round) {
+    #pragma omp parallel
+    {
+      std::vector<uint64_t> forbidden(nwords, 0);
+
+      // 1) Tentative first-fit coloring
+      #pragma omp for schedule(dynamic, 64)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index v     = worklist[k];
+        Index limit = degree[v] + 1;
+        for (Index j = A_csrRowPtr[v]; j < A_csrRowPtr[v+1]; ++j) {
+          Index c = __atomic_load_n(&color_val[A_csrColInd[j]],
+              __ATOMIC_RELAXED);
+          if (c <= limit)
+            forbidden[c >> 6] |= static_cast<uint64_t>(1) << (c & 63);
+        }
+        // Color 0 means uncolored, so it is always taken
+        forbidden[0] |= 1;
+        Index c = 0;
+        for (Index word = 0; ; ++word) {
+          if (~forbidden[word] != 0) {
+            c = word*64 + __builtin_ctzll(~forbidden[word]);
+            break;
+          }
+        }
+        std::fill(forbidden.begin(), forbidden.begin() + limit/64 + 1, 0);
+        __atomic_store_n(&color_val[v], c, __ATOMIC_RELAXED);
+      }
+
+      // 2) Conflict detection, the later vertex in the order loses
+      const int tid = threadId();
+      #pragma omp for schedule(dynamic, 64)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index v = worklist[k];
+        for (Index j = A_csrRowPtr[v]; j < A_csrRowPtr[v+1]; ++j) {
+          Index u = A_csrColInd[j];
+          if (color_val[u] == color_val[v] && rank[u] < rank[v]) {
+            next_t[tid].push_back(v);
+            break;
+          }
+        }
+      }
+    }
+
+    next.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      next.insert(next.end(), next_t[t].begin(), next_t[t].end());
+      next_t[t].clear();
+    }
+    // Recolor in the original order
+    struct RankLess {
+      const Index* rank;
+      bool operator()(Index u, Index v) const { return rank[u] < rank[v]; }
+    } less = {rank.data()};
+    std::sort(next.begin(), next.end(), less);
+    for (Index k = 0; k < next.size(); ++k)
+      color_val[next[k]] = 0;
+
+    if (desc->debug())
+      std::cout << "greedy color " << round << ": " << worklist.size()
+          << " colored, " << next.size() << " conflicts\n";
+    worklist.swap(next);
+  }
+
+  Index ncolors = 0;
+  W* w_val = w->h_val_;
+  #pragma omp parallel for reduction(max:ncolors)
+  for (Index v = 0; v < A_nrows; ++v) {
+    w_val[v] = static_cast<W>(color_val[v]);
+    ncolors  = std::max(ncolors, color_val[v]);
+  }
+  if (desc->timing_ > 0)
+    std::cout << "greedy color, " << round - 1 << " rounds, " << ncolors
+        << " colors\n";
+  CHECK(w->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Speculative distance-2 coloring on the CPU, without forming A^2. Two
+ * vertices conflict if they are adjacent or share a neighbour, found by
+ * walking row v of A and then the rows of its neighbours. The pattern of A
+ * must be symmetric.
+ *
+ * With partial, the columns of A are colored instead so that no two columns
+ * share a row (partial distance-2 coloring of the bipartite row-column
+ * graph), as for compressing a Jacobian. Column v walks its rows in the CSC
+ * and then their columns in the CSR; A may be rectangular.
+ *
+ * Rounds work as in greedyColorCpu with natural order: first-fit in
+ * parallel, then the higher id of each clashing pair is recolored. Each
+ * thread marks taken colors with a per-vertex stamp, so there is no
+ * clearing and no bound on the number of colors.
+ */
+template <typename W, typename a>
+Info distance2ColorCpu(DenseVector<W>*        w,
+                       const SparseMatrix<a>* A,
+                       bool                   partial,
+                       Descriptor*            desc) {
+  const Index nvertices = (partial) ? A->ncols_ : A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  // First hop: row v of A, or column v if partial
+  const Index* hop_ptr;
+  const Index* hop_ind;
+  const a*     hop_val;
+  spmvCpuArrays(A, partial, &hop_ptr, &hop_ind, &hop_val);
+
+  std::vector<Index> worklist(nvertices);
+  for (Index v = 0; v < nvertices; ++v)
+    worklist[v] = v;
+
+  std::vector<Index> color(nvertices, 0);
+  Index* color_val = color.data();
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > next_t(nthreads);
+  std::vector<Index> next;
+
+  Index round;
+  for (round = 1; !worklist.empty(); ++round) {
+    #pragma omp parallel
+    {
+      // taken[c] == stamp means color c is used within distance 2
+      std::vector<Index> taken;
+      Index stamp = 0;
+
+      // 1) Tentative first-fit coloring
+      #pragma omp for schedule(dynamic, 64)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index v = worklist[k];
+        stamp++;
+        for (Index j = hop_ptr[v]; j < hop_ptr[v+1]; ++j) {
+          Index x = hop_ind[j];
+          if (!partial && x != v) {
+            Index c = __atomic_load_n(&color_val[x], __ATOMIC_RELAXED);
+            if (c >= taken.size())
+              taken.resize(2*c + 2, 0);
+            taken[c] = stamp;
+          }
+          for (Index l = A_csrRowPtr[x]; l < A_csrRowPtr[x+1]; ++l) {
+            Index u = A_csrColInd[l];
+            if (u == v)
+              continue;
+            Index c = __atomic_load_n(&color_val[u], __ATOMIC_RELAXED);
+            if (c >= taken.size())
+              taken.resize(2*c + 2, 0);
+            taken[c] = stamp;
+          }
+        }
+        Index c = 1;
+        while (c < taken.size() && taken[c] == stamp)
+          c++;
+        __atomic_store_n(&color_val[v], c, __ATOMIC_RELAXED);
+      }
+
+      // 2) Conflict detection, the higher id loses
+      const int tid = threadId();
+      #pragma omp for schedule(dynamic, 64)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index v        = worklist[k];
+        bool  conflict = false;
+        for (Index j = hop_ptr[v]; j < hop_ptr[v+1] && !conflict; ++j) {
+          Index x = hop_ind[j];
+          if (!partial && x < v && color_val[x] == color_val[v])
+            conflict = true;
+          for (Index l = A_csrRowPtr[x]; l < A_csrRowPtr[x+1] && !conflict;
+              ++l) {
+            Index u = A_csrColInd[l];
+            if (u < v && color_val[u] == color_val[v])
+              conflict = true;
+          }
+        }
+        if (conflict)
+          next_t[tid].push_back(v);
+      }
+    }
+
+    next.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      next.insert(next.end(), next_t[t].begin(), next_t[t].end());
+      next_t[t].clear();
+    }
+    std::sort(next.begin(), next.end());
+    for (Index k = 0; k < next.size(); ++k)
+      color_val[next[k]] = 0;
+
+    if (desc->debug())
+      std::cout << "distance-2 color " << round << ": " << worklist.size()
+          << " colored, " << next.size() << " conflicts\n";
+    worklist.swap(next);
+  }
+
+  Index ncolors = 0;
+  W* w_val = w->h_val_;
+  #pragma omp parallel for reduction(max:ncolors)
+  for (Index v = 0; v < nvertices; ++v) {
+    w_val[v] = static_cast<W>(color_val[v]);
+    ncolors  = std::max(ncolors, color_val[v]);
+  }
+  if (desc->timing_ > 0)
+    std::cout << "distance-2 color, " << round - 1 << " rounds, " << ncolors
+        << " colors\n";
+  CHECK(w->cpuToGpu());
+  return GrB_SUCCESS;
+}
 }  // namespace backend
 }  // namespace graphblas
 
@@ -0,0 +1,414 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_COMMUNITY_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_COMMUNITY_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Open addressing map from community label to edge weight, one per thread
+// and sized for the largest degree. Slots in use are listed, so clear()
+// only touches what the last vertex inserted.
+class CommunityMap {
+ public:
+  explicit CommunityMap(Index max_degree) : bits_(4) {
+    while ((static_cast<Index>(1) << bits_) < 2*max_degree)
+      bits_++;
+    key_.assign(static_cast<Index>(1) << bits_, -1);
+    val_.resize(key_.size());
+  }
+
+  void add(Index label, double weight) {
+    uint64_t mask = key_.size() - 1;
+    uint64_t slot = (static_cast<uint64_t>(label)*0x9E3779B97F4A7C15ULL) >>
+        (64 - bits_);
+    while (key_[slot] != -1 && key_[slot] != label)
+      slot = (slot + 1) & mask;
+    if (key_[slot] == -1) {
+      key_[slot] = label;
+      val_[slot] = weight;
+      used_.push_back(slot);
+    } else {
+      val_[slot] += weight;
+    }
+  }
+
+  // Weight of label, or 0 if it is not in the map
+  double get(Index label) const {
+    uint64_t mask = key_.size() - 1;
+    uint64_t slot = (static_cast<uint64_t>(label)*0x9E3779B97F4A7C15ULL) >>
+        (64 - bits_);
+    while (key_[slot] != -1 && key_[slot] != label)
+      slot = (slot + 1) & mask;
+    return (key_[slot] == -1) ? 0. : val_[slot];
+  }
+
+  Index  size()          const { return used_.size(); }
+  Index  label(Index i)  const { return key_[used_[i]]; }
+  double weight(Index i) const { return val_[used_[i]]; }
+
+  void clear() {
+    for (Index i = 0; i < used_.size(); ++i)
+      key_[used_[i]] = -1;
+    used_.clear();
+  }
+
+ private:
+  int                 bits_;
+  std::vector<Index>  key_;
+  std::vector<double> val_;
+  std::vector<Index>  used_;
+};
+
+/*!
+ * Modularity of the partition comm of a graph with symmetric weighted
+ * adjacency CSR arrays, where comm[i] is in [0, nrows):
+ *   Q = sum_c (in_c / 2m - (tot_c / 2m)^2)
+ * in_c is the weight of entries inside c, tot_c the weighted degree of c
+ * and 2m the weight of all entries. Self loops count once.
+ */
+template <typename a, typename L>
+double communityModularity(Index        nrows,
+                           const Index* A_csrRowPtr,
+                           const Index* A_csrColInd,
+                           const a*     A_csrVal,
+                           const L*     comm) {
+  std::vector<double> degree(nrows);
+  double m2     = 0.;
+  double inside = 0.;
+  #pragma omp parallel for schedule(dynamic, 1024) reduction(+:m2, inside)
+  for (Index row = 0; row < nrows; ++row) {
+    double k = 0.;
+    for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+      k += A_csrVal[j];
+      if (comm[A_csrColInd[j]] == comm[row])
+        inside += A_csrVal[j];
+    }
+    degree[row] = k;
+    m2 += k;
+  }
+  if (m2 == 0.)
+    return 0.;
+
+  std::vector<double> tot(nrows, 0.);
+  for (Index row = 0; row < nrows; ++row)
+    tot[static_cast<Index>(comm[row])] += degree[row];
+  double expected = 0.;
+  #pragma omp parallel for reduction(+:expected)
+  for (Index c = 0; c < nrows; ++c)
+    expected += tot[c]*tot[c];
+  return inside/m2 - expected/(m2*m2);
+}
+
+/*!
+ * Label propagation (Raghavan, Albert, Kumara) on the CPU. Each vertex
+ * takes the label of largest total edge weight among its neighbours,
+ * counted in a thread-local CommunityMap; ties keep the current label if
+ * it is among the best, else take the smallest. Only vertices next to a
+ * label change are visited again, so the worklist shrinks as labels settle.
+ *   async == false: labels of an iteration are read from a snapshot and
+ *                   applied together (Jacobi style, deterministic). A
+ *                   vertex does not return to the label it left in the
+ *                   last iteration, which stops two-vertex swaps
+ *   async == true:  labels are updated in place, so a vertex sees changes
+ *                   made earlier in the same iteration (Gauss-Seidel style,
+ *                   converges in fewer iterations)
+ * Runs until no label changes or desc max_niter_ iterations. The pattern
+ * of A must be symmetric. v(i) gets the label of i, the id of a vertex in
+ * its community.
+ */
+template <typename T, typename a>
+Info labelPropCpu(DenseVector<T>*        v,
+                  const SparseMatrix<a>* A,
+                  bool                   async,
+                  Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  Index max_degree = 0;
+  std::vector<Index> label(A_nrows);
+  std::vector<Index> worklist(A_nrows);
+  #pragma omp parallel for reduction(max:max_degree)
+  for (Index i = 0; i < A_nrows; ++i) {
+    label[i]    = i;
+    worklist[i] = i;
+    max_degree  = std::max(max_degree, A_csrRowPtr[i+1] - A_csrRowPtr[i]);
+  }
+  Index* label_val = label.data();
+
+  std::vector<Index> queued(A_nrows, -1);
+  std::vector<Index> left(A_nrows, -1);
+  std::vector<Index> left_iter(A_nrows, -1);
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > next_t(nthreads);
+  std::vector<std::vector<std::pair<Index, Index> > > moved_t(nthreads);
+  std::vector<Index> next;
+
+  Index iter;
+  long long edges = 0;
+  for (iter = 0; !worklist.empty() && iter < desc->max_niter_; ++iter) {
+    Index nchanged = 0;
+    #pragma omp parallel reduction(+:edges, nchanged)
+    {
+      const int tid = threadId();
+      CommunityMap map(max_degree);
+
+      #pragma omp for schedule(dynamic, 256)
+      for (Index idx = 0; idx < worklist.size(); ++idx) {
+        Index u = worklist[idx];
+        for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+          Index w = A_csrColInd[j];
+          if (w != u)
+            map.add(__atomic_load_n(&label_val[w], __ATOMIC_RELAXED),
+                static_cast<double>(A_csrVal[j]));
+        }
+        edges += A_csrRowPtr[u+1] - A_csrRowPtr[u];
+
+        Index  old_label  = __atomic_load_n(&label_val[u], __ATOMIC_RELAXED);
+        Index  best_label = old_label;
+        double best       = map.get(old_label);
+        for (Index i = 0; i < map.size(); ++i) {
+          if (map.weight(i) > best || (map.weight(i) == best &&
+              best_label != old_label && map.label(i) < best_label)) {
+            best       = map.weight(i);
+            best_label = map.label(i);
+          }
+        }
+        map.clear();
+        if (best_label == old_label || (!async && best_label == left[u] &&
+            left_iter[u] == iter - 1))
+          continue;
+
+        nchanged++;
+        left[u]      = old_label;
+        left_iter[u] = iter;
+        if (async)
+          __atomic_store_n(&label_val[u], best_label, __ATOMIC_RELAXED);
+        else
+          moved_t[tid].push_back(std::make_pair(u, best_label));
+        for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+          Index w = A_csrColInd[j];
+          if (__atomic_exchange_n(&queued[w], iter, __ATOMIC_RELAXED) != iter)
+            next_t[tid].push_back(w);
+        }
+      }
+    }
+
+    next.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      for (Index idx = 0; idx < moved_t[t].size(); ++idx)
+        label[moved_t[t][idx].first] = moved_t[t][idx].second;
+      next.insert(next.end(), next_t[t].begin(), next_t[t].end());
+      moved_t[t].clear();
+      next_t[t].clear();
+    }
+    if (desc->debug())
+      std::cout << "lpa " << iter << ": " << worklist.size() << " visited, "
+          << nchanged << " changed\n";
+    worklist.swap(next);
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "lpa, " << iter << " iterations, " << edges
+        << " edges read\n";
+  T* v_val = v->h_val_;
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    v_val[i] = static_cast<T>(label[i]);
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+// Relaxed atomic load and add on a double, for the community totals
+inline double communityLoad(const double* x) {
+  double val;
+  __atomic_load(x, &val, __ATOMIC_RELAXED);
+  return val;
+}
+
+inline void communityAdd(double* x, double y) {
+  double old = communityLoad(x);
+  double val = old + y;
+  while (!__atomic_compare_exchange(x, &old, &val, false, __ATOMIC_RELAXED,
+      __ATOMIC_RELAXED))
+    val = old + y;
+}
+
+/*!
+ * Louvain local moving phase (Blondel et al.) on the CPU, in the parallel
+ * form of PLM (Staudt, Meyerhenke) with the singleton rule of Grappolo (Lu,
+ * Halappanavar, Kalyanaraman). A may be weighted and have self loops, as
+ * coarse graphs are. Every round, each vertex u reads the weights to its
+ * neighbouring communities into a thread-local CommunityMap and moves to
+ * the community c of largest modularity gain
+ *   w(u, c) - k(u) tot(c) / 2m
+ * (u itself taken out of its own). Moves are made in place, with atomic
+ * updates of the community totals, so later vertices see them. Two
+ * singletons never swap: one only joins the other if that has the smaller
+ * id. A round that does not raise modularity by more than 1e-6 is undone
+ * and ends the phase, as does desc max_niter_ rounds. v(i) gets the
+ * community of i, renumbered to [0, number of communities).
+ */
+template <typename T, typename a>
+Info louvainMoveCpu(DenseVector<T>*        v,
+                    const SparseMatrix<a>* A,
+                    Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  std::vector<double> degree(A_nrows);
+  std::vector<double> tot(A_nrows);
+  std::vector<Index>  size(A_nrows, 1);
+  std::vector<Index>  comm(A_nrows);
+  Index  max_degree = 0;
+  double m2         = 0.;
+  #pragma omp parallel for reduction(max:max_degree) reduction(+:m2)
+  for (Index i = 0; i < A_nrows; ++i) {
+    double k = 0.;
+    for (Index j = A_csrRowPtr[i]; j < A_csrRowPtr[i+1]; ++j)
+      k += A_csrVal[j];
+    degree[i]  = k;
+    tot[i]     = k;
+    comm[i]    = i;
+    m2        += k;
+    max_degree = std::max(max_degree, A_csrRowPtr[i+1] - A_csrRowPtr[i]);
+  }
+
+  const int nthreads = numThreads();
+  std::vector<std::vector<std::pair<Index, Index> > > moved_t(nthreads);
+  std::vector<std::pair<Index, Index> > moved;
+  double q = communityModularity(A_nrows, A_csrRowPtr, A_csrColInd, A_csrVal,
+      comm.data());
+
+  Index*  comm_val = comm.data();
+  double* tot_val  = tot.data();
+  Index*  size_val = size.data();
+  Index   round;
+  for (round = 0; round < desc->max_niter_ && m2 > 0.; ++round) {
+    #pragma omp parallel
+    {
+      const int tid = threadId();
+      CommunityMap map(max_degree);
+
+      #pragma omp for schedule(dynamic, 256)
+      for (Index u = 0; u < A_nrows; ++u) {
+        for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+          Index w = A_csrColInd[j];
+          if (w != u)
+            map.add(__atomic_load_n(&comm_val[w], __ATOMIC_RELAXED),
+                static_cast<double>(A_csrVal[j]));
+        }
+
+        const Index  cu     = comm_val[u];
+        const double k_u    = degree[u];
+        double       best   = map.get(cu) -
+            k_u*(communityLoad(&tot_val[cu]) - k_u)/m2;
+        Index        best_c = cu;
+        for (Index i = 0; i < map.size(); ++i) {
+          Index  c    = map.label(i);
+          double gain = map.weight(i) - k_u*communityLoad(&tot_val[c])/m2;
+          if (c != cu && (gain > best || (gain == best && best_c != cu &&
+              c < best_c))) {
+            best   = gain;
+            best_c = c;
+          }
+        }
+        map.clear();
+
+        if (best_c == cu || (__atomic_load_n(&size_val[cu],
+            __ATOMIC_RELAXED) == 1 && __atomic_load_n(&size_val[best_c],
+            __ATOMIC_RELAXED) == 1 && best_c > cu))
+          continue;
+        communityAdd(&tot_val[cu], -k_u);
+        communityAdd(&tot_val[best_c], k_u);
+        __atomic_fetch_sub(&size_val[cu], 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&size_val[best_c], 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&comm_val[u], best_c, __ATOMIC_RELAXED);
+        moved_t[tid].push_back(std::make_pair(u, cu));
+      }
+    }
+
+    // (vertex, old community) of every move, to undo the round
+    moved.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      moved.insert(moved.end(), moved_t[t].begin(), moved_t[t].end());
+      moved_t[t].clear();
+    }
+    if (moved.empty())
+      break;
+
+    double q_next = communityModularity(A_nrows, A_csrRowPtr, A_csrColInd,
+        A_csrVal, comm_val);
+    if (desc->debug())
+      std::cout << "louvain move " << round << ": " << moved.size()
+          << " moved, modularity " << q_next << "\n";
+    if (q_next - q <= 1e-6) {
+      for (Index idx = 0; idx < moved.size(); ++idx) {
+        Index u = moved[idx].first;
+        Index c = moved[idx].second;
+        tot[comm[u]] -= degree[u];
+        size[comm[u]]--;
+        tot[c] += degree[u];
+        size[c]++;
+        comm[u] = c;
+      }
+      break;
+    }
+    q = q_next;
+  }
+
+  // Renumber communities in order of their smallest vertex
+  std::vector<Index> id(A_nrows, -1);
+  Index ncomm = 0;
+  T*    v_val = v->h_val_;
+  for (Index i = 0; i < A_nrows; ++i) {
+    if (id[comm[i]] == -1)
+      id[comm[i]] = ncomm++;
+    v_val[i] = static_cast<T>(id[comm[i]]);
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "louvain move, " << round << " rounds, " << A_nrows
+        << " -> " << ncomm << " communities, modularity " << q << "\n";
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Modularity of the partition v of the graph A on the CPU. Labels in v
+ * must be in [0, nrows).
+ */
+template <typename a, typename T>
+Info modularityCpu(double*                q,
+                   const SparseMatrix<a>* A,
+                   const DenseVector<T>*  v,
+                   Descriptor*            desc) {
+  CHECK(spmvCpuSetup(A));
+  CHECK(const_cast<DenseVector<T>*>(v)->gpuToCpu());
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+  *q = communityModularity(A->nrows_, A_csrRowPtr, A_csrColInd, A_csrVal,
+      v->h_val_);
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_COMMUNITY_HPP_
@@ -3,10 +3,10 @@
 
 #include "graphblas/backend/cuda/types.hpp"
 #include "graphblas/backend/cuda/util.hpp"
+#include "graphblas/backend/cuda/intersect.hpp"
 #include "graphblas/backend/cuda/vector.hpp"
 #include "graphblas/backend/cuda/matrix.hpp"
 #include "graphblas/backend/cuda/transpose.hpp"
-#include "graphblas/backend/cuda/color.hpp"
 #include "graphblas/backend/cuda/spgemm.hpp"
 #include "graphblas/backend/cuda/spmm.hpp"
 #include "graphblas/backend/cuda/gemm.hpp"
@@ -23,6 +23,19 @@
 #include "graphblas/backend/cuda/assign.hpp"
 #include "graphblas/backend/cuda/apply.hpp"
 #include "graphblas/backend/cuda/tri.hpp"
+#include "graphblas/backend/cuda/color.hpp"
+#include "graphblas/backend/cuda/deferred.hpp"
+#include "graphblas/backend/cuda/fused.hpp"
+#include "graphblas/backend/cuda/msbfs.hpp"
+#include "graphblas/backend/cuda/sssp.hpp"
+#include "graphblas/backend/cuda/pr.hpp"
+#include "graphblas/backend/cuda/ppr.hpp"
+#include "graphblas/backend/cuda/cc.hpp"
+#include "graphblas/backend/cuda/mis.hpp"
+#include "graphblas/backend/cuda/bc.hpp"
+#include "graphblas/backend/cuda/kcore.hpp"
+#include "graphblas/backend/cuda/truss.hpp"
+#include "graphblas/backend/cuda/community.hpp"
 #include "graphblas/backend/cuda/descriptor.hpp"
 #include "graphblas/backend/cuda/sparse_vector.hpp"
 #include "graphblas/backend/cuda/dense_vector.hpp"
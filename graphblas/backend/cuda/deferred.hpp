@@ -0,0 +1,379 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_DEFERRED_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_DEFERRED_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+
+#include "graphblas/backend/cuda/kernels/deferred.hpp"
+
+namespace graphblas {
+namespace backend {
+
+template <typename T>
+class DenseVector;
+
+template <typename T>
+class Vector;
+
+// Maps a binary op onto the op code interpreted by the fused kernels.
+// Unlisted ops are always executed eagerly.
+template <typename OpT>
+struct DeferredOp {
+  static const int code = GrB_DEFERRED_NONE;
+};
+
+#define REGISTER_DEFERRED_OP(BINARYOP, CODE)                                  \
+template <typename T_in1, typename T_in2, typename T_out>                     \
+struct DeferredOp<BINARYOP<T_in1, T_in2, T_out> > {                           \
+  static const int code = CODE;                                               \
+};
+
+REGISTER_DEFERRED_OP(plus, GrB_DEFERRED_PLUS)
+REGISTER_DEFERRED_OP(minus, GrB_DEFERRED_MINUS)
+REGISTER_DEFERRED_OP(multiplies, GrB_DEFERRED_MULTIPLIES)
+REGISTER_DEFERRED_OP(divides, GrB_DEFERRED_DIVIDES)
+REGISTER_DEFERRED_OP(minimum, GrB_DEFERRED_MINIMUM)
+REGISTER_DEFERRED_OP(maximum, GrB_DEFERRED_MAXIMUM)
+REGISTER_DEFERRED_OP(first, GrB_DEFERRED_FIRST)
+REGISTER_DEFERRED_OP(second, GrB_DEFERRED_SECOND)
+#undef REGISTER_DEFERRED_OP
+
+inline bool nonblocking() {
+  return getEnv("GRB_EXECUTION_MODE", GrB_BLOCKING) == GrB_NONBLOCKING;
+}
+
+/*!
+ * Element-wise expression DAG recorded in nonblocking mode. Leaves hold
+ * copy-on-write references to their input vectors, so writes to an input
+ * after recording do not change the value of the expression.
+ */
+template <typename T>
+class DeferredExpr {
+ public:
+  DeferredExpr() {
+    prog_.nleaves = 0;
+    prog_.ninstr  = 0;
+  }
+
+  ~DeferredExpr() {
+    for (int leaf = 0; leaf < prog_.nleaves; ++leaf)
+      if (snapshot_[leaf] != NULL)
+        delete snapshot_[leaf];
+  }
+
+  int nleaves() const { return prog_.nleaves; }
+  int ninstr()  const { return prog_.ninstr; }
+
+  // Each method returns the operand naming the value just added
+  int addLeaf(const DenseVector<T>* u);
+  int addLeaf(T val);
+  int merge(const DeferredExpr* rhs);
+  int push(int op, bool annihilate, T identity, int lhs, int rhs);
+
+  Info evaluate(DenseVector<T>* w) const;
+  template <typename BinaryOpT, typename MonoidT>
+  Info reduce(T* val, BinaryOpT accum, MonoidT op, Index nvals,
+              Descriptor* desc) const;
+
+ private:
+  DeferredProgram<T> prog_;
+  DenseVector<T>*    snapshot_[kDeferredMaxLeaves];
+};
+
+template <typename T>
+int DeferredExpr<T>::addLeaf(const DenseVector<T>* u) {
+  for (int leaf = 0; leaf < prog_.nleaves; ++leaf)
+    if (prog_.leaf_val[leaf] == u->d_val_)
+      return leaf;
+
+  int leaf = prog_.nleaves++;
+  snapshot_[leaf] = new DenseVector<T>();
+  snapshot_[leaf]->share(u);
+  prog_.leaf_val[leaf]    = snapshot_[leaf]->d_val_;
+  prog_.leaf_scalar[leaf] = T(0);
+  return leaf;
+}
+
+template <typename T>
+int DeferredExpr<T>::addLeaf(T val) {
+  int leaf = prog_.nleaves++;
+  snapshot_[leaf]         = NULL;
+  prog_.leaf_val[leaf]    = NULL;
+  prog_.leaf_scalar[leaf] = val;
+  return leaf;
+}
+
+// Appends rhs's leaves and instructions, renumbering its operands
+template <typename T>
+int DeferredExpr<T>::merge(const DeferredExpr* rhs) {
+  int leaf_map[kDeferredMaxLeaves];
+  for (int leaf = 0; leaf < rhs->prog_.nleaves; ++leaf) {
+    if (rhs->snapshot_[leaf] != NULL)
+      leaf_map[leaf] = addLeaf(rhs->snapshot_[leaf]);
+    else
+      leaf_map[leaf] = addLeaf(rhs->prog_.leaf_scalar[leaf]);
+  }
+
+  int instr_base = prog_.ninstr;
+  int result     = -1;
+  for (int k = 0; k < rhs->prog_.ninstr; ++k) {
+    DeferredInstr instr = rhs->prog_.instr[k];
+    int lhs = (instr.lhs < kDeferredMaxLeaves) ? leaf_map[instr.lhs] :
+        instr.lhs + instr_base;
+    int rhs_operand = (instr.rhs < kDeferredMaxLeaves) ? leaf_map[instr.rhs] :
+        instr.rhs + instr_base;
+    result = push(instr.op, instr.annihilate, rhs->prog_.identity[k], lhs,
+        rhs_operand);
+  }
+  return result;
+}
+
+template <typename T>
+int DeferredExpr<T>::push(int op, bool annihilate, T identity, int lhs,
+                          int rhs) {
+  int k = prog_.ninstr++;
+  prog_.instr[k].op         = op;
+  prog_.instr[k].lhs        = lhs;
+  prog_.instr[k].rhs        = rhs;
+  prog_.instr[k].annihilate = annihilate;
+  prog_.identity[k]         = identity;
+  return kDeferredMaxLeaves + k;
+}
+
+// Materializes the expression into w in a single pass
+template <typename T>
+Info DeferredExpr<T>::evaluate(DenseVector<T>* w) const {
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = (w->nvals_ + nt - 1) / nt;
+  NB.y = 1;
+  NB.z = 1;
+
+  deferredEvalKernel<<<NB, NT>>>(w->d_val_, prog_, w->nvals_);
+  w->need_update_ = true;
+  return GrB_SUCCESS;
+}
+
+// Reduces the expression without materializing it: each block reduces its
+// share of elements, then the per-block partials are reduced as usual
+template <typename T>
+template <typename BinaryOpT, typename MonoidT>
+Info DeferredExpr<T>::reduce(T*          val,
+                             BinaryOpT   accum,
+                             MonoidT     op,
+                             Index       nvals,
+                             Descriptor* desc) const {
+  if (nvals == 0) {
+    *val = op.identity();
+    return GrB_SUCCESS;
+  }
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = std::min((nvals + nt - 1) / nt, static_cast<Index>(1024));
+  NB.y = 1;
+  NB.z = 1;
+
+  // First element of buffer is left for the output of reduceCommon()
+  CHECK(desc->resize((NB.x + 1)*sizeof(T), "buffer"));
+  T* d_block_val = reinterpret_cast<T*>(desc->d_buffer_) + 1;
+  deferredReduceKernel<nt><<<NB, NT>>>(d_block_val, prog_, op, op.identity(),
+      nvals);
+
+  return reduceCommon(val, accum, op, d_block_val, NB.x, desc);
+}
+
+/*!
+ * Recording entry points used by operations.hpp. They return GrB_SUCCESS if
+ * the call was recorded, and GrB_NOT_IMPLEMENTED if it must run eagerly:
+ * blocking mode, masks, accumulators, mixed types, sparse operands or ops
+ * without an op code.
+ */
+template <typename T>
+bool deferrableInput(const Vector<T>* u) {
+  return u->pending_ != NULL || u->vec_type_ == GrB_DENSE;
+}
+
+template <typename T>
+int deferredCost(const Vector<T>* u, int* nleaves) {
+  if (u->pending_ == NULL) {
+    *nleaves = 1;
+    return 0;
+  }
+  *nleaves = u->pending_->nleaves();
+  return u->pending_->ninstr();
+}
+
+template <typename T>
+int deferredOperand(DeferredExpr<T>* expr, const Vector<T>* u) {
+  if (u->pending_ != NULL)
+    return expr->merge(u->pending_);
+  return expr->addLeaf(&u->dense_);
+}
+
+// Makes sure w = op(u, v) fits in one program, evaluating inputs that have
+// grown too long
+template <typename T>
+Info deferredFit(const Vector<T>* u, const Vector<T>* v) {
+  int u_leaves, v_leaves = 0;
+  int ninstr = deferredCost(u, &u_leaves) + 1;
+  if (v != NULL && v != u)
+    ninstr += deferredCost(v, &v_leaves);
+  if (u_leaves + v_leaves <= kDeferredMaxLeaves &&
+      ninstr <= kDeferredMaxInstr)
+    return GrB_SUCCESS;
+
+  CHECK(const_cast<Vector<T>*>(u)->evaluate());
+  if (v != NULL)
+    CHECK(const_cast<Vector<T>*>(v)->evaluate());
+  return GrB_SUCCESS;
+}
+
+template <typename BinaryOpT>
+bool deferredAccum(BinaryOpT accum) {
+  std::string accum_type = typeid(accum).name();
+  return accum_type.size() > 1;
+}
+
+template <typename W, typename M, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseMult(Vector<W>*       w,
+                    const Vector<M>* mask,
+                    BinaryOpT        accum,
+                    SemiringT        op,
+                    const Vector<U>* u,
+                    const Vector<V>* v,
+                    Descriptor*      desc) {
+  return GrB_NOT_IMPLEMENTED;
+}
+
+template <typename T, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseMult(Vector<T>*       w,
+                    const Vector<M>* mask,
+                    BinaryOpT        accum,
+                    SemiringT        op,
+                    const Vector<T>* u,
+                    const Vector<T>* v,
+                    Descriptor*      desc) {
+  const int code = DeferredOp<typename SemiringT::mul_op_type>::code;
+  if (!nonblocking() || code == GrB_DEFERRED_NONE || mask != NULL ||
+      deferredAccum(accum) || !deferrableInput(u) || !deferrableInput(v))
+    return GrB_NOT_IMPLEMENTED;
+
+  CHECK(deferredFit(u, v));
+  DeferredExpr<T>* expr = new DeferredExpr<T>();
+  int lhs = deferredOperand(expr, u);
+  int rhs = (v == u) ? lhs : deferredOperand(expr, v);
+  expr->push(code, true, op.identity(), lhs, rhs);
+  return w->defer(expr);
+}
+
+template <typename W, typename M, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseAdd(Vector<W>*       w,
+                   const Vector<M>* mask,
+                   BinaryOpT        accum,
+                   SemiringT        op,
+                   const Vector<U>* u,
+                   const Vector<V>* v,
+                   Descriptor*      desc) {
+  return GrB_NOT_IMPLEMENTED;
+}
+
+template <typename T, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseAdd(Vector<T>*       w,
+                   const Vector<M>* mask,
+                   BinaryOpT        accum,
+                   SemiringT        op,
+                   const Vector<T>* u,
+                   const Vector<T>* v,
+                   Descriptor*      desc) {
+  const int code = DeferredOp<typename SemiringT::add_monoid_type::op_type>::
+      code;
+  if (!nonblocking() || code == GrB_DEFERRED_NONE || mask != NULL ||
+      deferredAccum(accum) || !deferrableInput(u) || !deferrableInput(v))
+    return GrB_NOT_IMPLEMENTED;
+
+  CHECK(deferredFit(u, v));
+  DeferredExpr<T>* expr = new DeferredExpr<T>();
+  int lhs = deferredOperand(expr, u);
+  int rhs = (v == u) ? lhs : deferredOperand(expr, v);
+  expr->push(code, false, op.identity(), lhs, rhs);
+  return w->defer(expr);
+}
+
+// Vector-scalar variant: the scalar becomes a broadcast leaf
+template <typename W, typename M, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseAdd(Vector<W>*       w,
+                   const Vector<M>* mask,
+                   BinaryOpT        accum,
+                   SemiringT        op,
+                   const Vector<U>* u,
+                   V                val,
+                   Descriptor*      desc) {
+  return GrB_NOT_IMPLEMENTED;
+}
+
+template <typename T, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info deferEWiseAdd(Vector<T>*       w,
+                   const Vector<M>* mask,
+                   BinaryOpT        accum,
+                   SemiringT        op,
+                   const Vector<T>* u,
+                   T                val,
+                   Descriptor*      desc) {
+  const int code = DeferredOp<typename SemiringT::add_monoid_type::op_type>::
+      code;
+  if (!nonblocking() || code == GrB_DEFERRED_NONE || mask != NULL ||
+      deferredAccum(accum) || !deferrableInput(u))
+    return GrB_NOT_IMPLEMENTED;
+
+  CHECK(deferredFit(u, static_cast<const Vector<T>*>(NULL)));
+  DeferredExpr<T>* expr = new DeferredExpr<T>();
+  int lhs = deferredOperand(expr, u);
+  int rhs = expr->addLeaf(val);
+  expr->push(code, false, op.identity(), lhs, rhs);
+  return w->defer(expr);
+}
+
+// Reduction of a pending vector fuses the whole chain into the reduction
+template <typename T, typename U,
+          typename BinaryOpT, typename MonoidT>
+Info reduceDeferred(T*               val,
+                    BinaryOpT        accum,
+                    MonoidT          op,
+                    const Vector<U>* u,
+                    Descriptor*      desc) {
+  return GrB_NOT_IMPLEMENTED;
+}
+
+template <typename T,
+          typename BinaryOpT, typename MonoidT>
+Info reduceDeferred(T*               val,
+                    BinaryOpT        accum,
+                    MonoidT          op,
+                    const Vector<T>* u,
+                    Descriptor*      desc) {
+  if (u->pending_ == NULL)
+    return GrB_NOT_IMPLEMENTED;
+  if (desc->debug())
+    std::cout << "Fused reduce of " << u->pending_->ninstr() <<
+        " deferred ops\n";
+  return u->pending_->reduce(val, accum, op, u->dense_.nvals_, desc);
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_DEFERRED_HPP_
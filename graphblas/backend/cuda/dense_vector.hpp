@@ -4,6 +4,7 @@
 #include <cuda.h>
 #include <cuda_runtime.h>
 
+#include <cstdint>
 #include <vector>
 #include <iostream>
 #include <unordered_set>
@@ -22,10 +23,14 @@ template <typename T>
 class DenseVector {
  public:
   DenseVector()
-      : nvals_(0), nnz_(0), h_val_(NULL), d_val_(NULL), need_update_(0) {}
+      : nvals_(0), nnz_(0), h_val_(NULL), d_val_(NULL), need_update_(0),
+        ref_count_(NULL), h_bits_(NULL), bits_valid_(false),
+        bits_exact_(false) {}
 
   explicit DenseVector(Index nsize)
-      : nvals_(nsize), nnz_(0), h_val_(NULL), d_val_(NULL), need_update_(0) {
+      : nvals_(nsize), nnz_(0), h_val_(NULL), d_val_(NULL), need_update_(0),
+        ref_count_(NULL), h_bits_(NULL), bits_valid_(false),
+        bits_exact_(false) {
     allocate();
   }
 
@@ -71,6 +76,22 @@ class DenseVector {
   Info gpuToCpu(bool force_update = false);
   Info swap(DenseVector* rhs);
 
+  // Copy-on-write sharing: share() aliases rhs's buffers, detach() makes
+  // them private again before a write and release() drops this reference.
+  // detach(false) skips copying when the write overwrites every value.
+  Info share(const DenseVector* rhs);
+  Info detach(bool copy = true);
+  Info release();
+
+  // Packed host mirror of (h_val_ != 0), one bit per element, used by
+  // Boolean CPU kernels. packBits() refreshes it if stale, unpackBits()
+  // writes it back to h_val_ and d_val_, all of it or only a range of words.
+  Info packBits();
+  Info unpackBits();
+  Info unpackBits(Index word_begin, Index word_end);
+  Info countBits(Index* count) const;
+  Info clearBits();
+
  private:
   // Note nsize_ is understood to be the same as nvals_, so it is omitted
   Index nvals_;  // 6 ways to set: (1) Vector (2) nnew (3) dup (4) build
@@ -81,16 +102,25 @@ class DenseVector {
 
   bool  need_update_;  // set to true by changing DenseVector
                        // set to false by gpuToCpu()
+
+  int*  ref_count_;    // number of DenseVectors sharing h_val_ and d_val_
+                       // NULL if buffers are not shared
+
+  uint64_t* h_bits_;     // (nvals_+63)/64 words, bit i set iff h_val_[i] != 0
+  bool      bits_valid_; // set to false whenever h_val_ may have changed
+  bool      bits_exact_; // h_val_ and d_val_ hold exactly the 0/1 values of
+                         // h_bits_, so unchanged words need no write-back
 };
 
 template <typename T>
 DenseVector<T>::~DenseVector() {
-  if (h_val_ != NULL) free(h_val_);
-  if (d_val_ != NULL) CUDA_CALL(cudaFree(d_val_));
+  release();
+  clearBits();
 }
 
 template <typename T>
 Info DenseVector<T>::nnew(Index nsize) {
+  CHECK(clearBits());
   nvals_ = nsize;
   CHECK(allocate());
   return GrB_SUCCESS;
@@ -98,6 +128,9 @@ Info DenseVector<T>::nnew(Index nsize) {
 
 template <typename T>
 Info DenseVector<T>::dup(const DenseVector* rhs) {
+  // Deep copy must not write into buffers still shared with another vector
+  if (ref_count_ != NULL && rhs->d_val_ != d_val_)
+    CHECK(release());
   nvals_ = rhs->nvals_;
 
   if (d_val_ == NULL || h_val_ == NULL)
@@ -203,6 +236,7 @@ Info DenseVector<T>::build(const std::vector<T>* values,
     return GrB_INDEX_OUT_OF_BOUNDS;
   if (d_val_ == NULL || h_val_ == NULL)
     return GrB_UNINITIALIZED_OBJECT;
+  CHECK(detach());
 
   for (Index i = 0; i < nvals; i++)
     h_val_[i] = (*values)[i];
@@ -215,6 +249,8 @@ Info DenseVector<T>::build(const std::vector<T>* values,
 template <typename T>
 Info DenseVector<T>::build(T*    values,
                            Index nvals) {
+  if (ref_count_ != NULL)
+    CHECK(release());
   d_val_       = values;
   nvals_       = nvals;
   need_update_ = true;
@@ -225,6 +261,7 @@ Info DenseVector<T>::build(T*    values,
 
 template <typename T>
 Info DenseVector<T>::setElement(T val, Index index) {
+  CHECK(detach());
   CHECK(gpuToCpu());
   h_val_[index] = val;
   CHECK(cpuToGpu());
@@ -285,14 +322,16 @@ const T& DenseVector<T>::operator[](Index ind) {
 // Copies the val to arrays kresize_ratio x bigger than capacity
 template <typename T>
 Info DenseVector<T>::resize(Index nsize) {
+  CHECK(detach());
   T* h_tempVal = h_val_;
   T* d_tempVal = d_val_;
 
   // Compute how much to copy
   Index to_copy = std::min(nsize, nvals_);
 
+  CHECK(clearBits());
   nvals_ = nsize;
-  h_val_ = reinterpret_cast<T*>(malloc(nvals_*sizeof(T)));
+  h_val_ = reinterpret_cast<T*>(hostAlloc(nvals_*sizeof(T)));
   if (h_tempVal != NULL)
     memcpy(h_val_, h_tempVal, to_copy*sizeof(T));
 
@@ -302,7 +341,7 @@ Info DenseVector<T>::resize(Index nsize) {
         cudaMemcpyDeviceToDevice));
   nvals_ = nsize;
 
-  free(h_tempVal);
+  hostFree(h_tempVal);
   CUDA_CALL(cudaFree(d_tempVal));
 
   return GrB_SUCCESS;
@@ -310,6 +349,7 @@ Info DenseVector<T>::resize(Index nsize) {
 
 template <typename T>
 Info DenseVector<T>::fill(T val) {
+  CHECK(detach());
   for (Index i = 0; i < nvals_; i++ )
     h_val_[i] = val;
 
@@ -319,6 +359,7 @@ Info DenseVector<T>::fill(T val) {
 
 template <typename T>
 Info DenseVector<T>::fillAscending(Index nvals) {
+  CHECK(detach());
   for (Index i = 0; i < nvals_; i++)
     h_val_[i] = i;
 
@@ -350,9 +391,9 @@ Info DenseVector<T>::countUnique(Index* count) {
 
 template <typename T>
 Info DenseVector<T>::allocateCpu() {
-  // Host malloc
+  // Host malloc (huge page backed for large vectors, see hostAlloc())
   if (nvals_ > 0 && h_val_ == NULL) {
-    h_val_ = reinterpret_cast<T*>(malloc(nvals_*sizeof(T)));
+    h_val_ = reinterpret_cast<T*>(hostAlloc(nvals_*sizeof(T)));
   } else {
     // std::cout << "Error: DeVec Host allocation unsuccessful!\n";
   }
@@ -396,15 +437,20 @@ template <typename T>
 Info DenseVector<T>::cpuToGpu() {
   CUDA_CALL(cudaMemcpy(d_val_, h_val_, nvals_*sizeof(T),
       cudaMemcpyHostToDevice));
+  bits_valid_ = false;
+  bits_exact_ = false;
   return GrB_SUCCESS;
 }
 
 // Copies graph to CPU
 template <typename T>
 Info DenseVector<T>::gpuToCpu(bool force_update) {
-  if (need_update_ || force_update)
+  if (need_update_ || force_update) {
     CUDA_CALL(cudaMemcpy(h_val_, d_val_, nvals_*sizeof(T),
         cudaMemcpyDeviceToHost));
+    bits_valid_ = false;
+    bits_exact_ = false;
+  }
   need_update_ = false;
   return GrB_SUCCESS;
 }
@@ -430,6 +476,167 @@ Info DenseVector<T>::swap(DenseVector* rhs) {  // NOLINT(build/include_what_you_
   need_update_      = rhs->need_update_;
   rhs->need_update_ = temp_update;
 
+  int* temp_count   = ref_count_;
+  ref_count_        = rhs->ref_count_;
+  rhs->ref_count_   = temp_count;
+
+  uint64_t* temp_bits = h_bits_;
+  h_bits_             = rhs->h_bits_;
+  rhs->h_bits_        = temp_bits;
+
+  bool temp_valid   = bits_valid_;
+  bits_valid_       = rhs->bits_valid_;
+  rhs->bits_valid_  = temp_valid;
+  bool temp_exact   = bits_exact_;
+  bits_exact_       = rhs->bits_exact_;
+  rhs->bits_exact_  = temp_exact;
+
+  return GrB_SUCCESS;
+}
+
+// O(1) copy: alias rhs's buffers and bump the shared reference count
+template <typename T>
+Info DenseVector<T>::share(const DenseVector* rhs) {
+  if (rhs == this || (rhs->d_val_ == d_val_ && d_val_ != NULL))
+    return GrB_SUCCESS;
+  DenseVector* src = const_cast<DenseVector*>(rhs);
+  if (src->ref_count_ == NULL)
+    src->ref_count_ = new int(1);
+
+  CHECK(release());
+  CHECK(clearBits());
+  nvals_       = src->nvals_;
+  nnz_         = src->nnz_;
+  h_val_       = src->h_val_;
+  d_val_       = src->d_val_;
+  need_update_ = src->need_update_;
+  ref_count_   = src->ref_count_;
+  (*ref_count_)++;
+  return GrB_SUCCESS;
+}
+
+// Give this vector its own copy of the buffers if they are shared
+template <typename T>
+Info DenseVector<T>::detach(bool copy) {
+  if (ref_count_ == NULL)
+    return GrB_SUCCESS;
+  if (*ref_count_ == 1) {
+    delete ref_count_;
+    ref_count_ = NULL;
+    return GrB_SUCCESS;
+  }
+
+  T* h_shared = h_val_;
+  T* d_shared = d_val_;
+  (*ref_count_)--;
+  ref_count_ = NULL;
+  h_val_     = NULL;
+  d_val_     = NULL;
+
+  CHECK(allocate());
+  if (!copy)
+    return GrB_SUCCESS;
+  CUDA_CALL(cudaMemcpy(d_val_, d_shared, nvals_*sizeof(T),
+      cudaMemcpyDeviceToDevice));
+  if (!need_update_)
+    memcpy(h_val_, h_shared, nvals_*sizeof(T));
+  return GrB_SUCCESS;
+}
+
+// Drop this reference, freeing buffers only if no other vector shares them
+template <typename T>
+Info DenseVector<T>::release() {
+  bool last = true;
+  if (ref_count_ != NULL) {
+    last = (--(*ref_count_) == 0);
+    if (last) delete ref_count_;
+    ref_count_ = NULL;
+  }
+
+  if (last) {
+    if (h_val_ != NULL) hostFree(h_val_);
+    if (d_val_ != NULL) CUDA_CALL(cudaFree(d_val_));
+  }
+  h_val_ = NULL;
+  d_val_ = NULL;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info DenseVector<T>::packBits() {
+  CHECK(gpuToCpu());
+  if (bits_valid_)
+    return GrB_SUCCESS;
+
+  Index nwords = (nvals_ + 63) / 64;
+  if (h_bits_ == NULL)
+    h_bits_ = reinterpret_cast<uint64_t*>(hostAlloc(
+        std::max(nwords, 1)*sizeof(uint64_t)));
+
+  #pragma omp parallel for schedule(static)
+  for (Index word = 0; word < nwords; ++word) {
+    Index    start = word*64;
+    Index    end   = std::min(start + 64, nvals_);
+    uint64_t bits  = 0;
+    for (Index i = start; i < end; ++i)
+      if (h_val_[i] != static_cast<T>(0))
+        bits |= static_cast<uint64_t>(1) << (i - start);
+    h_bits_[word] = bits;
+  }
+  bits_valid_ = true;
+  bits_exact_ = false;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info DenseVector<T>::unpackBits() {
+  return unpackBits(0, (nvals_ + 63) / 64);
+}
+
+// Writes words [word_begin, word_end) back. Elements outside them must
+// already hold the 0/1 values of their bits (bits_exact_), since only this
+// range is copied to the device.
+template <typename T>
+Info DenseVector<T>::unpackBits(Index word_begin, Index word_end) {
+  if (h_bits_ == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+  Index begin = word_begin*64;
+  Index end   = std::min(word_end*64, nvals_);
+  CHECK(detach(begin > 0 || end < nvals_));
+  CHECK(allocateCpu());
+
+  #pragma omp parallel for schedule(static)
+  for (Index i = begin; i < end; ++i)
+    h_val_[i] = static_cast<T>((h_bits_[i/64] >> (i % 64)) & 1);
+  if (end > begin)
+    CUDA_CALL(cudaMemcpy(d_val_ + begin, h_val_ + begin,
+        (end - begin)*sizeof(T), cudaMemcpyHostToDevice));
+  need_update_ = false;
+  bits_valid_  = true;
+  bits_exact_  = true;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info DenseVector<T>::countBits(Index* count) const {
+  if (!bits_valid_)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index nwords = (nvals_ + 63) / 64;
+  Index total  = 0;
+  #pragma omp parallel for schedule(static) reduction(+:total)
+  for (Index word = 0; word < nwords; ++word)
+    total += __builtin_popcountll(h_bits_[word]);
+  *count = total;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info DenseVector<T>::clearBits() {
+  if (h_bits_ != NULL) hostFree(h_bits_);
+  h_bits_     = NULL;
+  bits_valid_ = false;
+  bits_exact_ = false;
   return GrB_SUCCESS;
 }
 }  // namespace backend
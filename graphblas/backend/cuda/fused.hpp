@@ -0,0 +1,509 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_FUSED_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_FUSED_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "graphblas/backend/cuda/intersect.hpp"
+#include "graphblas/backend/cuda/kernels/kernels.hpp"
+
+namespace graphblas {
+namespace backend {
+/*!
+ * Fused operations. Each CPU variant (GrB_BACKEND is GrB_SEQUENTIAL) is one
+ * OpenMP loop that touches every element once. GPU variants do the
+ * element-wise and reduction stages in one kernel.
+ */
+
+// *val = accum(*val, total), or total if there is no accum
+template <typename T, typename BinaryOpT>
+void fusedAccumVal(T* val, BinaryOpT accum, T total) {
+  std::string accum_type = typeid(accum).name();
+  ApplyAccum<BinaryOpT> accum_op(accum);
+  *val = (accum_type.size() > 1) ? accum_op(*val, total) : total;
+}
+
+// Grid for a kernel leaving one partial reduction per block. Partials go to
+// d_buffer_+1 so that reduceCommon() can write its result to d_buffer_[0].
+template <typename T>
+Info fusedReduceGrid(Index       nvals,
+                     int         nt,
+                     dim3*       NB,
+                     T**         d_block_val,
+                     Descriptor* desc) {
+  NB->x = std::min((nvals + nt - 1) / nt, static_cast<Index>(1024));
+  NB->y = 1;
+  NB->z = 1;
+  CHECK(desc->resize((NB->x + 1)*sizeof(T), "buffer"));
+  *d_block_val = reinterpret_cast<T*>(desc->d_buffer_) + 1;
+  return GrB_SUCCESS;
+}
+
+// Host values of a dense mask, or NULL if there is no mask
+template <typename M>
+Info fusedMaskCpu(const Vector<M>* mask, const M** mask_val) {
+  *mask_val = NULL;
+  if (mask == NULL)
+    return GrB_SUCCESS;
+
+  Storage mask_vec_type;
+  CHECK(mask->getStorage(&mask_vec_type));
+  if (mask_vec_type != GrB_DENSE) {
+    std::cout << "Error: Sparse mask fused CPU op not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  Vector<M>* mask_t = const_cast<Vector<M>*>(mask);
+  CHECK(mask_t->dense_.gpuToCpu());
+  *mask_val = mask->dense_.h_val_;
+  return GrB_SUCCESS;
+}
+
+// Sparse x sparse vector
+template <typename T, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info eWiseMultReduceInner(T*                     val,
+                          BinaryOpT              accum,
+                          SemiringT              op,
+                          const SparseVector<U>* u,
+                          const SparseVector<V>* v,
+                          Descriptor*            desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: eWiseMultReduce sparse-sparse GPU not implemented "
+        << "yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  SparseVector<U>* u_t = const_cast<SparseVector<U>*>(u);
+  SparseVector<V>* v_t = const_cast<SparseVector<V>*>(v);
+  CHECK(u_t->gpuToCpu());
+  CHECK(v_t->gpuToCpu());
+
+  // Positions of the common indices, then a sequential reduction over them
+  std::vector<Index> u_pos(std::min(u->nvals_, v->nvals_));
+  std::vector<Index> v_pos(u_pos.size());
+  Index nmatch = intersectIndices(u->h_ind_, u->nvals_, v->h_ind_, v->nvals_,
+      u_pos.data(), v_pos.data());
+
+  auto add_op = extractAdd(op);
+  auto mul_op = extractMul(op);
+  T    total  = op.identity();
+  for (Index k = 0; k < nmatch; ++k)
+    total = add_op(total, mul_op(u->h_val_[u_pos[k]], v->h_val_[v_pos[k]]));
+  fusedAccumVal(val, accum, total);
+  return GrB_SUCCESS;
+}
+
+// Dense x dense vector
+template <typename T, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info eWiseMultReduceInner(T*                    val,
+                          BinaryOpT             accum,
+                          SemiringT             op,
+                          const DenseVector<U>* u,
+                          const DenseVector<V>* v,
+                          Descriptor*           desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+
+  Index u_nvals;
+  CHECK(u->nvals(&u_nvals));
+  auto add_op   = extractAdd(op);
+  auto mul_op   = extractMul(op);
+  T    identity = op.identity();
+
+  if (desc->debug())
+    std::cout << "Executing eWiseMultReduce dense-dense\n";
+
+  if (backend == GrB_SEQUENTIAL) {
+    DenseVector<U>* u_t = const_cast<DenseVector<U>*>(u);
+    DenseVector<V>* v_t = const_cast<DenseVector<V>*>(v);
+    CHECK(u_t->gpuToCpu());
+    CHECK(v_t->gpuToCpu());
+    const U* u_val = u->h_val_;
+    const V* v_val = v->h_val_;
+
+    T total = identity;
+    #pragma omp parallel
+    {
+      T partial = identity;
+      #pragma omp for schedule(static)
+      for (Index row = 0; row < u_nvals; ++row) {
+        U u_t = u_val[row];
+        V v_t = v_val[row];
+        if (u_t != identity && v_t != identity)
+          partial = add_op(partial, mul_op(u_t, v_t));
+      }
+      #pragma omp critical
+      total = add_op(total, partial);
+    }
+    fusedAccumVal(val, accum, total);
+    return GrB_SUCCESS;
+  }
+
+  if (u_nvals == 0) {
+    fusedAccumVal(val, accum, identity);
+    return GrB_SUCCESS;
+  }
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  T* d_block_val;
+  CHECK(fusedReduceGrid(u_nvals, nt, &NB, &d_block_val, desc));
+
+  eWiseMultReduceKernel<nt><<<NB, NT>>>(d_block_val, identity, mul_op,
+      add_op, u->d_val_, v->d_val_, u_nvals);
+  T total;
+  CHECK(reduceCommon(&total, accum, typename SemiringT::add_monoid_type(),
+      d_block_val, NB.x, desc));
+  fusedAccumVal(val, accum, total);
+  return GrB_SUCCESS;
+}
+
+// Sparse x dense vector (reverse when dense x sparse)
+template <typename T, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info eWiseMultReduceInner(T*                     val,
+                          BinaryOpT              accum,
+                          SemiringT              op,
+                          const SparseVector<U>* u,
+                          const DenseVector<V>*  v,
+                          bool                   reverse,
+                          Descriptor*            desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+
+  Index u_nvals;
+  CHECK(u->nvals(&u_nvals));
+  auto add_op   = extractAdd(op);
+  auto mul_op   = extractMul(op);
+  T    identity = op.identity();
+
+  if (desc->debug())
+    std::cout << "Executing eWiseMultReduce sparse-dense\n";
+
+  if (backend == GrB_SEQUENTIAL) {
+    SparseVector<U>* u_t = const_cast<SparseVector<U>*>(u);
+    DenseVector<V>*  v_t = const_cast<DenseVector<V>*>(v);
+    CHECK(u_t->gpuToCpu());
+    CHECK(v_t->gpuToCpu());
+    const Index* u_ind = u->h_ind_;
+    const U*     u_val = u->h_val_;
+    const V*     v_val = v->h_val_;
+
+    T total = identity;
+    #pragma omp parallel
+    {
+      T partial = identity;
+      #pragma omp for schedule(static)
+      for (Index row = 0; row < u_nvals; ++row) {
+        U u_t = u_val[row];
+        if (u_t != identity) {
+          V v_t = v_val[u_ind[row]];
+          partial = add_op(partial,
+              (reverse) ? mul_op(v_t, u_t) : mul_op(u_t, v_t));
+        }
+      }
+      #pragma omp critical
+      total = add_op(total, partial);
+    }
+    fusedAccumVal(val, accum, total);
+    return GrB_SUCCESS;
+  }
+
+  if (u_nvals == 0) {
+    fusedAccumVal(val, accum, identity);
+    return GrB_SUCCESS;
+  }
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  T* d_block_val;
+  CHECK(fusedReduceGrid(u_nvals, nt, &NB, &d_block_val, desc));
+
+  eWiseMultReduceKernel<nt><<<NB, NT>>>(d_block_val, identity, mul_op,
+      add_op, u->d_ind_, u->d_val_, u_nvals, v->d_val_, reverse);
+  T total;
+  CHECK(reduceCommon(&total, accum, typename SemiringT::add_monoid_type(),
+      d_block_val, NB.x, desc));
+  fusedAccumVal(val, accum, total);
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Gets u, A and w ready for a fused CPU vxm. Returns GrB_NOT_IMPLEMENTED when
+ * the CPU row loop cannot be used (not GrB_SEQUENTIAL, dense A, or A^T not
+ * available), in which case callers compose existing GPU ops instead.
+ */
+template <typename W, typename U, typename a, typename SemiringT>
+Info vxmCpuPrepare(Vector<W>*       w,
+                   SemiringT        op,
+                   const Vector<U>* u,
+                   const Matrix<a>* A,
+                   bool*            use_tran,
+                   Descriptor*      desc) {
+  Desc_value backend, inp1_mode;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  if (backend != GrB_SEQUENTIAL)
+    return GrB_NOT_IMPLEMENTED;
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE)
+    return GrB_NOT_IMPLEMENTED;
+  if (!A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY)
+    return GrB_NOT_IMPLEMENTED;
+
+  // CPU row loop is always pull, so it needs u dense
+  Vector<U>* u_t = const_cast<Vector<U>*>(u);
+  Storage u_vec_type;
+  CHECK(u->getStorage(&u_vec_type));
+  if (u_vec_type == GrB_SPARSE)
+    CHECK(u_t->sparse2dense(op.identity(), desc));
+
+  Storage w_vec_type;
+  CHECK(w->getStorage(&w_vec_type));
+  if (w_vec_type == GrB_SPARSE)
+    CHECK(w->sparse2dense(op.identity(), desc));
+  else if (w_vec_type == GrB_UNKNOWN)
+    CHECK(w->fill(op.identity()));
+
+  // vxm is mxv with A^T
+  *use_tran = (inp1_mode != GrB_TRAN);
+  CHECK(spmvCpuSetup(&A->sparse_));
+  return GrB_SUCCESS;
+}
+
+/*!
+ * w = w + mask .* (u * A) and val = reduce(w) in one pass over the rows of
+ * A^T. Each row of w is reduced as soon as it is written. Masked-out rows
+ * keep their old value, or become the identity of op under GrB_REPLACE.
+ */
+template <typename W, typename T, typename U, typename a, typename M,
+          typename BinaryOpT, typename MonoidT, typename SemiringT>
+Info vxmReduceCpu(DenseVector<W>*        w,
+                  T*                     val,
+                  const Vector<M>*       mask,
+                  BinaryOpT              accum,
+                  MonoidT                reduce_op,
+                  SemiringT              op,
+                  const DenseVector<U>*  u,
+                  const SparseMatrix<a>* A,
+                  bool                   use_tran,
+                  Descriptor*            desc) {
+  Desc_value scmp_mode, repl_mode;
+  CHECK(desc->get(GrB_MASK, &scmp_mode));
+  CHECK(desc->get(GrB_OUTP, &repl_mode));
+  std::string accum_type = typeid(accum).name();
+  bool use_accum = (accum_type.size() > 1);
+  bool use_scmp  = (scmp_mode == GrB_SCMP);
+  bool use_repl  = (repl_mode == GrB_REPLACE);
+
+  const M* mask_val;
+  CHECK(fusedMaskCpu(mask, &mask_val));
+  DenseVector<U>* u_t = const_cast<DenseVector<U>*>(u);
+  CHECK(u_t->gpuToCpu());
+  CHECK(w->gpuToCpu());
+
+  const Index A_nrows = (use_tran) ? A->ncols_ : A->nrows_;
+  const U*    u_val   = u->h_val_;
+  W*          w_val   = w->h_val_;
+  auto        add_op  = extractAdd(op);
+  auto        mul_op  = extractMul(op);
+  ApplyAccum<BinaryOpT> accum_op(accum);
+
+  T total = reduce_op.identity();
+  #pragma omp parallel
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+    T partial = reduce_op.identity();
+    #pragma omp for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      bool allowed = true;
+      if (mask_val != NULL)
+        allowed = use_scmp ? (mask_val[row] == 0) : (mask_val[row] != 0);
+
+      if (allowed) {
+        W row_val = op.identity();
+        for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j)
+          row_val = add_op(row_val, mul_op(A_csrVal[j],
+              u_val[A_csrColInd[j]]));
+        w_val[row] = (use_accum) ? accum_op(w_val[row], row_val) : row_val;
+      } else if (use_repl) {
+        w_val[row] = op.identity();
+      }
+      partial = reduce_op(partial, w_val[row]);
+    }
+    #pragma omp critical
+    total = reduce_op(total, partial);
+  }
+  *val = total;
+  w->nvals_ = A_nrows;
+  CHECK(w->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Relaxation in one pass over the rows of A^T:
+ *   w = w + mask .* (u * A)
+ *   changed[i] = w[i] if w[i] was changed by this op, identity otherwise
+ * Masked-out rows keep their old value, or become the identity of op under
+ * GrB_REPLACE. Clearing a row does not count as a change.
+ */
+template <typename W, typename U, typename a, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info vxmAccumMaskCpu(DenseVector<W>*        w,
+                     DenseVector<W>*        changed,
+                     Index*                 nchanged,
+                     const Vector<M>*       mask,
+                     BinaryOpT              accum,
+                     SemiringT              op,
+                     const DenseVector<U>*  u,
+                     const SparseMatrix<a>* A,
+                     bool                   use_tran,
+                     Descriptor*            desc) {
+  Desc_value scmp_mode, repl_mode;
+  CHECK(desc->get(GrB_MASK, &scmp_mode));
+  CHECK(desc->get(GrB_OUTP, &repl_mode));
+  std::string accum_type = typeid(accum).name();
+  bool use_accum = (accum_type.size() > 1);
+  bool use_scmp  = (scmp_mode == GrB_SCMP);
+  bool use_repl  = (repl_mode == GrB_REPLACE);
+
+  const M* mask_val;
+  CHECK(fusedMaskCpu(mask, &mask_val));
+  DenseVector<U>* u_t = const_cast<DenseVector<U>*>(u);
+  CHECK(u_t->gpuToCpu());
+  CHECK(w->gpuToCpu());
+  CHECK(changed->allocateCpu());
+
+  const Index A_nrows     = (use_tran) ? A->ncols_ : A->nrows_;
+  const U*    u_val       = u->h_val_;
+  W*          w_val       = w->h_val_;
+  W*          changed_val = changed->h_val_;
+  auto        add_op      = extractAdd(op);
+  auto        mul_op      = extractMul(op);
+  ApplyAccum<BinaryOpT> accum_op(accum);
+
+  Index count = 0;
+  #pragma omp parallel reduction(+:count)
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+    #pragma omp for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      bool allowed = true;
+      if (mask_val != NULL)
+        allowed = use_scmp ? (mask_val[row] == 0) : (mask_val[row] != 0);
+
+      W w_old = w_val[row];
+      W w_new = w_old;
+      if (allowed) {
+        W row_val = op.identity();
+        for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j)
+          row_val = add_op(row_val, mul_op(A_csrVal[j],
+              u_val[A_csrColInd[j]]));
+        w_new = (use_accum) ? accum_op(w_old, row_val) : row_val;
+      } else if (use_repl) {
+        w_val[row]       = op.identity();
+        changed_val[row] = op.identity();
+        continue;
+      }
+
+      if (w_new != w_old) {
+        w_val[row]       = w_new;
+        changed_val[row] = w_new;
+        count++;
+      } else {
+        changed_val[row] = op.identity();
+      }
+    }
+  }
+  *nchanged = count;
+  w->nvals_       = A_nrows;
+  changed->nvals_ = A_nrows;
+  CHECK(w->cpuToGpu());
+  CHECK(changed->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+/*!
+ * GPU epilogue of vxmAccumMask. t holds mask .* (u * A) on entry and the
+ * changed set on exit.
+ */
+template <typename W, typename M, typename BinaryOpT, typename SemiringT>
+Info accumChangedInner(DenseVector<W>*  w,
+                       DenseVector<W>*  t,
+                       Index*           nchanged,
+                       const Vector<M>* mask,
+                       BinaryOpT        accum,
+                       SemiringT        op,
+                       Descriptor*      desc) {
+  Desc_value scmp_mode, repl_mode;
+  CHECK(desc->get(GrB_MASK, &scmp_mode));
+  CHECK(desc->get(GrB_OUTP, &repl_mode));
+  std::string accum_type = typeid(accum).name();
+  bool use_accum = (accum_type.size() > 1);
+  bool use_scmp  = (scmp_mode == GrB_SCMP);
+  bool use_repl  = (repl_mode == GrB_REPLACE);
+
+  const M* mask_val = NULL;
+  if (mask != NULL) {
+    Storage mask_vec_type;
+    CHECK(mask->getStorage(&mask_vec_type));
+    if (mask_vec_type != GrB_DENSE) {
+      std::cout << "Error: Sparse mask vxmAccumMask not implemented yet!\n";
+      return GrB_NOT_IMPLEMENTED;
+    }
+    mask_val = mask->dense_.d_val_;
+  }
+
+  Index w_nvals;
+  CHECK(w->nvals(&w_nvals));
+  CHECK(desc->resize(sizeof(Index), "buffer"));
+  Index* d_nchanged = reinterpret_cast<Index*>(desc->d_buffer_);
+  CUDA_CALL(cudaMemset(d_nchanged, 0, sizeof(Index)));
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = std::min((w_nvals + nt - 1) / nt, static_cast<Index>(1024));
+  NB.y = 1;
+  NB.z = 1;
+
+  accumChangedKernel<nt><<<NB, NT>>>(w->d_val_, t->d_val_, d_nchanged,
+      mask_val, use_scmp, use_accum, use_repl, ApplyAccum<BinaryOpT>(accum),
+      op.identity(), w_nvals);
+  CUDA_CALL(cudaMemcpy(nchanged, d_nchanged, sizeof(Index),
+      cudaMemcpyDeviceToHost));
+  w->need_update_ = true;
+  t->need_update_ = true;
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_FUSED_HPP_
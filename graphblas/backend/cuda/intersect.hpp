@@ -0,0 +1,310 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_INTERSECT_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_INTERSECT_HPP_
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+/*!
+ * Sorted-set intersection on the host, shared by triangle counting, sparse
+ * dot products and anything else that matches two sorted index lists. Lists
+ * must be sorted and free of duplicates.
+ *
+ * intersect() picks a strategy from the list lengths:
+ *   - galloping (exponential search of the shorter list's elements in the
+ *     longer one) once one list is kIntersectGallopRatio times longer
+ *   - SIMD block compare when the host compiler targets AVX-512F or AVX2
+ *     (e.g. -march=native): a block of a is compared against every rotation
+ *     of a block of b, and the block with the smaller last element advances
+ *   - branchless scalar merge otherwise, and for the tails
+ *
+ * For hubs that meet many lists, IntersectBitmap marks one list once and
+ * then probes each other list against it in O(length).
+ *
+ * Matches go to an emit functor called as emit(index, a_pos, b_pos). Counting
+ * functors set kEmit to false, so SIMD blocks only popcount their matches.
+ */
+
+// Length ratio above which the shorter list gallops through the longer one
+const Index kIntersectGallopRatio = 32;
+
+// Length above which TC marks a row in a bitmap and probes the others
+const Index kIntersectHubDegree = 512;
+
+// Count-only mode
+struct IntersectCount {
+  static const bool kEmit = false;
+  void operator()(Index index, Index a_pos, Index b_pos) {}
+};
+
+// Emit-indices mode: positions of each match in a and in b. Either array
+// may be NULL.
+struct IntersectIndices {
+  static const bool kEmit = true;
+  Index* a_ind;
+  Index* b_ind;
+  Index  n;
+  void operator()(Index index, Index a_pos, Index b_pos) {
+    if (a_ind != NULL) a_ind[n] = a_pos;
+    if (b_ind != NULL) b_ind[n] = b_pos;
+    n++;
+  }
+};
+
+// Emit-values mode: each common index with op(a_val, b_val)
+template <typename c, typename a, typename b, typename BinaryOpT>
+struct IntersectValues {
+  static const bool kEmit = true;
+  const a*  a_val;
+  const b*  b_val;
+  Index*    c_ind;
+  c*        c_val;
+  BinaryOpT op;
+  Index     n;
+  void operator()(Index index, Index a_pos, Index b_pos) {
+    c_ind[n] = index;
+    c_val[n] = op(a_val[a_pos], b_val[b_pos]);
+    n++;
+  }
+};
+
+// Branchless merge of a[i, na) and b[j, nb)
+template <typename EmitT>
+inline Index intersectMerge(const Index* a, Index i, Index na,
+                            const Index* b, Index j, Index nb,
+                            EmitT* emit) {
+  Index count = 0;
+  while (i < na && j < nb) {
+    Index a_t = a[i];
+    Index b_t = b[j];
+    if (EmitT::kEmit && a_t == b_t)
+      (*emit)(a_t, i, j);
+    count += (a_t == b_t);
+    i += (a_t <= b_t);
+    j += (b_t <= a_t);
+  }
+  return count;
+}
+
+// Galloping: each element of the short list s is found in the long list l
+// by exponential then binary search from the last match. swap says s is b.
+template <typename EmitT>
+inline Index intersectGallop(const Index* s, Index ns,
+                             const Index* l, Index nl,
+                             bool swap, EmitT* emit) {
+  Index count = 0;
+  Index pos   = 0;
+  for (Index i = 0; i < ns && pos < nl; ++i) {
+    Index target = s[i];
+    Index step   = 1;
+    Index lo     = pos;
+    while (pos + step < nl && l[pos + step] < target) {
+      lo    = pos + step;
+      step *= 2;
+    }
+    pos = std::lower_bound(l + lo, l + std::min(nl, pos + step + 1), target) -
+        l;
+    if (pos < nl && l[pos] == target) {
+      if (EmitT::kEmit) {
+        if (swap)
+          (*emit)(target, pos, i);
+        else
+          (*emit)(target, i, pos);
+      }
+      count++;
+      pos++;
+    }
+  }
+  return count;
+}
+
+#if defined(__AVX512F__)
+const Index kIntersectBlock = 16;
+
+// 16 x 16 block compare
+template <typename EmitT>
+inline Index intersectSimd(const Index* a, Index na,
+                           const Index* b, Index nb,
+                           EmitT* emit) {
+  const __m512i iota = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+      12, 13, 14, 15);
+  const __m512i wrap = _mm512_set1_epi32(15);
+  Index count = 0;
+  Index i = 0;
+  Index j = 0;
+  while (i + 16 <= na && j + 16 <= nb) {
+    __m512i   a_v  = _mm512_loadu_si512(a + i);
+    __m512i   b_v  = _mm512_loadu_si512(b + j);
+    __mmask16 mask = _mm512_cmpeq_epi32_mask(a_v, b_v);
+    for (int r = 1; r < 16; ++r) {
+      __m512i rot = _mm512_and_si512(_mm512_add_epi32(iota,
+          _mm512_set1_epi32(r)), wrap);
+      mask |= _mm512_cmpeq_epi32_mask(a_v, _mm512_permutexvar_epi32(rot,
+          b_v));
+    }
+    if (EmitT::kEmit) {
+      for (unsigned bits = mask; bits; bits &= bits - 1) {
+        Index a_pos = i + __builtin_ctz(bits);
+        __mmask16 b_mask = _mm512_cmpeq_epi32_mask(_mm512_set1_epi32(
+            a[a_pos]), b_v);
+        (*emit)(a[a_pos], a_pos, j + __builtin_ctz(b_mask));
+      }
+    }
+    count += __builtin_popcount(mask);
+    Index a_max = a[i + 15];
+    Index b_max = b[j + 15];
+    i += (a_max <= b_max) ? 16 : 0;
+    j += (b_max <= a_max) ? 16 : 0;
+  }
+  return count + intersectMerge(a, i, na, b, j, nb, emit);
+}
+#elif defined(__AVX2__)
+const Index kIntersectBlock = 8;
+
+// 8 x 8 block compare
+template <typename EmitT>
+inline Index intersectSimd(const Index* a, Index na,
+                           const Index* b, Index nb,
+                           EmitT* emit) {
+  const __m256i rot = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  Index count = 0;
+  Index i = 0;
+  Index j = 0;
+  while (i + 8 <= na && j + 8 <= nb) {
+    __m256i a_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i b_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+    __m256i b_r = b_v;
+    __m256i eq  = _mm256_cmpeq_epi32(a_v, b_r);
+    for (int r = 1; r < 8; ++r) {
+      b_r = _mm256_permutevar8x32_epi32(b_r, rot);
+      eq  = _mm256_or_si256(eq, _mm256_cmpeq_epi32(a_v, b_r));
+    }
+    unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+    if (EmitT::kEmit) {
+      for (unsigned bits = mask; bits; bits &= bits - 1) {
+        Index    a_pos  = i + __builtin_ctz(bits);
+        unsigned b_mask = _mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(_mm256_set1_epi32(a[a_pos]), b_v)));
+        (*emit)(a[a_pos], a_pos, j + __builtin_ctz(b_mask));
+      }
+    }
+    count += __builtin_popcount(mask);
+    Index a_max = a[i + 7];
+    Index b_max = b[j + 7];
+    i += (a_max <= b_max) ? 8 : 0;
+    j += (b_max <= a_max) ? 8 : 0;
+  }
+  return count + intersectMerge(a, i, na, b, j, nb, emit);
+}
+#else
+const Index kIntersectBlock = 0;
+
+template <typename EmitT>
+inline Index intersectSimd(const Index* a, Index na,
+                           const Index* b, Index nb,
+                           EmitT* emit) {
+  return intersectMerge(a, 0, na, b, 0, nb, emit);
+}
+#endif
+
+// Intersects a[0, na) with b[0, nb), choosing the strategy from the lengths.
+// Returns the number of matches.
+template <typename EmitT>
+inline Index intersect(const Index* a, Index na,
+                       const Index* b, Index nb,
+                       EmitT* emit) {
+  if (na == 0 || nb == 0 || a[0] > b[nb-1] || b[0] > a[na-1])
+    return 0;
+  if (na > kIntersectGallopRatio*nb)
+    return intersectGallop(b, nb, a, na, true, emit);
+  if (nb > kIntersectGallopRatio*na)
+    return intersectGallop(a, na, b, nb, false, emit);
+  if (kIntersectBlock > 0 && na >= kIntersectBlock && nb >= kIntersectBlock)
+    return intersectSimd(a, na, b, nb, emit);
+  return intersectMerge(a, 0, na, b, 0, nb, emit);
+}
+
+inline Index intersectCount(const Index* a, Index na,
+                            const Index* b, Index nb) {
+  IntersectCount emit;
+  return intersect(a, na, b, nb, &emit);
+}
+
+// Writes the positions of the matches in a and in b (either may be NULL)
+inline Index intersectIndices(const Index* a, Index na,
+                              const Index* b, Index nb,
+                              Index*       a_ind,
+                              Index*       b_ind) {
+  IntersectIndices emit = {a_ind, b_ind, 0};
+  return intersect(a, na, b, nb, &emit);
+}
+
+// Writes each common index to c_ind and op(a_val, b_val) to c_val
+template <typename c, typename a, typename b, typename BinaryOpT>
+inline Index intersectValues(const Index* a_ind, const a* a_val, Index na,
+                             const Index* b_ind, const b* b_val, Index nb,
+                             Index*       c_ind,
+                             c*           c_val,
+                             BinaryOpT    op) {
+  IntersectValues<c, a, b, BinaryOpT> emit = {a_val, b_val, c_ind, c_val, op,
+      0};
+  return intersect(a_ind, na, b_ind, nb, &emit);
+}
+
+/*!
+ * Bitmap of one list (a hub) over [0, n), with the number of set bits
+ * before each word so a probe also recovers the position in the list.
+ * set() and unset() only touch the words of the list, so one bitmap per
+ * thread can be reused for every hub.
+ */
+class IntersectBitmap {
+ public:
+  explicit IntersectBitmap(Index n)
+      : words_((n + 63) / 64, 0), rank_((n + 63) / 64, 0) {}
+
+  void set(const Index* a, Index na) {
+    for (Index i = 0; i < na; ++i)
+      words_[a[i] >> 6] |= static_cast<uint64_t>(1) << (a[i] & 63);
+    // List is sorted, so words are visited in order
+    for (Index i = 0; i < na; ++i) {
+      Index word = a[i] >> 6;
+      if (i == 0 || (a[i-1] >> 6) != word)
+        rank_[word] = i;
+    }
+  }
+
+  void unset(const Index* a, Index na) {
+    for (Index i = 0; i < na; ++i)
+      words_[a[i] >> 6] = 0;
+  }
+
+  // Probes b against the marked list a
+  template <typename EmitT>
+  Index probe(const Index* b, Index nb, EmitT* emit) const {
+    Index count = 0;
+    for (Index j = 0; j < nb; ++j) {
+      uint64_t word  = words_[b[j] >> 6];
+      uint64_t bit   = static_cast<uint64_t>(1) << (b[j] & 63);
+      bool     match = (word & bit) != 0;
+      if (EmitT::kEmit && match)
+        (*emit)(b[j], rank_[b[j] >> 6] + __builtin_popcountll(word &
+            (bit - 1)), j);
+      count += match;
+    }
+    return count;
+  }
+
+ private:
+  std::vector<uint64_t> words_;
+  std::vector<Index>    rank_;
+};
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_INTERSECT_HPP_
@@ -0,0 +1,135 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KCORE_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KCORE_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Lowers the degree of u by one unless it is already at most k. Returns the
+// degree before the decrement, or k if none happened.
+inline Index kcoreDecrement(Index* degree, Index u, Index k) {
+  Index d = __atomic_load_n(&degree[u], __ATOMIC_RELAXED);
+  while (d > k) {
+    if (__atomic_compare_exchange_n(&degree[u], &d, d - 1, false,
+        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      return d;
+  }
+  return k;
+}
+
+/*!
+ * k-core decomposition by parallel bucket peeling (Dhulipala, Blelloch,
+ * Shun, Julienne, SPAA 2017). Vertices sit in the bucket of their current
+ * degree, and bucket k is peeled in rounds:
+ *   1) every vertex of the round gets core number k, and each neighbour of
+ *      degree above k is decremented atomically, never below k
+ *   2) each neighbour that moved is re-bucketed once per round, at its new
+ *      degree, and those that reached k form the next round
+ * Stale entries (vertices that moved on or were peeled) are dropped when a
+ * bucket is opened, so the work is O(n + nvals) plus the largest degree.
+ * degree holds the degree of each vertex. The pattern of A must be
+ * symmetric. v(i) gets the core number of i.
+ */
+template <typename T, typename a, typename U>
+Info kcorePeelCpu(DenseVector<T>*        v,
+                  const SparseMatrix<a>* A,
+                  const DenseVector<U>*  degree,
+                  Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+  CHECK(const_cast<DenseVector<U>*>(degree)->gpuToCpu());
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  std::vector<Index> deg(A_nrows);
+  Index max_degree = 0;
+  #pragma omp parallel for reduction(max:max_degree)
+  for (Index i = 0; i < A_nrows; ++i) {
+    deg[i]     = static_cast<Index>(degree->h_val_[i]);
+    max_degree = std::max(max_degree, deg[i]);
+  }
+  Index* deg_val = deg.data();
+
+  std::vector<std::vector<Index> > bucket(max_degree + 1);
+  for (Index i = 0; i < A_nrows; ++i)
+    bucket[deg[i]].push_back(i);
+
+  std::vector<char>  peeled(A_nrows, 0);
+  std::vector<Index> stamp(A_nrows, -1);
+  std::vector<Index> frontier;
+  std::vector<Index> moved;
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > moved_t(nthreads);
+
+  T*    v_val     = v->h_val_;
+  Index remaining = A_nrows;
+  Index round     = 0;
+  long long edges = 0;
+  for (Index k = 0; k <= max_degree && remaining > 0; ++k) {
+    // Open bucket k
+    frontier.clear();
+    for (Index idx = 0; idx < bucket[k].size(); ++idx) {
+      Index u = bucket[k][idx];
+      if (!peeled[u] && deg[u] == k) {
+        peeled[u] = 1;
+        frontier.push_back(u);
+      }
+    }
+    std::vector<Index>().swap(bucket[k]);
+
+    while (!frontier.empty()) {
+      remaining -= frontier.size();
+
+      // 1) Peel the round
+      #pragma omp parallel reduction(+:edges)
+      {
+        const int tid = threadId();
+        #pragma omp for schedule(dynamic, 64)
+        for (Index idx = 0; idx < frontier.size(); ++idx) {
+          Index u  = frontier[idx];
+          v_val[u] = static_cast<T>(k);
+          for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+            Index w = A_csrColInd[j];
+            if (kcoreDecrement(deg_val, w, k) > k &&
+                __atomic_exchange_n(&stamp[w], round, __ATOMIC_RELAXED) !=
+                round)
+              moved_t[tid].push_back(w);
+          }
+          edges += A_csrRowPtr[u+1] - A_csrRowPtr[u];
+        }
+      }
+
+      // 2) Re-bucket the neighbours that moved
+      frontier.clear();
+      for (int t = 0; t < nthreads; ++t) {
+        for (Index idx = 0; idx < moved_t[t].size(); ++idx) {
+          Index w = moved_t[t][idx];
+          if (deg[w] == k) {
+            peeled[w] = 1;
+            frontier.push_back(w);
+          } else {
+            bucket[deg[w]].push_back(w);
+          }
+        }
+        moved_t[t].clear();
+      }
+      round++;
+    }
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "kcore, " << round << " rounds, " << edges
+        << " edges read\n";
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KCORE_HPP_
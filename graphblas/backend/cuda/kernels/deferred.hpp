@@ -0,0 +1,115 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_DEFERRED_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_DEFERRED_HPP_
+
+#include <cub.cuh>
+
+namespace graphblas {
+namespace backend {
+
+// Binary ops that can be recorded in nonblocking mode
+enum DeferredOpCode {
+  GrB_DEFERRED_NONE,
+  GrB_DEFERRED_PLUS,
+  GrB_DEFERRED_MINUS,
+  GrB_DEFERRED_MULTIPLIES,
+  GrB_DEFERRED_DIVIDES,
+  GrB_DEFERRED_MINIMUM,
+  GrB_DEFERRED_MAXIMUM,
+  GrB_DEFERRED_FIRST,
+  GrB_DEFERRED_SECOND
+};
+
+const int kDeferredMaxLeaves = 8;
+const int kDeferredMaxInstr  = 8;
+
+// Operands < kDeferredMaxLeaves name a leaf, others name the result of
+// instruction (operand - kDeferredMaxLeaves)
+struct DeferredInstr {
+  int  op;
+  int  lhs;
+  int  rhs;
+  bool annihilate;  // eWiseMult semantics: identity in, identity out
+};
+
+// Element-wise program passed to kernels by value. A leaf is either a dense
+// vector (leaf_val) or a broadcast scalar (leaf_scalar when leaf_val NULL).
+template <typename T>
+struct DeferredProgram {
+  const T*      leaf_val[kDeferredMaxLeaves];
+  T             leaf_scalar[kDeferredMaxLeaves];
+  T             identity[kDeferredMaxInstr];
+  DeferredInstr instr[kDeferredMaxInstr];
+  int           nleaves;
+  int           ninstr;
+};
+
+template <typename T>
+__device__ inline T deferredApply(int op, T lhs, T rhs) {
+  switch (op) {
+    case GrB_DEFERRED_PLUS:       return lhs + rhs;
+    case GrB_DEFERRED_MINUS:      return lhs - rhs;
+    case GrB_DEFERRED_MULTIPLIES: return lhs * rhs;
+    case GrB_DEFERRED_DIVIDES:    return lhs / rhs;
+    case GrB_DEFERRED_MINIMUM:    return min(lhs, rhs);
+    case GrB_DEFERRED_MAXIMUM:    return max(lhs, rhs);
+    case GrB_DEFERRED_FIRST:      return lhs;
+    case GrB_DEFERRED_SECOND:     return rhs;
+  }
+  return lhs;
+}
+
+// Evaluates the whole program for one element, keeping every intermediate in
+// registers
+template <typename T>
+__device__ inline T deferredEval(const DeferredProgram<T>& prog, Index row) {
+  T reg[kDeferredMaxLeaves + kDeferredMaxInstr];
+  for (int leaf = 0; leaf < prog.nleaves; ++leaf)
+    reg[leaf] = (prog.leaf_val[leaf] != NULL) ? prog.leaf_val[leaf][row] :
+        prog.leaf_scalar[leaf];
+
+  for (int k = 0; k < prog.ninstr; ++k) {
+    DeferredInstr instr = prog.instr[k];
+    T lhs = reg[instr.lhs];
+    T rhs = reg[instr.rhs];
+    if (instr.annihilate && (lhs == prog.identity[k] ||
+        rhs == prog.identity[k]))
+      reg[kDeferredMaxLeaves+k] = prog.identity[k];
+    else
+      reg[kDeferredMaxLeaves+k] = deferredApply(instr.op, lhs, rhs);
+  }
+  return reg[kDeferredMaxLeaves+prog.ninstr-1];
+}
+
+template <typename T>
+__global__ void deferredEvalKernel(T*                 w_val,
+                                   DeferredProgram<T> prog,
+                                   Index              w_nvals) {
+  Index row = blockIdx.x * blockDim.x + threadIdx.x;
+  for (; row < w_nvals; row += blockDim.x * gridDim.x)
+    w_val[row] = deferredEval(prog, row);
+}
+
+// One partial reduction per block, so the fused element-wise chain is read
+// once and never written
+template <int NT, typename T, typename MonoidT>
+__global__ void deferredReduceKernel(T*                 block_val,
+                                     DeferredProgram<T> prog,
+                                     MonoidT            op,
+                                     T                  identity,
+                                     Index              u_nvals) {
+  typedef cub::BlockReduce<T, NT> BlockReduceT;
+  __shared__ typename BlockReduceT::TempStorage temp_storage;
+
+  T val = identity;
+  Index row = blockIdx.x * blockDim.x + threadIdx.x;
+  for (; row < u_nvals; row += blockDim.x * gridDim.x)
+    val = op(val, deferredEval(prog, row));
+
+  T block_total = BlockReduceT(temp_storage).Reduce(val, op);
+  if (threadIdx.x == 0)
+    block_val[blockIdx.x] = block_total;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_DEFERRED_HPP_
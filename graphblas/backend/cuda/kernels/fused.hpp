@@ -0,0 +1,116 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_FUSED_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_FUSED_HPP_
+
+#include <cub.cuh>
+
+namespace graphblas {
+namespace backend {
+
+// dense-dense eWiseMult with one partial reduction per block. Same identity
+// handling as eWiseMultKernel, so identity entries add nothing.
+template <int NT, typename T, typename U, typename V,
+          typename MulOp, typename AddOp>
+__global__ void eWiseMultReduceKernel(T*       block_val,
+                                      T        identity,
+                                      MulOp    mul_op,
+                                      AddOp    add_op,
+                                      const U* u_val,
+                                      const V* v_val,
+                                      Index    u_nvals) {
+  typedef cub::BlockReduce<T, NT> BlockReduceT;
+  __shared__ typename BlockReduceT::TempStorage temp_storage;
+
+  T val = identity;
+  Index row = blockIdx.x * blockDim.x + threadIdx.x;
+  for (; row < u_nvals; row += blockDim.x * gridDim.x) {
+    U u_t = u_val[row];
+    V v_t = v_val[row];
+    if (u_t != identity && v_t != identity)
+      val = add_op(val, mul_op(u_t, v_t));
+  }
+
+  T block_total = BlockReduceT(temp_storage).Reduce(val, add_op);
+  if (threadIdx.x == 0)
+    block_val[blockIdx.x] = block_total;
+}
+
+// sparse-dense eWiseMult with one partial reduction per block
+template <int NT, typename T, typename U, typename V,
+          typename MulOp, typename AddOp>
+__global__ void eWiseMultReduceKernel(T*           block_val,
+                                      T            identity,
+                                      MulOp        mul_op,
+                                      AddOp        add_op,
+                                      const Index* u_ind,
+                                      const U*     u_val,
+                                      Index        u_nvals,
+                                      const V*     v_val,
+                                      bool         reverse) {
+  typedef cub::BlockReduce<T, NT> BlockReduceT;
+  __shared__ typename BlockReduceT::TempStorage temp_storage;
+
+  T val = identity;
+  Index row = blockIdx.x * blockDim.x + threadIdx.x;
+  for (; row < u_nvals; row += blockDim.x * gridDim.x) {
+    U u_t = u_val[row];
+    if (u_t != identity) {
+      V v_t = v_val[u_ind[row]];
+      val = add_op(val, (reverse) ? mul_op(v_t, u_t) : mul_op(u_t, v_t));
+    }
+  }
+
+  T block_total = BlockReduceT(temp_storage).Reduce(val, add_op);
+  if (threadIdx.x == 0)
+    block_val[blockIdx.x] = block_total;
+}
+
+// Accumulates t into w under a dense mask and leaves in t the new value of
+// each element of w that changed, identity elsewhere. Masked-out elements of
+// w are kept, or cleared to identity without counting as changed when
+// use_repl. Number of changed elements is added to *d_nchanged.
+template <int NT, typename W, typename M, typename AccumOp>
+__global__ void accumChangedKernel(W*       w_val,
+                                   W*       t_val,
+                                   Index*   d_nchanged,
+                                   const M* mask_val,
+                                   bool     use_scmp,
+                                   bool     use_accum,
+                                   bool     use_repl,
+                                   AccumOp  accum_op,
+                                   W        identity,
+                                   Index    w_nvals) {
+  typedef cub::BlockReduce<Index, NT> BlockReduceT;
+  __shared__ typename BlockReduceT::TempStorage temp_storage;
+
+  Index nchanged = 0;
+  Index row = blockIdx.x * blockDim.x + threadIdx.x;
+  for (; row < w_nvals; row += blockDim.x * gridDim.x) {
+    bool allowed = (mask_val == NULL) ||
+        (use_scmp ? (mask_val[row] == 0) : (mask_val[row] != 0));
+    W w_old = w_val[row];
+    W w_new = w_old;
+    if (allowed) {
+      w_new = (use_accum) ? accum_op(w_old, t_val[row]) : t_val[row];
+    } else if (use_repl) {
+      w_val[row] = identity;
+      t_val[row] = identity;
+      continue;
+    }
+
+    if (w_new != w_old) {
+      w_val[row] = w_new;
+      t_val[row] = w_new;
+      nchanged++;
+    } else {
+      t_val[row] = identity;
+    }
+  }
+
+  Index block_total = BlockReduceT(temp_storage).Sum(nchanged);
+  if (threadIdx.x == 0 && block_total > 0)
+    atomicAdd(d_nchanged, block_total);
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_FUSED_HPP_
@@ -7,10 +7,16 @@
 #include "graphblas/backend/cuda/kernels/spmv.hpp"
 #include "graphblas/backend/cuda/kernels/spmspv.hpp"
 #include "graphblas/backend/cuda/kernels/spgemm.hpp"
+#include "graphblas/backend/cuda/kernels/spmm.hpp"
 #include "graphblas/backend/cuda/kernels/ewisemult.hpp"
 #include "graphblas/backend/cuda/kernels/ewiseadd.hpp"
 #include "graphblas/backend/cuda/kernels/trace.hpp"
+#include "graphblas/backend/cuda/kernels/tri.hpp"
 #include "graphblas/backend/cuda/kernels/scatter.hpp"
 #include "graphblas/backend/cuda/kernels/gather.hpp"
+#include "graphblas/backend/cuda/kernels/deferred.hpp"
+#include "graphblas/backend/cuda/kernels/fused.hpp"
+#include "graphblas/backend/cuda/kernels/msbfs.hpp"
+#include "graphblas/backend/cuda/kernels/ppr.hpp"
 
 #endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_KERNELS_HPP_
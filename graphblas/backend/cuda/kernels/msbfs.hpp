@@ -0,0 +1,78 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_MSBFS_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_MSBFS_HPP_
+
+#include <cstdint>
+
+namespace graphblas {
+namespace backend {
+
+// Sources per multi-source BFS, i.e. 8 lanes of 64 bits per vertex
+const int kMsBfsMaxSources = 512;
+
+// Valid source bits of lane in a batch of nsources
+__host__ __device__ inline uint64_t msBfsLaneFull(Index lane, Index nsources) {
+  Index nbits = nsources - 64*lane;
+  return (nbits >= 64) ? ~static_cast<uint64_t>(0) :
+      ((static_cast<uint64_t>(1) << nbits) - 1);
+}
+
+/*!
+ * \brief One pull step of multi-source BFS. Thread (row, lane) ORs that lane
+ *        of every in-neighbour's frontier word, so one scan of the adjacency
+ *        list serves all 64 sources of the lane. Scanning stops once every
+ *        source of the lane has reached row. New bits go to next and seen,
+ *        are ORed into d_active[lane], and if V is given, set the depth of
+ *        row from each new source to depth.
+ */
+template <typename T>
+__global__ void msBfsPullKernel(uint64_t*        next,
+                                uint64_t*        seen,
+                                uint64_t*        d_active,
+                                T*               V,
+                                T                depth,
+                                const uint64_t*  frontier,
+                                Index            nlanes,
+                                Index            nsources,
+                                Index            A_nrows,
+                                const Index*     A_csrRowPtr,
+                                const Index*     A_csrColInd) {
+  Index ind = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; ind < A_nrows*nlanes; ind += gridDim.x*blockDim.x) {
+    Index    row     = ind / nlanes;
+    Index    lane    = ind % nlanes;
+    uint64_t full    = msBfsLaneFull(lane, nsources);
+    uint64_t seen_t  = seen[ind];
+    uint64_t found   = 0;
+
+    if (seen_t != full) {
+      Index row_start = A_csrRowPtr[row];
+      Index row_end   = A_csrRowPtr[row+1];
+      for (; row_start < row_end; ++row_start) {
+        found |= frontier[A_csrColInd[row_start]*nlanes + lane];
+        if ((found | seen_t) == full)
+          break;
+      }
+      found &= ~seen_t;
+    }
+    next[ind] = found;
+
+    if (found) {
+      seen[ind] = seen_t | found;
+      atomicOr(reinterpret_cast<unsigned long long*>(d_active + lane),
+          static_cast<unsigned long long>(found));
+      if (V != NULL) {
+        uint64_t bits = found;
+        while (bits) {
+          Index bit = __ffsll(static_cast<long long>(bits)) - 1;
+          V[(lane*64 + bit)*A_nrows + row] = depth;
+          bits &= bits - 1;
+        }
+      }
+    }
+  }
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_MSBFS_HPP_
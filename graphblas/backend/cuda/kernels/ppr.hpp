@@ -0,0 +1,64 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_PPR_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_PPR_HPP_
+
+namespace graphblas {
+namespace backend {
+
+/*!
+ * \brief Moves alpha times the residual into P over the ncols active columns
+ *        in cols, keeps scale of it in R and leaves in T the share sent to
+ *        each out-neighbour, scale*R/d. Vertices with d_inv 0 have no
+ *        out-edges and move their whole residual into P.
+ */
+template <typename T>
+__global__ void pprBatchPushKernel(T*           P_val,
+                                   T*           R_val,
+                                   T*           T_val,
+                                   const T*     d_inv,
+                                   const Index* cols,
+                                   Index        ncols,
+                                   T            alpha,
+                                   T            scale,
+                                   Index        A_nrows,
+                                   Index        nseeds) {
+  // Thousands of seeds take A_nrows*nseeds past 2^31, so offsets are size_t
+  const size_t nvals = static_cast<size_t>(A_nrows)*ncols;
+  size_t ind = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; ind < nvals; ind += gridDim.x*blockDim.x) {
+    Index  row   = ind / ncols;
+    size_t R_ind = static_cast<size_t>(row)*nseeds + cols[ind % ncols];
+    T      r     = R_val[R_ind];
+    T      inv   = d_inv[row];
+    P_val[R_ind] += (inv == 0) ? r : alpha*r;
+    R_val[R_ind]  = (inv == 0) ? static_cast<T>(0) : scale*r;
+    T_val[R_ind]  = scale*r*inv;
+  }
+}
+
+/*!
+ * \brief Sets d_active[j] for each active column j with a residual above
+ *        d_eps, the degree times eps.
+ */
+template <typename T>
+__global__ void pprBatchActiveKernel(int*         d_active,
+                                     const T*     R_val,
+                                     const T*     d_eps,
+                                     const Index* cols,
+                                     Index        ncols,
+                                     Index        A_nrows,
+                                     Index        nseeds) {
+  const size_t nvals = static_cast<size_t>(A_nrows)*ncols;
+  size_t ind = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; ind < nvals; ind += gridDim.x*blockDim.x) {
+    Index row = ind / ncols;
+    Index j   = ind % ncols;
+    if (R_val[static_cast<size_t>(row)*nseeds + cols[j]] > d_eps[row])
+      d_active[j] = 1;
+  }
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_PPR_HPP_
@@ -0,0 +1,80 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_SPMM_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_SPMM_HPP_
+
+namespace graphblas {
+namespace backend {
+
+/*!
+ * \brief Sparse-dense product t = A * B over the ncols active columns in
+ *        cols. B is row-major with B_ncols columns and t is row-major with
+ *        ncols columns. Thread (row, j) computes t(row, j), so a warp reads
+ *        consecutive columns of the same rows of B. Entries of B equal to
+ *        identity are skipped.
+ */
+template <typename c, typename a, typename b,
+          typename MulOp, typename AddOp>
+__global__ void spmmColumnsKernel(c*           t_val,
+                                  const Index* cols,
+                                  Index        ncols,
+                                  c            identity,
+                                  MulOp        mul_op,
+                                  AddOp        add_op,
+                                  Index        A_nrows,
+                                  const Index* A_csrRowPtr,
+                                  const Index* A_csrColInd,
+                                  const a*     A_csrVal,
+                                  const b*     B_val,
+                                  Index        B_ncols) {
+  // A_nrows*ncols passes 2^31 for large batches, so offsets are size_t
+  const size_t nvals = static_cast<size_t>(A_nrows)*ncols;
+  size_t ind = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; ind < nvals; ind += gridDim.x*blockDim.x) {
+    Index row = ind / ncols;
+    Index col = cols[ind % ncols];
+    c     val = identity;
+
+    Index row_start = A_csrRowPtr[row];
+    Index row_end   = A_csrRowPtr[row+1];
+    for (; row_start < row_end; ++row_start) {
+      b B_t = B_val[static_cast<size_t>(A_csrColInd[row_start])*B_ncols +
+          col];
+      if (B_t != identity)
+        val = add_op(val, mul_op(A_csrVal[row_start], B_t));
+    }
+    t_val[ind] = val;
+  }
+}
+
+/*!
+ * \brief Writes t into the active columns of C, through accum if use_accum,
+ *        and sets d_changed[j] for each active column j that C changed in.
+ */
+template <typename c, typename AccumOp>
+__global__ void spmmAccumChangedKernel(c*           C_val,
+                                       int*         d_changed,
+                                       const c*     t_val,
+                                       const Index* cols,
+                                       Index        ncols,
+                                       bool         use_accum,
+                                       AccumOp      accum_op,
+                                       Index        C_nrows,
+                                       Index        C_ncols) {
+  const size_t nvals = static_cast<size_t>(C_nrows)*ncols;
+  size_t ind = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; ind < nvals; ind += gridDim.x*blockDim.x) {
+    Index  j     = ind % ncols;
+    size_t C_ind = (ind / ncols)*static_cast<size_t>(C_ncols) + cols[j];
+    c      old   = C_val[C_ind];
+    c      val   = (use_accum) ? accum_op(old, t_val[ind]) : t_val[ind];
+    if (val != old) {
+      C_val[C_ind] = val;
+      d_changed[j] = 1;
+    }
+  }
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_SPMM_HPP_
@@ -5,12 +5,12 @@ namespace graphblas {
 namespace backend {
 
 template <bool UseScmp,
-          typename W, typename a, typename U, typename M,
+          typename W, typename a, typename U, typename M, typename T,
           typename AccumOp, typename MulOp, typename AddOp>
 __global__ void spmspvSimpleMaskedKernel(W*           w_val,
                                          const M*     mask_val,
                                          AccumOp      accum_op,
-                                         a            identity,
+                                         T            identity,
                                          MulOp        mul_op,
                                          AddOp        add_op,
                                          Index        A_nrows,
@@ -87,11 +87,11 @@ __device__ float atomic(float* address, float val, AddOp add_op) {
  * \brief Not load-balanced, naive Sparse Matrix x Sparse Vector kernel
  *        for functors with add_op != Plus
  */
-template <typename W, typename a, typename U,
+template <typename W, typename a, typename U, typename T,
           typename AccumOp, typename MulOp, typename AddOp>
 __global__ void spmspvSimpleKernel(W*           w_val,
                                    AccumOp      accum_op,
-                                   a            identity,
+                                   T            identity,
                                    MulOp        mul_op,
                                    AddOp        add_op,
                                    const Index* A_csrRowPtr,
@@ -121,11 +121,11 @@ __global__ void spmspvSimpleKernel(W*           w_val,
  * \brief Not load-balanced, naive Sparse Matrix x Sparse Vector kernel
  *        specialized for functor being add_op == Plus
  */
-template <typename W, typename a, typename U,
+template <typename W, typename a, typename U, typename T,
           typename AccumOp, typename MulOp>
 __global__ void spmspvSimpleAddKernel(W*           w_val,
                                       AccumOp      accum_op,
-                                      a            identity,
+                                      T            identity,
                                       MulOp        mul_op,
                                       const Index* A_csrRowPtr,
                                       const Index* A_csrColInd,
@@ -154,11 +154,11 @@ __global__ void spmspvSimpleAddKernel(W*           w_val,
  * \brief Not load-balanced, naive Sparse Matrix x Sparse Vector kernel
  *        specialized for functor being add_op == Plus
  */
-template <typename W, typename a, typename U,
+template <typename W, typename a, typename U, typename T,
           typename AccumOp, typename MulOp>
 __global__ void spmspvSimpleOrKernel(W*           w_val,
                                      AccumOp      accum_op,
-                                     a            identity,
+                                     T            identity,
                                      MulOp        mul_op,
                                      const Index* A_csrRowPtr,
                                      const Index* A_csrColInd,
@@ -5,12 +5,12 @@ namespace graphblas {
 namespace backend {
 
 template <bool UseScmp, bool UseEarlyExit, bool UseOpReuse,
-          typename W, typename a, typename U, typename M,
+          typename W, typename a, typename U, typename M, typename T,
           typename AccumOp, typename MulOp, typename AddOp>
 __global__ void spmvDenseMaskedOrKernel(W*           w_val,
                                         const M*     mask_val,
                                         AccumOp      accum_op,
-                                        a            identity,
+                                        T            identity,
                                         MulOp        mul_op,
                                         AddOp        add_op,
                                         Index        A_nrows,
@@ -59,14 +59,14 @@ __global__ void spmvDenseMaskedOrKernel(W*           w_val,
 }
 
 template <bool UseScmp, bool UseEarlyExit, bool UseOpReuse,
-          typename W, typename a, typename U, typename M,
+          typename W, typename a, typename U, typename M, typename T,
           typename AccumOp, typename MulOp, typename AddOp>
 __global__ void spmvDenseMaskedOrKernelBench(W*           w_val,
                                              int*         stats,
                                              const M*     mask_val,
                                              M            mask_identity,
                                              AccumOp      accum_op,
-                                             a            identity,
+                                             T            identity,
                                              MulOp        mul_op,
                                              AddOp        add_op,
                                              Index        A_nrows,
@@ -118,6 +118,47 @@ __global__ void spmvDenseMaskedOrKernelBench(W*           w_val,
       w_val[row] = (W)0;
   }
 }
+
+/*!
+ * \brief Masked pull SpMV for MaximumSelectSecondSemiring, where each row of w
+ *        takes the value of one of its neighbours in u (e.g. a BFS parent).
+ *        With UseEarlyExit the row stops at the first neighbour found, which
+ *        gives some valid neighbour rather than the maximum one.
+ */
+template <bool UseScmp, bool UseEarlyExit,
+          typename W, typename a, typename U, typename M, typename T,
+          typename MulOp, typename AddOp>
+__global__ void spmvDenseMaskedSelectKernel(W*           w_val,
+                                            const M*     mask_val,
+                                            T            identity,
+                                            MulOp        mul_op,
+                                            AddOp        add_op,
+                                            Index        A_nrows,
+                                            const Index* A_csrRowPtr,
+                                            const Index* A_csrColInd,
+                                            const a*     A_csrVal,
+                                            const U*     u_val) {
+  Index row = blockIdx.x*blockDim.x + threadIdx.x;
+
+  for (; row < A_nrows; row += gridDim.x*blockDim.x) {
+    W val = identity;
+
+    if (UseScmp^static_cast<bool>(mask_val[row])) {
+      Index row_start = A_csrRowPtr[row];
+      Index row_end   = A_csrRowPtr[row + 1];
+
+      for (; row_start < row_end; row_start++) {
+        U u_t = u_val[A_csrColInd[row_start]];
+        if (u_t != identity) {
+          val = add_op(val, mul_op(A_csrVal[row_start], u_t));
+          if (UseEarlyExit)
+            break;
+        }
+      }
+    }
+    w_val[row] = val;
+  }
+}
 }  // namespace backend
 }  // namespace graphblas
 
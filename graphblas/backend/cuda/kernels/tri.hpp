@@ -0,0 +1,48 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_KERNELS_TRI_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_KERNELS_TRI_HPP_
+
+namespace graphblas {
+namespace backend {
+
+/*!
+ * \brief Counts triangles of a lower triangular L with sorted rows. Warp
+ *        per row: each lane takes an edge (row, col) and merges L(row, :)
+ *        with L(col, :), adding the common neighbours to ntris. Only the
+ *        part of L(row, :) before col can match, since L(col, :) < col.
+ */
+template <typename T>
+__global__ void tcIntersectKernel(T*           ntris,
+                                  Index        L_nrows,
+                                  const Index* L_csrRowPtr,
+                                  const Index* L_csrColInd) {
+  Index thread_id = blockDim.x * blockIdx.x + threadIdx.x;
+  Index warp_id   = thread_id>>5;
+  int lane_id     = thread_id & (32 - 1);
+  Index row       = warp_id;
+
+  if (row < L_nrows) {
+    Index row_start = L_csrRowPtr[row];
+    Index row_end   = L_csrRowPtr[row + 1];
+    T     count     = 0;
+
+    for (Index jj = row_start + lane_id; jj < row_end; jj += 32) {
+      Index col = L_csrColInd[jj];
+      Index i   = row_start;
+      Index j   = L_csrRowPtr[col];
+      Index end = L_csrRowPtr[col + 1];
+      while (i < jj && j < end) {
+        Index u = L_csrColInd[i];
+        Index v = L_csrColInd[j];
+        count += (u == v);
+        i += (u <= v);
+        j += (v <= u);
+      }
+    }
+    if (count != 0)
+      atomicAdd(ntris, count);
+  }
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_KERNELS_TRI_HPP_
@@ -76,6 +76,8 @@ class Matrix {
   Info fill(Index axis, Index nvals, U start);
   template <typename U>
   Info fillAscending(Index axis, Index nvals, U start);
+  Info share(const Matrix* rhs);
+  Info detach(bool copy = true);
 
  private:
   Index nrows_;
@@ -108,6 +110,28 @@ Info Matrix<T>::dup(const Matrix* rhs) {
   return GrB_UNINITIALIZED_OBJECT;
 }
 
+// Shallow copy: arrays stay shared until either matrix is written to
+template <typename T>
+Info Matrix<T>::share(const Matrix* rhs) {
+  mat_type_ = rhs->mat_type_;
+  nrows_    = rhs->nrows_;
+  ncols_    = rhs->ncols_;
+  nvals_    = rhs->nvals_;
+  if (mat_type_ == GrB_SPARSE)
+    return sparse_.share(&rhs->sparse_);
+  std::cout << "Error: Failed to call share!\n";
+  return GrB_UNINITIALIZED_OBJECT;
+}
+
+// Must be called by every operation that writes to this matrix, see
+// Vector::detach()
+template <typename T>
+Info Matrix<T>::detach(bool copy) {
+  if (mat_type_ == GrB_SPARSE)
+    return sparse_.detach(copy);
+  return GrB_SUCCESS;
+}
+
 template <typename T>
 Info Matrix<T>::clear() {
   mat_type_ = GrB_UNKNOWN;
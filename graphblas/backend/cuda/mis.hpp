@@ -0,0 +1,144 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_MIS_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_MIS_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Counter-based priority of vertex v in round r (splitmix64 finalizer), so
+// no weight vector is stored and every round draws fresh priorities
+inline uint64_t lubyHash(uint64_t seed, Index v, Index r) {
+  uint64_t x = seed + (static_cast<uint64_t>(r) << 32) +
+      static_cast<uint64_t>(v) + 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+inline bool lubyTest(const uint64_t* bits, Index v) {
+  return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+inline void lubyClear(uint64_t* bits, Index v) {
+  __atomic_fetch_and(&bits[v >> 6], ~(static_cast<uint64_t>(1) << (v & 63)),
+      __ATOMIC_RELAXED);
+}
+
+/*!
+ * Luby maximal independent set on the CPU. Candidates are a bitmap plus a
+ * list that is compacted every round, so a round only reads the edges of
+ * vertices still undecided:
+ *   1) a candidate joins the set if its priority beats every candidate
+ *      neighbour (ties by id)
+ *   2) new members and their neighbours leave the bitmap
+ *   3) the list keeps the candidates whose bit is still set
+ * The pattern of A must be symmetric. v(i) is 1 for members, else 0.
+ */
+template <typename T, typename a>
+Info lubyMisCpu(DenseVector<T>*        v,
+                const SparseMatrix<a>* A,
+                Index                  seed,
+                Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  std::vector<uint64_t> cand((A_nrows + 63) / 64, ~static_cast<uint64_t>(0));
+  if (A_nrows % 64 != 0)
+    cand.back() = (static_cast<uint64_t>(1) << (A_nrows % 64)) - 1;
+  uint64_t* cand_bits = cand.data();
+
+  std::vector<Index> worklist(A_nrows);
+  #pragma omp parallel for
+  for (Index i = 0; i < A_nrows; ++i)
+    worklist[i] = i;
+
+  T* v_val = v->h_val_;
+  std::fill(v_val, v_val + A_nrows, static_cast<T>(0));
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > next_t(nthreads);
+  std::vector<Index> members;
+  std::vector<Index> next;
+
+  Index round;
+  long long edges = 0;
+  for (round = 0; !worklist.empty(); ++round) {
+    // 1) Local maxima among candidates
+    #pragma omp parallel reduction(+:edges)
+    {
+      const int tid = threadId();
+      #pragma omp for schedule(dynamic, 256)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index    u      = worklist[k];
+        uint64_t prio_u = lubyHash(seed, u, round);
+        bool     best   = true;
+        Index    j      = A_csrRowPtr[u];
+        for (; j < A_csrRowPtr[u+1] && best; ++j) {
+          Index w = A_csrColInd[j];
+          if (w == u || !lubyTest(cand_bits, w))
+            continue;
+          uint64_t prio_w = lubyHash(seed, w, round);
+          best = prio_u > prio_w || (prio_u == prio_w && u < w);
+        }
+        edges += j - A_csrRowPtr[u];
+        if (best)
+          next_t[tid].push_back(u);
+      }
+    }
+    members.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      members.insert(members.end(), next_t[t].begin(), next_t[t].end());
+      next_t[t].clear();
+    }
+
+    // 2) Members and their neighbours stop being candidates
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+:edges)
+    for (Index k = 0; k < members.size(); ++k) {
+      Index u  = members[k];
+      v_val[u] = static_cast<T>(1);
+      lubyClear(cand_bits, u);
+      for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j)
+        lubyClear(cand_bits, A_csrColInd[j]);
+      edges += A_csrRowPtr[u+1] - A_csrRowPtr[u];
+    }
+
+    // 3) Compact the candidate list
+    #pragma omp parallel
+    {
+      const int tid = threadId();
+      #pragma omp for schedule(static)
+      for (Index k = 0; k < worklist.size(); ++k) {
+        if (lubyTest(cand_bits, worklist[k]))
+          next_t[tid].push_back(worklist[k]);
+      }
+    }
+    next.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      next.insert(next.end(), next_t[t].begin(), next_t[t].end());
+      next_t[t].clear();
+    }
+
+    if (desc->debug())
+      std::cout << "luby mis " << round << ": " << worklist.size()
+          << " candidates, " << members.size() << " joined\n";
+    worklist.swap(next);
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "luby mis, " << round << " rounds, " << edges
+        << " edges read, " << A->nvals_ << " per full pass\n";
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_MIS_HPP_
@@ -0,0 +1,205 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_MSBFS_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_MSBFS_HPP_
+
+#include <cstdint>
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include "graphblas/backend/cuda/kernels/kernels.hpp"
+
+namespace graphblas {
+namespace backend {
+/*!
+ * Multi-source BFS. Each vertex holds nlanes = ceil(nsources/64) words with
+ * one bit per source, for its frontier and seen sets. A level is one pull
+ * over A^T that ORs the in-neighbours' frontier words, which is the
+ * LogicalOrAnd vxm of every source at once.
+ *
+ * V (nsources x A_nrows, row-major) gets the depths as in bfs: 1 for the
+ * source, 0 if unreachable. ecc gets each source's eccentricity (the last
+ * level at which it reached a new vertex, counted in edges). Either may be
+ * NULL.
+ */
+
+// Records in ecc the sources with a bit set in active, which reached new
+// vertices at depth. Returns true if any did.
+inline bool msBfsActive(const uint64_t* active,
+                        Index           nlanes,
+                        Index           depth,
+                        Index*          ecc) {
+  bool any = false;
+  for (Index lane = 0; lane < nlanes; ++lane) {
+    uint64_t bits = active[lane];
+    any |= (bits != 0);
+    while (bits && ecc != NULL) {
+      ecc[lane*64 + __builtin_ctzll(bits)] = depth - 1;
+      bits &= bits - 1;
+    }
+  }
+  return any;
+}
+
+template <typename T, typename a>
+Info msBfsCpu(DenseMatrix<T>*        V,
+              Index*                 ecc,
+              const SparseMatrix<a>* A,
+              bool                   use_tran,
+              const Index*           sources,
+              Index                  nsources,
+              Descriptor*            desc) {
+  const Index nlanes  = (nsources + 63) / 64;
+  const Index A_nrows = A->nrows_;
+  T*          V_val   = (V != NULL) ? V->h_denseVal_ : NULL;
+  CHECK(spmvCpuSetup(A));
+
+  std::vector<uint64_t> frontier(A_nrows*nlanes, 0);
+  std::vector<uint64_t> next(A_nrows*nlanes, 0);
+  std::vector<uint64_t> seen;
+  for (Index k = 0; k < nsources; ++k) {
+    frontier[sources[k]*nlanes + k/64] |= static_cast<uint64_t>(1) << (k % 64);
+    if (V_val != NULL)
+      V_val[k*A_nrows + sources[k]] = static_cast<T>(1);
+    if (ecc != NULL)
+      ecc[k] = 0;
+  }
+  seen = frontier;
+
+  std::vector<uint64_t> active(nlanes);
+  for (Index depth = 2; depth <= desc->max_niter_ + 1; ++depth) {
+    std::fill(active.begin(), active.end(), 0);
+
+    #pragma omp parallel
+    {
+      const Index* A_csrRowPtr;
+      const Index* A_csrColInd;
+      const a*     A_csrVal;
+      spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+      uint64_t active_t[kMsBfsMaxSources/64] = {0};
+      uint64_t found[kMsBfsMaxSources/64];
+
+      #pragma omp for schedule(static)
+      for (Index row = 0; row < A_nrows; ++row) {
+        const uint64_t* seen_t = &seen[row*nlanes];
+        bool done = true;
+        for (Index lane = 0; lane < nlanes; ++lane) {
+          found[lane] = 0;
+          done &= (seen_t[lane] == msBfsLaneFull(lane, nsources));
+        }
+
+        // One scan of the adjacency list for all lanes
+        for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1] && !done;
+            ++j) {
+          const uint64_t* u_t = &frontier[A_csrColInd[j]*nlanes];
+          done = true;
+          for (Index lane = 0; lane < nlanes; ++lane) {
+            found[lane] |= u_t[lane];
+            done &= ((found[lane] | seen_t[lane]) ==
+                msBfsLaneFull(lane, nsources));
+          }
+        }
+
+        for (Index lane = 0; lane < nlanes; ++lane) {
+          uint64_t bits = found[lane] & ~seen_t[lane];
+          next[row*nlanes + lane]  = bits;
+          seen[row*nlanes + lane] |= bits;
+          active_t[lane] |= bits;
+          while (bits && V_val != NULL) {
+            Index k = lane*64 + __builtin_ctzll(bits);
+            V_val[k*A_nrows + row] = static_cast<T>(depth);
+            bits &= bits - 1;
+          }
+        }
+      }
+
+      #pragma omp critical
+      for (Index lane = 0; lane < nlanes; ++lane)
+        active[lane] |= active_t[lane];
+    }
+
+    if (!msBfsActive(active.data(), nlanes, depth, ecc))
+      break;
+    frontier.swap(next);
+  }
+
+  if (V != NULL)
+    CHECK(V->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info msBfsCuda(DenseMatrix<T>*        V,
+               Index*                 ecc,
+               const SparseMatrix<a>* A,
+               bool                   use_tran,
+               const Index*           sources,
+               Index                  nsources,
+               Descriptor*            desc) {
+  const Index  nlanes      = (nsources + 63) / 64;
+  const Index  A_nrows     = A->nrows_;
+  const Index* A_csrRowPtr = (use_tran) ? A->d_cscColPtr_ : A->d_csrRowPtr_;
+  const Index* A_csrColInd = (use_tran) ? A->d_cscRowInd_ : A->d_csrColInd_;
+  const size_t nwords      = static_cast<size_t>(A_nrows)*nlanes;
+
+  // Frontier, next and seen words, then the per-lane active words
+  CHECK(desc->resize((3*nwords + nlanes)*sizeof(uint64_t), "buffer"));
+  uint64_t* d_frontier = reinterpret_cast<uint64_t*>(desc->d_buffer_);
+  uint64_t* d_next     = d_frontier + nwords;
+  uint64_t* d_seen     = d_next + nwords;
+  uint64_t* d_active   = d_seen + nwords;
+
+  std::vector<uint64_t> h_frontier(nwords, 0);
+  for (Index k = 0; k < nsources; ++k) {
+    h_frontier[sources[k]*nlanes + k/64] |=
+        static_cast<uint64_t>(1) << (k % 64);
+    if (V != NULL)
+      V->h_denseVal_[k*A_nrows + sources[k]] = static_cast<T>(1);
+    if (ecc != NULL)
+      ecc[k] = 0;
+  }
+  CUDA_CALL(cudaMemcpy(d_frontier, h_frontier.data(),
+      nwords*sizeof(uint64_t), cudaMemcpyHostToDevice));
+  CUDA_CALL(cudaMemcpy(d_seen, d_frontier, nwords*sizeof(uint64_t),
+      cudaMemcpyDeviceToDevice));
+  T* d_V = NULL;
+  if (V != NULL) {
+    CHECK(V->cpuToGpu());
+    d_V = V->d_denseVal_;
+  }
+
+  Desc_value nt_mode;
+  CHECK(desc->get(GrB_NT, &nt_mode));
+  const int nt = static_cast<int>(nt_mode);
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = (nwords + nt - 1) / nt;
+  NB.y = 1;
+  NB.z = 1;
+
+  std::vector<uint64_t> h_active(nlanes);
+  for (Index depth = 2; depth <= desc->max_niter_ + 1; ++depth) {
+    CUDA_CALL(cudaMemset(d_active, 0, nlanes*sizeof(uint64_t)));
+    msBfsPullKernel<<<NB, NT>>>(d_next, d_seen, d_active, d_V,
+        static_cast<T>(depth), d_frontier, nlanes, nsources, A_nrows,
+        A_csrRowPtr, A_csrColInd);
+    CUDA_CALL(cudaMemcpy(h_active.data(), d_active,
+        nlanes*sizeof(uint64_t), cudaMemcpyDeviceToHost));
+
+    if (desc->debug())
+      printDevice("msbfs_next", d_next, nwords);
+    if (!msBfsActive(h_active.data(), nlanes, depth, ecc))
+      break;
+    std::swap(d_frontier, d_next);
+  }
+
+  if (V != NULL)
+    V->need_update_ = true;
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_MSBFS_HPP_
@@ -1,6 +1,7 @@
 #ifndef GRAPHBLAS_BACKEND_CUDA_OPERATIONS_HPP_
 #define GRAPHBLAS_BACKEND_CUDA_OPERATIONS_HPP_
 
+#include <string>
 #include <vector>
 #include <typeinfo>
 
@@ -13,6 +14,21 @@ class Vector;
 template <typename T>
 class Matrix;
 
+// Whether an operation reads the old values of its output out, in which case
+// detach() must copy them out of shared buffers first. accum reads them, and
+// so does a mask because the kernels leave masked-out entries in place rather
+// than clearing them for GrB_REPLACE. in0 and in1 are inputs that may alias
+// out.
+template <typename BinaryOpT>
+bool readsOutput(const void* out,
+                 const void* mask,
+                 BinaryOpT   accum,
+                 const void* in0 = NULL,
+                 const void* in1 = NULL) {
+  std::string accum_type = typeid(accum).name();
+  return mask != NULL || accum_type.size() > 1 || out == in0 || out == in1;
+}
+
 template <typename c, typename a, typename b, typename m,
           typename BinaryOpT,     typename SemiringT>
 Info mxm(Matrix<c>*       C,
@@ -22,6 +38,7 @@ Info mxm(Matrix<c>*       C,
          const Matrix<a>* A,
          const Matrix<b>* B,
          Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A, B)));
   Matrix<a>* A_t = const_cast<Matrix<a>*>(A);
   Matrix<b>* B_t = const_cast<Matrix<b>*>(B);
 
@@ -38,9 +55,13 @@ Info mxm(Matrix<c>*       C,
 
   if (A_mat_type == GrB_SPARSE && B_mat_type == GrB_SPARSE) {
     CHECK(C->setStorage(GrB_SPARSE));
+    Desc_value backend;
+    CHECK(desc->get(GrB_BACKEND, &backend));
     if (mask) {
       CHECK(spgemmMasked(&C->sparse_, mask, accum, op, &A->sparse_, &B->sparse_,
           desc));
+    } else if (backend == GrB_SEQUENTIAL) {
+      CHECK(spgemmCpu(&C->sparse_, accum, op, &A->sparse_, &B->sparse_, desc));
     } else if (typeid(c) == typeid(float) && typeid(a) == typeid(float) &&
                typeid(b) == typeid(float)) {
       CHECK(cusparse_spgemm2(&C->sparse_, mask, accum, op, &A->sparse_,
@@ -49,8 +70,19 @@ Info mxm(Matrix<c>*       C,
       std::cout << "Error: Unmasked SpGEMM not implemented yet!\n";
       return GrB_NOT_IMPLEMENTED;
     }
+  } else if (A_mat_type == GrB_SPARSE && B_mat_type == GrB_DENSE) {
+    if (mask) {
+      std::cout << "Error: Masked SpMM not implemented yet!\n";
+      return GrB_NOT_IMPLEMENTED;
+    }
+    Storage C_mat_type;
+    CHECK(C->getStorage(&C_mat_type));
+    if (C_mat_type != GrB_DENSE)
+      CHECK(C->setStorage(GrB_DENSE));
+    CHECK(spmm<c, a, b, c>(&C->dense_, NULL, NULL, accum, op, &A->sparse_,
+        &B->dense_, desc));
   } else {
-    std::cout << "Error: SpMM and GEMM not implemented yet!\n";
+    std::cout << "Error: DeMat x SpMat and GEMM not implemented yet!\n";
     return GrB_NOT_IMPLEMENTED;
     /*CHECK( C->setStorage( GrB_DENSE ) );
     if( A_mat_type==GrB_SPARSE && B_mat_type==GrB_DENSE )
@@ -86,6 +118,7 @@ Info vxm(Vector<W>*       w,
          const Vector<U>* u,
          const Matrix<a>* A,
          Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -221,6 +254,7 @@ Info mxv(Vector<W>*       w,
          const Matrix<a>* A,
          const Vector<U>* u,
          Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -335,6 +369,10 @@ Info eWiseMult(Vector<W>*       w,
                const Vector<U>* u,
                const Vector<V>* v,
                Descriptor*      desc) {
+  // Nonblocking mode records the op for fusion when it is element-wise only
+  if (deferEWiseMult(w, mask, accum, op, u, v, desc) == GrB_SUCCESS)
+    return GrB_SUCCESS;
+  CHECK(w->detach(readsOutput(w, mask, accum, u, v)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
   Vector<V>* v_t = const_cast<Vector<V>*>(v);
 
@@ -418,6 +456,7 @@ Info eWiseMult(Matrix<c>*       C,
                const Matrix<a>* A,
                const Matrix<b>* B,
                Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A, B)));
   // Use either op->operator() or op->mul() as the case may be
   std::cout << "Error: eWiseMult matrix variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
@@ -436,6 +475,7 @@ Info eWiseMult(Matrix<c>*       C,
                const Matrix<a>* A,
                b                val,
                Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A)));
   if (desc->debug()) {
     std::cout << "===Begin eWiseMult===\n";
     std::cout << "val: " << val << std::endl;
@@ -483,6 +523,7 @@ Info eWiseMult(Matrix<c>*       C,
                const Matrix<a>* A,
                const Vector<b>* B,
                Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A)));
   Vector<b>* B_t = const_cast<Vector<b>*>(B);
   if (desc->debug()) {
     std::cout << "===Begin eWiseMult===\n";
@@ -571,6 +612,9 @@ Info eWiseAdd(Vector<W>*       w,
               const Vector<U>* u,
               const Vector<V>* v,
               Descriptor*      desc) {
+  if (deferEWiseAdd(w, mask, accum, op, u, v, desc) == GrB_SUCCESS)
+    return GrB_SUCCESS;
+  CHECK(w->detach(readsOutput(w, mask, accum, u, v)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
   Vector<V>* v_t = const_cast<Vector<V>*>(v);
 
@@ -639,6 +683,7 @@ Info eWiseAdd(Matrix<c>*       C,
               const Matrix<a>* A,
               const Matrix<b>* B,
               Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A, B)));
   // Use either op->operator() or op->add() as the case may be
   std::cout << "Error: eWiseAdd matrix variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
@@ -657,6 +702,9 @@ Info eWiseAdd(Vector<W>*       w,
               const Vector<U>* u,
               V                val,
               Descriptor*      desc) {
+  if (deferEWiseAdd(w, mask, accum, op, u, val, desc) == GrB_SUCCESS)
+    return GrB_SUCCESS;
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
   if (desc->debug()) {
     std::cout << "===Begin eWiseAdd===\n";
@@ -707,6 +755,7 @@ Info extract(Vector<W>*                w,
              const std::vector<Index>* indices,
              Index                     nindices,
              Descriptor*               desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   std::cout << "Error: extract vector variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -722,6 +771,7 @@ Info extract(Matrix<c>*                C,
              const std::vector<Index>* col_indices,
              Index                     ncols,
              Descriptor*               desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A)));
   std::cout << "Error: extract matrix variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -736,6 +786,7 @@ Info extract(Vector<W>*                w,
              Index                     nrows,
              Index                     col_index,
              Descriptor*               desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum)));
   std::cout << "Error: extract vector variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -749,6 +800,7 @@ Info assignIndexed(Vector<W>*       w,
                    int*             indices,
                    Index            nindices,
                    Descriptor*      desc) {
+  CHECK(w->detach());
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -785,6 +837,7 @@ Info assign(Matrix<c>*                C,
             const std::vector<Index>* col_indices,
             Index                     ncols,
             Descriptor*               desc) {
+  CHECK(C->detach());
   std::cout << "Error: assign matrix variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -799,6 +852,7 @@ Info assign(Matrix<c>*                C,
             Index                     nrows,
             Index                     col_index,
             Descriptor*               desc) {
+  CHECK(C->detach());
   std::cout << "Error: assign matrix column variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -813,6 +867,7 @@ Info assign(Matrix<c>*                C,
             const std::vector<Index>* col_indices,
             Index                     ncols,
             Descriptor*               desc) {
+  CHECK(C->detach());
   std::cout << "Error: assign matrix row variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -826,6 +881,7 @@ Info assign(Vector<W>*           w,
             const Vector<Index>* indices,
             Index                nindices,
             Descriptor*          desc) {
+  CHECK(w->detach());
   if (desc->debug()) {
     std::cout << "===Begin assign===\n";
     std::cout << "Input: " << val << std::endl;
@@ -870,6 +926,7 @@ Info assign(Matrix<c>*                C,
             const std::vector<Index>* col_indices,
             Index                     ncols,
             Descriptor*               desc) {
+  CHECK(C->detach());
   std::cout << "Error: assign matrix variant not implemented yet!\n";
   return GrB_NOT_IMPLEMENTED;
 }
@@ -882,6 +939,7 @@ Info apply(Vector<W>*       w,
            UnaryOpT         op,
            const Vector<U>* u,
            Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -919,6 +977,7 @@ Info apply(Matrix<c>*       C,
            UnaryOpT         op,
            const Matrix<a>* A,
            Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A)));
   Matrix<a>* A_t = const_cast<Matrix<a>*>(A);
 
   if (desc->debug()) {
@@ -956,6 +1015,7 @@ Info reduce(Vector<W>*       w,
             MonoidT          op,
             const Matrix<a>* A,
             Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum)));
   if (desc->debug()) {
     std::cout << "===Begin reduce===\n";
   }
@@ -996,6 +1056,10 @@ Info reduce(T*               val,
             Descriptor*      desc) {
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
+  // Fuse any deferred element-wise ops producing u into the reduction
+  if (reduceDeferred(val, accum, op, u, desc) == GrB_SUCCESS)
+    return GrB_SUCCESS;
+
   if (desc->debug()) {
     std::cout << "===Begin reduce===\n";
     CHECK(u_t->print());
@@ -1065,6 +1129,7 @@ Info transpose(Matrix<c>*       C,
                BinaryOpT        accum,
                const Matrix<a>* A,
                Descriptor*      desc) {
+  CHECK(C->detach(readsOutput(C, mask, accum, A)));
   if (desc->debug()) {
     std::cout << "===Begin transpose===\n";
   }
@@ -1113,6 +1178,7 @@ Info scatter(Vector<W>*       w,
              const Vector<U>* u,
              T                val,
              Descriptor*      desc) {
+  CHECK(w->detach());
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -1150,6 +1216,7 @@ Info assignScatter(Vector<W>*       w,
                    const Vector<U>* u,
                    const Vector<I>* indices,
                    Descriptor*      desc) {
+  CHECK(w->detach());
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
   Vector<I>* indices_t = const_cast<Vector<I>*>(indices);
 
@@ -1205,6 +1272,7 @@ Info extractGather(Vector<W>*       w,
                    const Vector<U>* u,
                    const Vector<I>* indices,
                    Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u, indices)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
   Vector<I>* indices_t = const_cast<Vector<I>*>(indices);
 
@@ -1256,6 +1324,7 @@ template <typename W, typename a>
 Info graphColor(Vector<W>*       w,
                 const Matrix<a>* A,
                 Descriptor*      desc) {
+  CHECK(w->detach(false));
   if (desc->debug())
     std::cout << "===Begin cuSPARSE graph color===\n";
 
@@ -1270,6 +1339,656 @@ Info graphColor(Vector<W>*       w,
   return GrB_SUCCESS;
 }
 
+template <typename T, typename a>
+Info msBfs(Matrix<T>*       V,
+           Index*           ecc,
+           const Matrix<a>* A,
+           const Index*     sources,
+           Index            nsources,
+           Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin msBfs===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: msBfs on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Pull over A^T as in vxm
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode != GrB_TRAN);
+  if (use_tran && !A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: msBfs needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  DenseMatrix<T>* V_dense = NULL;
+  if (V != NULL) {
+    CHECK(V->detach());
+    CHECK(V->setStorage(GrB_DENSE));
+    V_dense = &V->dense_;
+  }
+
+  if (backend == GrB_SEQUENTIAL)
+    CHECK(msBfsCpu(V_dense, ecc, &A->sparse_, use_tran, sources, nsources,
+        desc));
+  else
+    CHECK(msBfsCuda(V_dense, ecc, &A->sparse_, use_tran, sources, nsources,
+        desc));
+
+  if (desc->debug())
+    std::cout << "===End msBfs===\n";
+  return GrB_SUCCESS;
+}
+
+template <typename W, typename a>
+Info greedyColor(Vector<W>*       w,
+                 const Matrix<a>* A,
+                 int              order,
+                 Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin greedyColor===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: greedyColor on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (order < kColorNatural || order > kColorSmallestLast) {
+    std::cout << "Error: Invalid greedyColor vertex order!\n";
+    return GrB_INVALID_VALUE;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: greedyColor GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(w->detach(false));
+  CHECK(w->setStorage(GrB_DENSE));
+  CHECK(greedyColorCpu(&w->dense_, &A->sparse_,
+      static_cast<GreedyColorOrder>(order), desc));
+
+  if (desc->debug()) {
+    std::cout << "===End greedyColor===\n";
+    CHECK(w->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename W, typename a>
+Info distance2Color(Vector<W>*       w,
+                    const Matrix<a>* A,
+                    bool             partial,
+                    Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin distance2Color===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: distance2Color on dense matrix not implemented "
+        << "yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (partial && !A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: Partial distance2Color needs the CSC of an "
+        << "asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: distance2Color GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(w->detach(false));
+  CHECK(w->setStorage(GrB_DENSE));
+  CHECK(distance2ColorCpu(&w->dense_, &A->sparse_, partial, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End distance2Color===\n";
+    CHECK(w->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info lubyMis(Vector<T>*       v,
+             const Matrix<a>* A,
+             Index            seed,
+             Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin lubyMis===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: lubyMis on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: lubyMis GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(lubyMisCpu(&v->dense_, &A->sparse_, seed, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End lubyMis===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info afforest(Vector<T>*       v,
+              const Matrix<a>* A,
+              Index            seed,
+              Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin afforest===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: afforest on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Weak components of an asymmetric matrix also need its in-edges
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (!A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: afforest needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: afforest GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(afforestCpu(&v->dense_, &A->sparse_, A_symmetric, seed, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End afforest===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info pageRankPush(Vector<T>*       p,
+                  const Matrix<a>* A,
+                  double           alpha,
+                  double           eps,
+                  Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin pageRankPush===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: pageRankPush on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Push along out-edges as in vxm, so rows of A unless transposed
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode == GrB_TRAN);
+  if (use_tran && !A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: pageRankPush needs the CSC of an asymmetric "
+        << "matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: pageRankPush GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(p->detach(false));
+  CHECK(p->setStorage(GrB_DENSE));
+  CHECK(pageRankPushCpu(&p->dense_, &A->sparse_, use_tran, alpha, eps, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End pageRankPush===\n";
+    CHECK(p->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info lgcPush(Vector<T>*       p,
+             const Matrix<a>* A,
+             Index            s,
+             double           alpha,
+             double           eps,
+             Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin lgcPush===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: lgcPush on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Push along out-edges as in vxm, so rows of A unless transposed
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode == GrB_TRAN);
+  if (use_tran && !A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: lgcPush needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: lgcPush GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(p->detach(false));
+  CHECK(p->setStorage(GrB_SPARSE));
+  CHECK(lgcPushCpu(&p->sparse_, &A->sparse_, use_tran, s, alpha, eps, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End lgcPush===\n";
+    CHECK(p->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info pprBatch(Matrix<T>*       P,
+              const Matrix<a>* A,
+              const Index*     seeds,
+              Index            nseeds,
+              double           alpha,
+              double           eps,
+              bool             push,
+              Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin pprBatch===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: pprBatch on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Out-edges are rows of A unless transposed. SpMM pulls over in-edges, so
+  // it needs both the CSR and CSC of an asymmetric matrix
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode == GrB_TRAN);
+  if ((use_tran || !push) && !A_symmetric &&
+      A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: pprBatch needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (push && backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: pprBatch push GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(P->detach(false));
+  CHECK(P->setStorage(GrB_DENSE));
+  if (push)
+    CHECK(pprPushCpu(&P->dense_, &A->sparse_, use_tran, seeds, nseeds, alpha,
+        eps, desc));
+  else if (backend == GrB_SEQUENTIAL)
+    CHECK(pprBatchCpu(&P->dense_, &A->sparse_, !use_tran, seeds, nseeds,
+        alpha, eps, desc));
+  else
+    CHECK(pprBatchCuda(&P->dense_, &A->sparse_, !use_tran, seeds, nseeds,
+        alpha, eps, desc));
+
+  if (desc->debug())
+    std::cout << "===End pprBatch===\n";
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info bcBatch(Vector<T>*       v,
+             const Matrix<a>* A,
+             const Index*     sources,
+             Index            nsources,
+             Index            batch,
+             double           scale,
+             Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin bcBatch===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: bcBatch on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Forward pulls over A^T as in vxm, backward over A, so an asymmetric
+  // matrix needs both its CSR and CSC
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode != GrB_TRAN);
+  if (!A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: bcBatch needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: bcBatch GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(bcBatchCpu(&v->dense_, &A->sparse_, use_tran, sources, nsources,
+      batch, scale, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End bcBatch===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a, typename U>
+Info kcorePeel(Vector<T>*       v,
+               const Matrix<a>* A,
+               const Vector<U>* degree,
+               Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin kcorePeel===\n";
+
+  Storage A_mat_type;
+  Storage degree_vec_type;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(degree->getStorage(&degree_vec_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: kcorePeel on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (degree_vec_type != GrB_DENSE) {
+    std::cout << "Error: kcorePeel needs a dense degree vector!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: kcorePeel GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(readsOutput(v, GrB_NULL, GrB_NULL, degree)));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(kcorePeelCpu(&v->dense_, &A->sparse_, &degree->dense_, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End kcorePeel===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename c, typename a>
+Info ktruss(Matrix<c>*       C,
+            const Matrix<a>* A,
+            Index            k,
+            Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin ktruss===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: ktruss on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: ktruss GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(C->detach(readsOutput(C, GrB_NULL, GrB_NULL, A)));
+  CHECK(C->setStorage(GrB_SPARSE));
+  CHECK(ktrussCpu(&C->sparse_, &A->sparse_, k, desc));
+
+  if (desc->debug())
+    std::cout << "===End ktruss===\n";
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info labelProp(Vector<T>*       v,
+               const Matrix<a>* A,
+               bool             async,
+               Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin labelProp===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: labelProp on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: labelProp GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(labelPropCpu(&v->dense_, &A->sparse_, async, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End labelProp===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info louvainMove(Vector<T>*       v,
+                 const Matrix<a>* A,
+                 Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin louvainMove===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: louvainMove on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: louvainMove GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(louvainMoveCpu(&v->dense_, &A->sparse_, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End louvainMove===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename a, typename T>
+Info modularity(double*          q,
+                const Matrix<a>* A,
+                const Vector<T>* v,
+                Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin modularity===\n";
+
+  Storage A_mat_type;
+  Storage v_vec_type;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(v->getStorage(&v_vec_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: modularity on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (v_vec_type != GrB_DENSE) {
+    std::cout << "Error: modularity needs a dense label vector!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(modularityCpu(q, &A->sparse_, &v->dense_, desc));
+
+  if (desc->debug())
+    std::cout << "===End modularity===\n";
+  return GrB_SUCCESS;
+}
+
+template <typename c, typename a, typename b, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info mxmAccumMask(Matrix<c>*       C,
+                  Vector<M>*       mask,
+                  Index*           nactive,
+                  BinaryOpT        accum,
+                  SemiringT        op,
+                  const Matrix<a>* A,
+                  const Matrix<b>* B,
+                  Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin mxmAccumMask===\n";
+
+  Storage A_mat_type, B_mat_type, C_mat_type, mask_vec_type;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(B->getStorage(&B_mat_type));
+  CHECK(C->getStorage(&C_mat_type));
+  CHECK(mask->getStorage(&mask_vec_type));
+  if (A_mat_type != GrB_SPARSE || B_mat_type != GrB_DENSE ||
+      C_mat_type != GrB_DENSE) {
+    std::cout << "Error: mxmAccumMask needs sparse A and dense B, C!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (mask_vec_type != GrB_DENSE) {
+    std::cout << "Error: Sparse mask mxmAccumMask not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(spmm(&C->dense_, &mask->dense_, nactive, accum, op, &A->sparse_,
+      &B->dense_, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End mxmAccumMask===\n";
+    CHECK(C->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info deltaStepping(Vector<T>*       v,
+                   const Matrix<a>* A,
+                   Index            s,
+                   T                delta,
+                   Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin deltaStepping===\n";
+
+  Storage            A_mat_type;
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getStorage(&A_mat_type));
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: deltaStepping on dense matrix not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  // Push along out-edges as in vxm, so rows of A unless transposed
+  Desc_value inp1_mode, backend;
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  bool use_tran = (inp1_mode == GrB_TRAN);
+  if (use_tran && !A_symmetric && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: deltaStepping needs the CSC of an asymmetric "
+        << "matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (backend != GrB_SEQUENTIAL) {
+    std::cout << "Error: deltaStepping GPU not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(v->detach(false));
+  CHECK(v->setStorage(GrB_DENSE));
+  CHECK(deltaSteppingCpu(&v->dense_, &A->sparse_, use_tran, s, delta, desc));
+
+  if (desc->debug()) {
+    std::cout << "===End deltaStepping===\n";
+    CHECK(v->print());
+  }
+  return GrB_SUCCESS;
+}
+
 template <typename W, typename U, typename a, typename M,
           typename BinaryOpT, typename SemiringT>
 Info applyVxm(Vector<W>*       w,
@@ -1279,6 +1998,7 @@ Info applyVxm(Vector<W>*       w,
               const Vector<U>* u,
               const Matrix<a>* A,
               Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
   Vector<U>* u_t = const_cast<Vector<U>*>(u);
 
   if (desc->debug()) {
@@ -1403,10 +2123,141 @@ Info applyVxm(Vector<W>*       w,
   return GrB_SUCCESS;
 }
 
+template <typename W, typename T, typename U, typename a, typename M,
+          typename BinaryOpT, typename MonoidT, typename SemiringT>
+Info vxmReduce(Vector<W>*       w,
+               T*               val,
+               const Vector<M>* mask,
+               BinaryOpT        accum,
+               MonoidT          reduce_op,
+               SemiringT        op,
+               const Vector<U>* u,
+               const Matrix<a>* A,
+               Descriptor*      desc) {
+  CHECK(w->detach(readsOutput(w, mask, accum, u)));
+  if (desc->debug())
+    std::cout << "===Begin vxmReduce===\n";
+
+  bool use_tran;
+  Info err = vxmCpuPrepare(w, op, u, A, &use_tran, desc);
+  if (err == GrB_SUCCESS) {
+    CHECK(vxmReduceCpu(&w->dense_, val, mask, accum, reduce_op, op,
+        &u->dense_, &A->sparse_, use_tran, desc));
+    desc->lastmxv_ = GrB_PULLONLY;
+  } else if (err == GrB_NOT_IMPLEMENTED) {
+    CHECK(vxm<W, U, a, M>(w, mask, accum, op, u, A, desc));
+    CHECK(reduce(val, GrB_NULL, reduce_op, w, desc));
+  } else {
+    return err;
+  }
+
+  if (desc->debug()) {
+    std::cout << "===End vxmReduce===\n";
+    std::cout << "Output: " << *val << std::endl;
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename W, typename U, typename a, typename M,
+          typename BinaryOpT, typename SemiringT>
+Info vxmAccumMask(Vector<W>*       w,
+                  Vector<W>*       changed,
+                  Index*           nchanged,
+                  const Vector<M>* mask,
+                  BinaryOpT        accum,
+                  SemiringT        op,
+                  const Vector<U>* u,
+                  const Matrix<a>* A,
+                  Descriptor*      desc) {
+  CHECK(w->detach());
+  CHECK(changed->detach(readsOutput(changed, mask, GrB_NULL, u)));
+  if (desc->debug())
+    std::cout << "===Begin vxmAccumMask===\n";
+
+  bool use_tran;
+  Info err = vxmCpuPrepare(w, op, u, A, &use_tran, desc);
+  if (err == GrB_SUCCESS) {
+    CHECK(changed->setStorage(GrB_DENSE));
+    CHECK(vxmAccumMaskCpu(&w->dense_, &changed->dense_, nchanged, mask,
+        accum, op, &u->dense_, &A->sparse_, use_tran, desc));
+    desc->lastmxv_ = GrB_PULLONLY;
+  } else if (err == GrB_NOT_IMPLEMENTED) {
+    // changed holds u * A until the epilogue turns it into the changed set
+    CHECK(vxm<W, U, a, M>(changed, mask, GrB_NULL, op, u, A, desc));
+
+    Storage vec_type;
+    CHECK(changed->getStorage(&vec_type));
+    if (vec_type == GrB_SPARSE)
+      CHECK(changed->sparse2dense(op.identity(), desc));
+    CHECK(w->getStorage(&vec_type));
+    if (vec_type == GrB_SPARSE)
+      CHECK(w->sparse2dense(op.identity(), desc));
+    else if (vec_type == GrB_UNKNOWN)
+      CHECK(w->fill(op.identity()));
+
+    CHECK(accumChangedInner(&w->dense_, &changed->dense_, nchanged, mask,
+        accum, op, desc));
+  } else {
+    return err;
+  }
+
+  if (desc->debug()) {
+    std::cout << "===End vxmAccumMask===\n";
+    std::cout << "Changed: " << *nchanged << std::endl;
+    CHECK(w->print());
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info eWiseMultReduce(T*               val,
+                     BinaryOpT        accum,
+                     SemiringT        op,
+                     const Vector<U>* u,
+                     const Vector<V>* v,
+                     Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin eWiseMultReduce===\n";
+
+  Storage u_vec_type;
+  Storage v_vec_type;
+  CHECK(u->getStorage(&u_vec_type));
+  CHECK(v->getStorage(&v_vec_type));
+
+  // 4 cases:
+  // 1) SpVec x SpVec
+  // 2) SpVec x DeVec
+  // 3) DeVec x SpVec
+  // 4) DeVec x DeVec
+  if (u_vec_type == GrB_SPARSE && v_vec_type == GrB_SPARSE) {
+    CHECK(eWiseMultReduceInner(val, accum, op, &u->sparse_, &v->sparse_,
+        desc));
+  } else if (u_vec_type == GrB_SPARSE && v_vec_type == GrB_DENSE) {
+    CHECK(eWiseMultReduceInner(val, accum, op, &u->sparse_, &v->dense_,
+        false, desc));
+  } else if (u_vec_type == GrB_DENSE && v_vec_type == GrB_SPARSE) {
+    CHECK(eWiseMultReduceInner(val, accum, op, &v->sparse_, &u->dense_,
+        true, desc));
+  } else if (u_vec_type == GrB_DENSE && v_vec_type == GrB_DENSE) {
+    CHECK(eWiseMultReduceInner(val, accum, op, &u->dense_, &v->dense_,
+        desc));
+  } else {
+    return GrB_UNINITIALIZED_OBJECT;
+  }
+
+  if (desc->debug()) {
+    std::cout << "===End eWiseMultReduce===\n";
+    std::cout << "Output: " << *val << std::endl;
+  }
+  return GrB_SUCCESS;
+}
+
 template <typename c, typename a>
 Info tril(Matrix<c>*  C,
           Matrix<a>*  A,
           Descriptor* desc) {
+  CHECK(C->detach(C == A));
   if (desc->debug()) {
     std::cout << "===Begin tril===\n";
   }
@@ -1429,6 +2280,56 @@ Info tril(Matrix<c>*  C,
 
   return GrB_SUCCESS;
 }
+
+template <typename c, typename a>
+Info trilDegree(Matrix<c>*       C,
+                Index*           perm,
+                const Matrix<a>* A,
+                Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin trilDegree===\n";
+
+  Storage A_mat_type;
+  CHECK(A->getStorage(&A_mat_type));
+  if (A_mat_type != GrB_SPARSE) {
+    std::cout << "Error: Dense trilDegree not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  CHECK(C->detach(readsOutput(C, GrB_NULL, GrB_NULL, A)));
+  CHECK(C->setStorage(GrB_SPARSE));
+  CHECK(trilDegreeCpu(&C->sparse_, perm, &A->sparse_, desc));
+
+  if (desc->debug())
+    std::cout << "===End trilDegree===\n";
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info tcIntersect(T*               ntris,
+                 const Matrix<a>* L,
+                 Descriptor*      desc) {
+  if (desc->debug())
+    std::cout << "===Begin tcIntersect===\n";
+
+  Storage L_mat_type;
+  CHECK(L->getStorage(&L_mat_type));
+  if (L_mat_type != GrB_SPARSE) {
+    std::cout << "Error: Dense tcIntersect not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (backend == GrB_SEQUENTIAL)
+    CHECK(tcIntersectCpu(ntris, &L->sparse_, desc));
+  else
+    CHECK(tcIntersectCuda(ntris, &L->sparse_, desc));
+
+  if (desc->debug())
+    std::cout << "===End tcIntersect===\n";
+  return GrB_SUCCESS;
+}
 }  // namespace backend
 }  // namespace graphblas
 
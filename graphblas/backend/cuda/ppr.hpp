@@ -0,0 +1,449 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_PPR_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_PPR_HPP_
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "graphblas/backend/cuda/kernels/kernels.hpp"
+
+namespace graphblas {
+namespace backend {
+/*!
+ * Batched personalized PageRank with the lazy-walk updates of
+ * algorithm::lgc. Column j of P (A_nrows x nseeds, row-major) gets the
+ * PageRank personalized to seeds[j]. Every active vertex v pushes each
+ * round:
+ *
+ *   p(v) += alpha*r(v)
+ *   r(v)  = (1-alpha)/2*r(v)
+ *   r(w) += (1-alpha)/2*r(v)*A(v, w)/d(v)   for each out-neighbour w
+ *
+ * where d is the weighted out-degree. A column stays active while some
+ * r(v) > d(v)*eps. Vertices without out-edges move their whole residual into
+ * p, as a self-loop would.
+ */
+
+// Weighted out-degrees d of A read along use_tran, with 1/d (0 if d is 0)
+// and d*eps
+template <typename T, typename a>
+void pprDegrees(std::vector<T>*        d_inv,
+                std::vector<T>*        d_eps,
+                const SparseMatrix<a>* A,
+                bool                   use_tran,
+                double                 eps) {
+  const Index A_nrows = A->nrows_;
+  d_inv->resize(A_nrows);
+  d_eps->resize(A_nrows);
+
+  #pragma omp parallel
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+    #pragma omp for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      T degree = static_cast<T>(0);
+      for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j)
+        degree += static_cast<T>(A_csrVal[j]);
+      (*d_inv)[row] = (degree == 0) ? static_cast<T>(0) :
+          static_cast<T>(1)/degree;
+      (*d_eps)[row] = degree*static_cast<T>(eps);
+    }
+  }
+}
+
+/*!
+ * Residuals of all seeds form a dense A_nrows x nseeds matrix R. One round
+ * scales R, then adds the pull over the column-stochastic A^T D^-1 with
+ * spmmCpu. Only columns still active take part, so converged seeds are
+ * frozen and cost nothing.
+ */
+template <typename T, typename a>
+Info pprBatchCpu(DenseMatrix<T>*        P,
+                 const SparseMatrix<a>* A,
+                 bool                   use_tran,
+                 const Index*           seeds,
+                 Index                  nseeds,
+                 double                 alpha,
+                 double                 eps,
+                 Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  const T     alpha_t = static_cast<T>(alpha);
+  const T     scale   = static_cast<T>((1. - alpha)/2.);
+  CHECK(spmvCpuSetup(A));
+
+  std::vector<T> d_inv;
+  std::vector<T> d_eps;
+  pprDegrees(&d_inv, &d_eps, A, !use_tran, eps);
+
+  DenseMatrix<T> R(A_nrows, nseeds);
+  DenseMatrix<T> T_mat(A_nrows, nseeds);
+  CHECK(R.allocate());
+  CHECK(T_mat.allocate());
+  T* P_val = P->h_denseVal_;
+  T* R_val = R.h_denseVal_;
+  T* T_val = T_mat.h_denseVal_;
+  std::fill(P_val, P_val + static_cast<size_t>(A_nrows)*nseeds,
+      static_cast<T>(0));
+  for (Index j = 0; j < nseeds; ++j)
+    R_val[static_cast<size_t>(seeds[j])*nseeds + j] = static_cast<T>(1);
+
+  std::vector<Index> cols(nseeds);
+  for (Index j = 0; j < nseeds; ++j)
+    cols[j] = j;
+  std::vector<int> changed(nseeds);
+  std::vector<int> active(nseeds);
+
+  Index iter;
+  for (iter = 1; iter <= desc->max_niter_ && !cols.empty(); ++iter) {
+    const Index ncols = cols.size();
+
+    #pragma omp parallel for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      const T inv = d_inv[row];
+      for (Index k = 0; k < ncols; ++k) {
+        size_t ind = static_cast<size_t>(row)*nseeds + cols[k];
+        T      r   = R_val[ind];
+        P_val[ind] += (inv == 0) ? r : alpha_t*r;
+        R_val[ind]  = (inv == 0) ? static_cast<T>(0) : scale*r;
+        T_val[ind]  = scale*r*inv;
+      }
+    }
+
+    // R = R + A^T * T over active columns
+    CHECK(spmmCpu(&R, changed.data(), cols, plus<T>(),
+        PlusMultipliesSemiring<a, T, T>(), A, use_tran, &T_mat, desc));
+
+    std::fill(active.begin(), active.begin() + ncols, 0);
+    #pragma omp parallel
+    {
+      std::vector<int> active_t(ncols, 0);
+
+      #pragma omp for schedule(static)
+      for (Index row = 0; row < A_nrows; ++row)
+        for (Index k = 0; k < ncols; ++k)
+          if (R_val[static_cast<size_t>(row)*nseeds + cols[k]] > d_eps[row])
+            active_t[k] = 1;
+
+      #pragma omp critical
+      for (Index k = 0; k < ncols; ++k)
+        active[k] |= active_t[k];
+    }
+
+    Index nactive = 0;
+    for (Index k = 0; k < ncols; ++k)
+      if (active[k])
+        cols[nactive++] = cols[k];
+    cols.resize(nactive);
+    if (desc->debug())
+      std::cout << "ppr batch " << iter << ": " << nactive << "/" << nseeds
+          << " seeds active\n";
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "ppr batch, " << iter - 1 << " rounds\n";
+  CHECK(R.clear());
+  CHECK(T_mat.clear());
+  CHECK(P->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info pprBatchCuda(DenseMatrix<T>*        P,
+                  const SparseMatrix<a>* A,
+                  bool                   use_tran,
+                  const Index*           seeds,
+                  Index                  nseeds,
+                  double                 alpha,
+                  double                 eps,
+                  Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+
+  std::vector<T> d_inv;
+  std::vector<T> d_eps;
+  pprDegrees(&d_inv, &d_eps, A, !use_tran, eps);
+
+  DenseMatrix<T> R(A_nrows, nseeds);
+  DenseMatrix<T> T_mat(A_nrows, nseeds);
+  CHECK(R.allocate());
+  CHECK(T_mat.allocate());
+  for (Index j = 0; j < nseeds; ++j)
+    R.h_denseVal_[static_cast<size_t>(seeds[j])*nseeds + j] =
+        static_cast<T>(1);
+  CHECK(R.cpuToGpu());
+  CUDA_CALL(cudaMemset(P->d_denseVal_, 0,
+      static_cast<size_t>(A_nrows)*nseeds*sizeof(T)));
+
+  // spmmCuda works in the buffer, so 1/d, d*eps, columns and flags go in temp
+  CHECK(desc->resize(2*A_nrows*sizeof(T) + nseeds*(sizeof(Index) +
+      sizeof(int)), "temp"));
+  T*     d_dinv   = reinterpret_cast<T*>(desc->d_temp_);
+  T*     d_deps   = d_dinv + A_nrows;
+  Index* d_cols   = reinterpret_cast<Index*>(d_deps + A_nrows);
+  int*   d_active = reinterpret_cast<int*>(d_cols + nseeds);
+  CUDA_CALL(cudaMemcpy(d_dinv, d_inv.data(), A_nrows*sizeof(T),
+      cudaMemcpyHostToDevice));
+  CUDA_CALL(cudaMemcpy(d_deps, d_eps.data(), A_nrows*sizeof(T),
+      cudaMemcpyHostToDevice));
+
+  std::vector<Index> cols(nseeds);
+  for (Index j = 0; j < nseeds; ++j)
+    cols[j] = j;
+  std::vector<int> changed(nseeds);
+  std::vector<int> active(nseeds);
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.y = 1;
+  NB.z = 1;
+
+  Index iter;
+  for (iter = 1; iter <= desc->max_niter_ && !cols.empty(); ++iter) {
+    const Index  ncols = cols.size();
+    const size_t nvals = static_cast<size_t>(A_nrows)*ncols;
+    NB.x = std::min((nvals + nt - 1) / nt, static_cast<size_t>(65535));
+    CUDA_CALL(cudaMemcpy(d_cols, cols.data(), ncols*sizeof(Index),
+        cudaMemcpyHostToDevice));
+
+    pprBatchPushKernel<<<NB, NT>>>(P->d_denseVal_, R.d_denseVal_,
+        T_mat.d_denseVal_, d_dinv, d_cols, ncols, static_cast<T>(alpha),
+        static_cast<T>((1. - alpha)/2.), A_nrows, nseeds);
+
+    // R = R + A^T * T over active columns
+    CHECK(spmmCuda(&R, changed.data(), cols, plus<T>(),
+        PlusMultipliesSemiring<a, T, T>(), A, use_tran, &T_mat, desc));
+
+    CUDA_CALL(cudaMemset(d_active, 0, ncols*sizeof(int)));
+    pprBatchActiveKernel<<<NB, NT>>>(d_active, R.d_denseVal_, d_deps, d_cols,
+        ncols, A_nrows, nseeds);
+    CUDA_CALL(cudaMemcpy(active.data(), d_active, ncols*sizeof(int),
+        cudaMemcpyDeviceToHost));
+
+    Index nactive = 0;
+    for (Index k = 0; k < ncols; ++k)
+      if (active[k])
+        cols[nactive++] = cols[k];
+    cols.resize(nactive);
+    if (desc->debug())
+      std::cout << "ppr batch " << iter << ": " << nactive << "/" << nseeds
+          << " seeds active\n";
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "ppr batch, " << iter - 1 << " rounds\n";
+  CHECK(R.clear());
+  CHECK(T_mat.clear());
+  P->need_update_ = true;
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Approximate push variant on the CPU, as lgc does for one seed. Each seed's
+ * residual and PageRank are sparse, kept in its own hash map of the shared
+ * r and p tables, so work depends on 1/eps rather than on A_nrows. Seeds are
+ * spread over threads and each seed's maps are only touched by its thread.
+ */
+template <typename T, typename a>
+Info pprPushCpu(DenseMatrix<T>*        P,
+                const SparseMatrix<a>* A,
+                bool                   use_tran,
+                const Index*           seeds,
+                Index                  nseeds,
+                double                 alpha,
+                double                 eps,
+                Descriptor*            desc) {
+  const T alpha_t = static_cast<T>(alpha);
+  const T scale   = static_cast<T>((1. - alpha)/2.);
+  CHECK(spmvCpuSetup(A));
+
+  std::vector<T> d_inv;
+  std::vector<T> d_eps;
+  pprDegrees(&d_inv, &d_eps, A, use_tran, eps);
+
+  std::vector<std::unordered_map<Index, T> > r(nseeds);
+  std::vector<std::unordered_map<Index, T> > p(nseeds);
+  Index npushes = 0;
+
+  #pragma omp parallel reduction(+:npushes)
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+    std::deque<Index>  queue;
+
+    #pragma omp for schedule(dynamic, 1)
+    for (Index j = 0; j < nseeds; ++j) {
+      std::unordered_map<Index, T>& r_j = r[j];
+      std::unordered_map<Index, T>& p_j = p[j];
+      r_j[seeds[j]] = static_cast<T>(1);
+      queue.assign(1, seeds[j]);
+
+      // Every vertex with r(v) > d(v)*eps is in the queue
+      while (!queue.empty()) {
+        Index u = queue.front();
+        queue.pop_front();
+        T r_u = r_j[u];
+        if (r_u <= d_eps[u])
+          continue;
+        npushes++;
+        if (d_inv[u] == 0) {
+          p_j[u] += r_u;
+          r_j[u]  = static_cast<T>(0);
+          continue;
+        }
+
+        p_j[u] += alpha_t*r_u;
+        r_j[u]  = scale*r_u;
+        if (r_j[u] > d_eps[u])
+          queue.push_back(u);
+        T share = scale*r_u*d_inv[u];
+        for (Index k = A_csrRowPtr[u]; k < A_csrRowPtr[u+1]; ++k) {
+          Index v   = A_csrColInd[k];
+          T&    r_v = r_j[v];
+          T     old = r_v;
+          r_v += static_cast<T>(A_csrVal[k])*share;
+          if (old <= d_eps[v] && r_v > d_eps[v])
+            queue.push_back(v);
+        }
+      }
+    }
+
+    // Scatter into the dense result
+    #pragma omp for schedule(dynamic, 1)
+    for (Index j = 0; j < nseeds; ++j) {
+      for (Index row = 0; row < A->nrows_; ++row)
+        P->h_denseVal_[static_cast<size_t>(row)*nseeds + j] =
+            static_cast<T>(0);
+      for (typename std::unordered_map<Index, T>::const_iterator it =
+          p[j].begin(); it != p[j].end(); ++it)
+        P->h_denseVal_[static_cast<size_t>(it->first)*nseeds + j] =
+            it->second;
+    }
+  }
+
+  if (desc->timing_ > 0)
+    std::cout << "ppr push, " << npushes << " pushes\n";
+  CHECK(P->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+// Residual, PageRank and weighted degree of one vertex touched by lgcPushCpu
+template <typename T>
+struct LgcEntry {
+  T r;
+  T p;
+  T d;
+};
+
+// Entry of v, reading its row for the degree the first time v is touched
+template <typename T, typename a>
+LgcEntry<T>& lgcEntry(std::unordered_map<Index, LgcEntry<T> >* state,
+                      Index                                    v,
+                      const Index*                             A_csrRowPtr,
+                      const a*                                 A_csrVal) {
+  typename std::unordered_map<Index, LgcEntry<T> >::iterator it =
+      state->find(v);
+  if (it != state->end())
+    return it->second;
+  LgcEntry<T> entry = {static_cast<T>(0), static_cast<T>(0),
+      static_cast<T>(0)};
+  for (Index j = A_csrRowPtr[v]; j < A_csrRowPtr[v+1]; ++j)
+    entry.d += static_cast<T>(A_csrVal[j]);
+  return (*state)[v] = entry;
+}
+
+/*!
+ * ACL push for one seed s on the CPU, with the updates of algorithm::lgc.
+ * Residual, PageRank and degree live in one hash map holding only touched
+ * vertices, degrees are read from a vertex's row when it is first touched,
+ * and a FIFO queue holds the vertices with r(v) > d(v)*eps. Work and memory
+ * are proportional to the volume of the touched vertices, not to A_nrows.
+ * p is sparse, sorted by index.
+ */
+template <typename T, typename a>
+Info lgcPushCpu(SparseVector<T>*       p,
+                const SparseMatrix<a>* A,
+                bool                   use_tran,
+                Index                  s,
+                double                 alpha,
+                double                 eps,
+                Descriptor*            desc) {
+  const T alpha_t = static_cast<T>(alpha);
+  const T scale   = static_cast<T>((1. - alpha)/2.);
+  const T eps_t   = static_cast<T>(eps);
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  std::unordered_map<Index, LgcEntry<T> > state;
+  lgcEntry<T>(&state, s, A_csrRowPtr, A_csrVal).r = static_cast<T>(1);
+  std::deque<Index> queue(1, s);
+  Index npushes = 0;
+  Index volume  = 0;
+
+  while (!queue.empty()) {
+    Index u = queue.front();
+    queue.pop_front();
+    LgcEntry<T>& e_u = state[u];
+    T r_u = e_u.r;
+    if (r_u <= e_u.d*eps_t)
+      continue;
+    npushes++;
+    if (e_u.d == 0) {
+      e_u.p += r_u;
+      e_u.r  = static_cast<T>(0);
+      continue;
+    }
+
+    e_u.p += alpha_t*r_u;
+    e_u.r  = scale*r_u;
+    if (e_u.r > e_u.d*eps_t)
+      queue.push_back(u);
+    T share = scale*r_u/e_u.d;
+    volume += A_csrRowPtr[u+1] - A_csrRowPtr[u];
+    for (Index k = A_csrRowPtr[u]; k < A_csrRowPtr[u+1]; ++k) {
+      Index        v   = A_csrColInd[k];
+      LgcEntry<T>& e_v = lgcEntry<T>(&state, v, A_csrRowPtr, A_csrVal);
+      T            old = e_v.r;
+      e_v.r += static_cast<T>(A_csrVal[k])*share;
+      if (old <= e_v.d*eps_t && e_v.r > e_v.d*eps_t)
+        queue.push_back(v);
+    }
+  }
+
+  std::vector<std::pair<Index, T> > result;
+  for (typename std::unordered_map<Index, LgcEntry<T> >::const_iterator it =
+      state.begin(); it != state.end(); ++it)
+    if (it->second.p != 0)
+      result.push_back(std::make_pair(it->first, it->second.p));
+  std::sort(result.begin(), result.end());
+  for (Index i = 0; i < result.size(); ++i) {
+    p->h_ind_[i] = result[i].first;
+    p->h_val_[i] = result[i].second;
+  }
+  p->nvals_ = result.size();
+
+  if (desc->timing_ > 0)
+    std::cout << "lgc push, " << npushes << " pushes, " << volume
+        << " edges, " << state.size() << " vertices touched\n";
+  CHECK(p->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_PPR_HPP_
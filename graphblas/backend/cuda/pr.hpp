@@ -0,0 +1,131 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_PR_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_PR_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Atomically adds val to *addr. Returns the old value.
+template <typename T>
+inline T prAtomicAdd(T* addr, T val) {
+  T old;
+  __atomic_load(addr, &old, __ATOMIC_RELAXED);
+  T sum = old + val;
+  while (!__atomic_compare_exchange(addr, &old, &sum, true, __ATOMIC_RELAXED,
+      __ATOMIC_RELAXED))
+    sum = old + val;
+  return old;
+}
+
+/*!
+ * Residual-push PageRank on the CPU with in-place (Gauss-Seidel) updates.
+ * A is alpha*A/outdegree as for pr. Every vertex starts with residual
+ * (1-alpha)/n. Pushing u moves its residual into p(u) and adds A(u,v) times
+ * it to the residual of each out-neighbour v right away, so later pushes in
+ * the same sweep already see it. Vertices join the next worklist when their
+ * residual rises above eps.
+ *
+ * Dangling vertices spread alpha times their residual over all vertices. That
+ * mass is pooled and added to every residual once it is worth more than eps
+ * per vertex. Any smaller remainder goes into p at the end.
+ */
+template <typename T, typename a>
+Info pageRankPushCpu(DenseVector<T>*        p,
+                     const SparseMatrix<a>* A,
+                     bool                   use_tran,
+                     double                 alpha,
+                     double                 eps,
+                     Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  const T     tol     = static_cast<T>(eps);
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+  T* p_val = p->h_val_;
+  std::fill(p_val, p_val + A_nrows, static_cast<T>(0));
+  std::vector<T> r(A_nrows, static_cast<T>((1. - alpha)/A_nrows));
+
+  std::vector<Index> worklist(A_nrows);
+  for (Index i = 0; i < A_nrows; ++i)
+    worklist[i] = i;
+  std::vector<Index> next;
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > next_t(nthreads);
+
+  double dangling = 0.;
+  Index  iter;
+  for (iter = 1; iter <= desc->max_niter_; ++iter) {
+    double dangling_iter = 0.;
+
+    #pragma omp parallel reduction(+:dangling_iter)
+    {
+      const int tid = threadId();
+
+      #pragma omp for schedule(dynamic, 64) nowait
+      for (Index k = 0; k < worklist.size(); ++k) {
+        Index u = worklist[k];
+        T     r_u;
+        __atomic_load(&r[u], &r_u, __ATOMIC_RELAXED);
+        if (r_u <= tol)
+          continue;
+        T zero = static_cast<T>(0);
+        __atomic_exchange(&r[u], &zero, &r_u, __ATOMIC_RELAXED);
+        prAtomicAdd(&p_val[u], r_u);
+
+        if (A_csrRowPtr[u] == A_csrRowPtr[u+1])
+          dangling_iter += alpha*r_u;
+        for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+          Index v   = A_csrColInd[j];
+          T     add = static_cast<T>(A_csrVal[j])*r_u;
+          T     old = prAtomicAdd(&r[v], add);
+          if (old <= tol && old + add > tol)
+            next_t[tid].push_back(v);
+        }
+      }
+    }
+
+    next.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      next.insert(next.end(), next_t[t].begin(), next_t[t].end());
+      next_t[t].clear();
+    }
+
+    // Spread pooled dangling mass once it matters per vertex
+    dangling += dangling_iter;
+    if (dangling/A_nrows > eps) {
+      T share = static_cast<T>(dangling/A_nrows);
+      dangling = 0.;
+      next.clear();
+      for (Index i = 0; i < A_nrows; ++i) {
+        r[i] += share;
+        if (r[i] > tol)
+          next.push_back(i);
+      }
+    }
+
+    if (desc->debug())
+      std::cout << "pr push " << iter << ": " << worklist.size()
+          << " pushed, " << next.size() << " active\n";
+    if (next.empty())
+      break;
+    worklist.swap(next);
+  }
+
+  for (Index i = 0; i < A_nrows; ++i)
+    p_val[i] += static_cast<T>(dangling/A_nrows);
+  if (desc->timing_ > 0)
+    std::cout << "pr push, " << iter << " sweeps\n";
+  CHECK(p->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_PR_HPP_
@@ -49,6 +49,26 @@ Info reduceCommon(T*          val,
   return GrB_SUCCESS;
 }
 
+// Monoids whose structure-only reduce is read off the nonzero count: Plus
+// counts the nonzeroes and LogicalOr tests for any
+template <typename MonoidT>
+struct StrucOnlyCount {
+  static const bool kCount = false;
+  static const bool kAny   = false;
+};
+
+template <typename T_out>
+struct StrucOnlyCount<PlusMonoid<T_out> > {
+  static const bool kCount = true;
+  static const bool kAny   = false;
+};
+
+template <typename T_out>
+struct StrucOnlyCount<LogicalOrMonoid<T_out> > {
+  static const bool kCount = false;
+  static const bool kAny   = true;
+};
+
 // Dense vector variant
 template <typename T, typename U,
           typename BinaryOpT, typename MonoidT>
@@ -57,6 +77,20 @@ Info reduceInner(T*                     val,
                  MonoidT                op,
                  const DenseVector<U>*  u,
                  Descriptor*            desc) {
+  // Structure-only Plus or LogicalOr on the CPU is a popcount of the packed
+  // words. Every other monoid needs the values
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (desc->struconly() && backend == GrB_SEQUENTIAL &&
+      (StrucOnlyCount<MonoidT>::kCount || StrucOnlyCount<MonoidT>::kAny)) {
+    DenseVector<U>* u_t = const_cast<DenseVector<U>*>(u);
+    Index count;
+    CHECK(u_t->packBits());
+    CHECK(u->countBits(&count));
+    *val = (StrucOnlyCount<MonoidT>::kAny) ? static_cast<T>(count > 0) :
+        static_cast<T>(count);
+    return GrB_SUCCESS;
+  }
   return reduceCommon(val, accum, op, u->d_val_, u->nvals_, desc);
 }
 
@@ -112,8 +146,32 @@ Info reduceInner(DenseVector<W>*        w,
                  MonoidT                op,
                  const SparseMatrix<a>* A,
                  Descriptor*            desc) {
+  Desc_value backend;
+  CHECK(desc->get(GrB_BACKEND, &backend));
+
   // TODO(@ctcyang): Structure-only optimization uses CSR row pointers
   if (desc->struconly()) {
+  } else if (backend == GrB_SEQUENTIAL) {
+    // Row-wise on the host, with the same thread split as spmvCpu
+    CHECK(spmvCpuSetup(A));
+    W* w_val = w->h_val_;
+    #pragma omp parallel
+    {
+      const Index* A_csrRowPtr;
+      const Index* A_csrColInd;
+      const a*     A_csrVal;
+      spmvCpuArrays(A, false, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+      #pragma omp for schedule(static)
+      for (Index row = 0; row < A->nrows_; ++row) {
+        W val = op.identity();
+        for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j)
+          val = op(val, A_csrVal[j]);
+        w_val[row] = val;
+      }
+    }
+    w->nnz_ = A->nrows_;
+    return w->cpuToGpu();
   } else {
     // Cannot use mgpu, because BinaryOps and Monoids do not satisfy
     // first_argument_type requirement for mgpu ops
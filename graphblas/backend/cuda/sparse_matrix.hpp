@@ -30,8 +30,13 @@ class SparseMatrix {
         d_csrRowPtr_(NULL), d_csrColInd_(NULL), d_csrVal_(NULL),
         d_cscColPtr_(NULL), d_cscRowInd_(NULL), d_cscVal_(NULL),
         need_update_(0), csr_initialized_(false), csc_initialized_(false),
-        csr_ownership_(false), csc_ownership_(false), symmetric_(0) {
+        csr_ownership_(false), csc_ownership_(false), symmetric_(0),
+        ref_count_(NULL) {
     format_ = getEnv("GRB_SPARSE_MATRIX_FORMAT", GrB_SPARSE_MATRIX_CSRCSC);
+    numa_policy_ = getEnv("GRB_NUMA_POLICY", GrB_NUMA_FIRSTTOUCH);
+    nrows_node_  = 0;
+    ncols_node_  = 0;
+    nvals_node_  = 0;
   }
 
   explicit SparseMatrix(Index nrows, Index ncols)
@@ -41,8 +46,13 @@ class SparseMatrix {
         d_csrRowPtr_(NULL), d_csrColInd_(NULL), d_csrVal_(NULL),
         d_cscColPtr_(NULL), d_cscRowInd_(NULL), d_cscVal_(NULL),
         need_update_(0), csr_initialized_(false), csc_initialized_(false),
-        csr_ownership_(false), csc_ownership_(false), symmetric_(0) {
+        csr_ownership_(false), csc_ownership_(false), symmetric_(0),
+        ref_count_(NULL) {
     format_ = getEnv("GRB_SPARSE_MATRIX_FORMAT", GrB_SPARSE_MATRIX_CSRCSC);
+    numa_policy_ = getEnv("GRB_NUMA_POLICY", GrB_NUMA_FIRSTTOUCH);
+    nrows_node_  = 0;
+    ncols_node_  = 0;
+    nvals_node_  = 0;
   }
 
   ~SparseMatrix();
@@ -95,6 +105,13 @@ class SparseMatrix {
   template <typename U>
   Info fillAscending(Index axis, Index nvals, U start);
 
+  // Copy-on-write sharing: share() aliases all of rhs's arrays in O(1),
+  // detach() makes a private deep copy before this matrix is written to.
+  // detach(false) allocates fresh arrays instead when the write overwrites
+  // the whole matrix.
+  Info share(const SparseMatrix* rhs);
+  Info detach(bool copy = true);
+
  private:
   Info allocateCpu();
   Info allocateGpu();
@@ -107,6 +124,11 @@ class SparseMatrix {
 
   Info syncCpu();   // synchronizes CSR and CSC representations
 
+  Info replicateCpu();   // copies host arrays to every NUMA node
+  Info clearReplicas();  // must be called whenever host arrays change
+
+  Info release();  // drops this reference, frees arrays if it was the last
+
  private:
   const T kcap_ratio_    = 1.2f;  // Note: nasty bug if this is set to 1.f!
   const T kresize_ratio_ = 1.2f;
@@ -163,23 +185,54 @@ class SparseMatrix {
   bool symmetric_;
 
   SparseMatrixFormat format_;
+
+  // Read-only per-node copies of the host arrays indexed by NUMA node. Only
+  // built when GRB_NUMA_POLICY=REPLICATE and there is more than one node.
+  NumaPolicy          numa_policy_;
+  Index               nrows_node_;  // nrows_ at time of replication
+  Index               ncols_node_;  // ncols_ at time of replication
+  Index               nvals_node_;  // nvals_ at time of replication
+  std::vector<Index*> h_csrRowPtr_node_;
+  std::vector<Index*> h_csrColInd_node_;
+  std::vector<T*>     h_csrVal_node_;
+  std::vector<Index*> h_cscColPtr_node_;
+  std::vector<Index*> h_cscRowInd_node_;
+  std::vector<T*>     h_cscVal_node_;
+
+  // Number of SparseMatrix objects sharing the arrays above through share().
+  // NULL if the arrays are not shared.
+  int* ref_count_;
 };
 
 template <typename T>
 SparseMatrix<T>::~SparseMatrix() {
-  if (csr_ownership_) {
-    if (h_csrRowPtr_) free(h_csrRowPtr_);
-    if (h_csrColInd_) free(h_csrColInd_);
-    if (h_csrVal_   ) free(h_csrVal_);
+  release();
+}
+
+template <typename T>
+Info SparseMatrix<T>::release() {
+  CHECK(clearReplicas());
+
+  bool last = true;
+  if (ref_count_ != NULL) {
+    last = (--(*ref_count_) == 0);
+    if (last) delete ref_count_;
+    ref_count_ = NULL;
+  }
+
+  if (last && csr_ownership_) {
+    if (h_csrRowPtr_) hostFree(h_csrRowPtr_);
+    if (h_csrColInd_) hostFree(h_csrColInd_);
+    if (h_csrVal_   ) hostFree(h_csrVal_);
     if (d_csrRowPtr_) CUDA_CALL(cudaFree(d_csrRowPtr_));
     if (d_csrColInd_) CUDA_CALL(cudaFree(d_csrColInd_));
     if (d_csrVal_   ) CUDA_CALL(cudaFree(d_csrVal_   ));
   }
 
-  if (csc_ownership_ && format_ == GrB_SPARSE_MATRIX_CSRCSC) {
-    if (h_cscColPtr_) free(h_cscColPtr_);
-    if (h_cscRowInd_) free(h_cscRowInd_);
-    if (h_cscVal_   ) free(h_cscVal_);
+  if (last && csc_ownership_ && format_ == GrB_SPARSE_MATRIX_CSRCSC) {
+    if (h_cscColPtr_) hostFree(h_cscColPtr_);
+    if (h_cscRowInd_) hostFree(h_cscRowInd_);
+    if (h_cscVal_   ) hostFree(h_cscVal_);
     if (d_cscVal_   ) CUDA_CALL(cudaFree(d_cscVal_));
 
     if (!symmetric_) {
@@ -187,10 +240,25 @@ SparseMatrix<T>::~SparseMatrix() {
       if (d_cscRowInd_) CUDA_CALL(cudaFree(d_cscRowInd_));
     }
   }
+
+  h_csrRowPtr_ = NULL;
+  h_csrColInd_ = NULL;
+  h_csrVal_    = NULL;
+  h_cscColPtr_ = NULL;
+  h_cscRowInd_ = NULL;
+  h_cscVal_    = NULL;
+  d_csrRowPtr_ = NULL;
+  d_csrColInd_ = NULL;
+  d_csrVal_    = NULL;
+  d_cscColPtr_ = NULL;
+  d_cscRowInd_ = NULL;
+  d_cscVal_    = NULL;
+  return GrB_SUCCESS;
 }
 
 template <typename T>
 Info SparseMatrix<T>::nnew(Index nrows, Index ncols) {
+  CHECK(clearReplicas());
   nrows_ = nrows;
   ncols_ = ncols;
 
@@ -203,6 +271,10 @@ template <typename T>
 Info SparseMatrix<T>::dup(const SparseMatrix* rhs) {
   if (nrows_ != rhs->nrows_) return GrB_DIMENSION_MISMATCH;
   if (ncols_ != rhs->ncols_) return GrB_DIMENSION_MISMATCH;
+
+  // Deep copy must not write into arrays still shared with another matrix
+  if (ref_count_ != NULL && rhs->d_csrVal_ != d_csrVal_)
+    CHECK(release());
   nvals_     = rhs->nvals_;
   symmetric_ = rhs->symmetric_;
   format_    = rhs->format_;
@@ -224,6 +296,9 @@ Info SparseMatrix<T>::dup(const SparseMatrix* rhs) {
           (ncols_+1)*sizeof(Index), cudaMemcpyDeviceToDevice));
       CUDA_CALL(cudaMemcpy(d_cscRowInd_, rhs->d_cscRowInd_,
           nvals_*sizeof(Index), cudaMemcpyDeviceToDevice));
+    } else {
+      d_cscColPtr_ = d_csrRowPtr_;
+      d_cscRowInd_ = d_csrColInd_;
     }
     csc_initialized_ = true;
     csc_ownership_ = true;
@@ -237,12 +312,17 @@ Info SparseMatrix<T>::dup(const SparseMatrix* rhs) {
 
 template <typename T>
 Info SparseMatrix<T>::clear() {
+  CHECK(clearReplicas());
   nvals_     = 0;
   ncapacity_ = 0;
 
-  if (h_csrRowPtr_) free(h_csrRowPtr_);
-  if (h_csrColInd_) free(h_csrColInd_);
-  if (h_csrVal_   ) free(h_csrVal_);
+  // Arrays shared with another matrix are left to that matrix
+  if (ref_count_ != NULL)
+    return release();
+
+  if (h_csrRowPtr_) hostFree(h_csrRowPtr_);
+  if (h_csrColInd_) hostFree(h_csrColInd_);
+  if (h_csrVal_   ) hostFree(h_csrVal_);
   if (d_csrRowPtr_) CUDA_CALL(cudaFree(d_csrRowPtr_));
   if (d_csrColInd_) CUDA_CALL(cudaFree(d_csrColInd_));
   if (d_csrVal_   ) CUDA_CALL(cudaFree(d_csrVal_));
@@ -255,9 +335,9 @@ Info SparseMatrix<T>::clear() {
   d_csrVal_    = NULL;
 
   if (format_ == GrB_SPARSE_MATRIX_CSRCSC) {
-    if (h_cscColPtr_) free(h_cscColPtr_);
-    if (h_cscRowInd_) free(h_cscRowInd_);
-    if (h_cscVal_   ) free(h_cscVal_);
+    if (h_cscColPtr_) hostFree(h_cscColPtr_);
+    if (h_cscRowInd_) hostFree(h_cscRowInd_);
+    if (h_cscVal_   ) hostFree(h_cscVal_);
     if (d_cscVal_   ) CUDA_CALL(cudaFree(d_cscVal_));
 
     if (!symmetric_) {
@@ -294,6 +374,8 @@ Info SparseMatrix<T>::build(const std::vector<Index>* row_indices,
                             Index                     nvals,
                             BinaryOpT                 dup,
                             char*                     dat_name) {
+  if (ref_count_ != NULL)
+    CHECK(release());
   nvals_ = nvals;
   CHECK(allocateCpu());
 
@@ -310,9 +392,9 @@ Info SparseMatrix<T>::build(const std::vector<Index>* row_indices,
 
   if (format_ == GrB_SPARSE_MATRIX_CSRONLY) {
     //if (symmetric_ || format_ == GrB_SPARSE_MATRIX_CSRONLY) {
-    if (h_cscColPtr_ != NULL) free(h_cscColPtr_);
-    if (h_cscRowInd_ != NULL) free(h_cscRowInd_);
-    if (h_cscVal_    != NULL) free(h_cscVal_);
+    if (h_cscColPtr_ != NULL) hostFree(h_cscColPtr_);
+    if (h_cscRowInd_ != NULL) hostFree(h_cscRowInd_);
+    if (h_cscVal_    != NULL) hostFree(h_cscVal_);
     h_cscColPtr_ = h_csrRowPtr_;
     h_cscRowInd_ = h_csrColInd_;
     h_cscVal_    = h_csrVal_;
@@ -324,6 +406,8 @@ Info SparseMatrix<T>::build(const std::vector<Index>* row_indices,
   }
   csr_initialized_ = true;
   csr_ownership_ = true;
+  printPageStats("csrColInd", h_csrColInd_);
+  printPageStats("csrVal", h_csrVal_);
 
   if (dat_name != NULL) {
     if (!exists(dat_name)) {
@@ -352,39 +436,72 @@ Info SparseMatrix<T>::build(const std::vector<Index>* row_indices,
 
 template <typename T>
 Info SparseMatrix<T>::build(char* dat_name) {
+  if (ref_count_ != NULL)
+    CHECK(release());
   if (dat_name != NULL && exists(dat_name)) {
     // The size of the file in bytes is in results.st_size
-    // -unserialize vector
-    std::ifstream ifs(dat_name, std::ios::in | std::ios::binary);
-    if (ifs.fail()) {
+    // -unserialize vector from a read-only mapping of the file
+    size_t file_size = 0;
+    char*  file = reinterpret_cast<char*>(mmapFile(dat_name, &file_size));
+    if (file == NULL) {
       std::cout << "Error: Unable to open file for reading!\n";
     } else {
       printf("Reading %s\n", dat_name);
+      printPageStats("graph file", file);
       char* pch = strstr(dat_name, ".ud.");
       if (pch == NULL)
         symmetric_ = false;
       else
         symmetric_ = true;
 
-      ifs.read(reinterpret_cast<char*>(&nrows_), sizeof(Index));
+      // Header words nrows and nvals, then nrows+1 row pointers and nvals
+      // column indices. Check them all fit before reading any of them
+      Index file_nrows = -1;
+      Index file_nvals = -1;
+      if (file_size >= 2*sizeof(Index)) {
+        memcpy(&file_nrows, file, sizeof(Index));
+        memcpy(&file_nvals, file + sizeof(Index), sizeof(Index));
+      }
+      const Index* file_rowptr = reinterpret_cast<const Index*>(
+          file + 2*sizeof(Index));
+      if (file_nrows < 0 || file_nvals < 0 ||
+          file_size < (static_cast<size_t>(file_nrows) + file_nvals + 3)*
+          sizeof(Index) || file_rowptr[file_nrows] != file_nvals) {
+        std::cout << "Error: Binary file is truncated!\n";
+        munmapFile(file, file_size);
+        free(dat_name);
+        return GrB_INVALID_VALUE;
+      }
+
+      nrows_ = file_nrows;
+      nvals_ = file_nvals;
       if (ncols_ != nrows_)
         std::cout << "Error: nrows not equal to ncols!\n";
-      ifs.read(reinterpret_cast<char*>(&nvals_), sizeof(Index));
       CHECK(allocateCpu());
+      const Index* file_colind = file_rowptr + nrows_ + 1;
+
+      // Copy by rows under the same static schedule as coo2csr() so pages are
+      // first-touched by the thread that later processes those rows
+      #pragma omp parallel for schedule(static)
+      for (Index row = 0; row < nrows_; row++) {
+        h_csrRowPtr_[row] = file_rowptr[row];
+        for (Index i = file_rowptr[row]; i < file_rowptr[row+1]; i++)
+          h_csrColInd_[i] = file_colind[i];
+      }
+      h_csrRowPtr_[nrows_] = file_rowptr[nrows_];
+      munmapFile(file, file_size);
 
-      ifs.read(reinterpret_cast<char*>(h_csrRowPtr_),
-          (nrows_+1)*sizeof(Index));
-
-      ifs.read(reinterpret_cast<char*>(h_csrColInd_),
-          nvals_*sizeof(Index));
-
-      for (Index i = 0; i < nvals_; i++)
-        h_csrVal_[i] = static_cast<T>(1);
+      #pragma omp parallel for schedule(static)
+      for (Index row = 0; row < nrows_; row++)
+        for (Index i = h_csrRowPtr_[row]; i < h_csrRowPtr_[row+1]; i++)
+          h_csrVal_[i] = static_cast<T>(1);
+      printPageStats("csrColInd", h_csrColInd_);
+      printPageStats("csrVal", h_csrVal_);
 
       if (format_ == GrB_SPARSE_MATRIX_CSRONLY) {
-        if (h_cscColPtr_ != NULL) free(h_cscColPtr_);
-        if (h_cscRowInd_ != NULL) free(h_cscRowInd_);
-        if (h_cscVal_    != NULL) free(h_cscVal_);
+        if (h_cscColPtr_ != NULL) hostFree(h_cscColPtr_);
+        if (h_cscRowInd_ != NULL) hostFree(h_cscRowInd_);
+        if (h_cscVal_    != NULL) hostFree(h_cscVal_);
         h_cscColPtr_ = h_csrRowPtr_;
         h_cscRowInd_ = h_csrColInd_;
         h_cscVal_    = h_csrVal_;
@@ -419,6 +536,8 @@ Info SparseMatrix<T>::build(Index* row_ptr,
                             Index* col_ind,
                             T*     values,
                             Index  nvals) {
+  if (ref_count_ != NULL)
+    CHECK(release());
   d_csrRowPtr_ = row_ptr;
   d_csrColInd_ = col_ind;
   d_csrVal_ = values;
@@ -552,12 +671,14 @@ Info SparseMatrix<T>::check() {
 
 template <typename T>
 Info SparseMatrix<T>::setNrows(Index nrows) {
+  CHECK(clearReplicas());
   nrows_ = nrows;
   return GrB_SUCCESS;
 }
 
 template <typename T>
 Info SparseMatrix<T>::setNcols(Index ncols) {
+  CHECK(clearReplicas());
   ncols_ = ncols;
   return GrB_SUCCESS;
 }
@@ -586,6 +707,7 @@ Info SparseMatrix<T>::getSymmetry(bool* symmetry) const {
 //      -this one accounts for smaller nrows
 template <typename T>
 Info SparseMatrix<T>::resize(Index nrows, Index ncols) {
+  CHECK(clearReplicas());
   if (nrows <= nrows_)
     nrows_ = nrows;
   else
@@ -601,6 +723,7 @@ Info SparseMatrix<T>::resize(Index nrows, Index ncols) {
 template <typename T>
 template <typename U>
 Info SparseMatrix<T>::fill(Index axis, Index nvals, U start) {
+  CHECK(detach());
   CHECK(setNvals(nvals));
   CHECK(allocate());
 
@@ -622,6 +745,7 @@ Info SparseMatrix<T>::fill(Index axis, Index nvals, U start) {
 template <typename T>
 template <typename U>
 Info SparseMatrix<T>::fillAscending(Index axis, Index nvals, U start) {
+  CHECK(detach());
   CHECK(setNvals(nvals));
   CHECK(allocate());
 
@@ -640,21 +764,87 @@ Info SparseMatrix<T>::fillAscending(Index axis, Index nvals, U start) {
   return GrB_SUCCESS;
 }
 
+// O(1) copy: alias every array of rhs and bump the shared reference count
+template <typename T>
+Info SparseMatrix<T>::share(const SparseMatrix* rhs) {
+  if (rhs == this || (rhs->d_csrVal_ == d_csrVal_ && d_csrVal_ != NULL))
+    return GrB_SUCCESS;
+  SparseMatrix* src = const_cast<SparseMatrix*>(rhs);
+  if (src->ref_count_ == NULL)
+    src->ref_count_ = new int(1);
+
+  CHECK(release());
+  nrows_           = src->nrows_;
+  ncols_           = src->ncols_;
+  nvals_           = src->nvals_;
+  ncapacity_       = src->ncapacity_;
+  nempty_          = src->nempty_;
+  h_csrRowPtr_     = src->h_csrRowPtr_;
+  h_csrColInd_     = src->h_csrColInd_;
+  h_csrVal_        = src->h_csrVal_;
+  h_cscColPtr_     = src->h_cscColPtr_;
+  h_cscRowInd_     = src->h_cscRowInd_;
+  h_cscVal_        = src->h_cscVal_;
+  d_csrRowPtr_     = src->d_csrRowPtr_;
+  d_csrColInd_     = src->d_csrColInd_;
+  d_csrVal_        = src->d_csrVal_;
+  d_cscColPtr_     = src->d_cscColPtr_;
+  d_cscRowInd_     = src->d_cscRowInd_;
+  d_cscVal_        = src->d_cscVal_;
+  need_update_     = src->need_update_;
+  csr_initialized_ = src->csr_initialized_;
+  csc_initialized_ = src->csc_initialized_;
+  csr_ownership_   = src->csr_ownership_;
+  csc_ownership_   = src->csc_ownership_;
+  symmetric_       = src->symmetric_;
+  format_          = src->format_;
+  ref_count_       = src->ref_count_;
+  (*ref_count_)++;
+  return GrB_SUCCESS;
+}
+
+// Give this matrix its own deep copy of the arrays if they are shared
+template <typename T>
+Info SparseMatrix<T>::detach(bool copy) {
+  if (ref_count_ == NULL)
+    return GrB_SUCCESS;
+  if (*ref_count_ == 1) {
+    delete ref_count_;
+    ref_count_ = NULL;
+    return GrB_SUCCESS;
+  }
+
+  if (!copy) {
+    CHECK(release());
+    return allocate();
+  }
+
+  // Hold a reference in a temporary so the arrays survive our release()
+  SparseMatrix<T> shared(nrows_, ncols_);
+  CHECK(shared.share(this));
+  CHECK(release());
+  CHECK(dup(&shared));
+  return GrB_SUCCESS;
+}
+
 template <typename T>
 Info SparseMatrix<T>::allocateCpu() {
   // Allocate
   ncapacity_ = kcap_ratio_*nvals_;
 
-  // Host malloc
+  // Host malloc (huge page backed for large arrays, see hostAlloc())
   if (nrows_ > 0 && h_csrRowPtr_ == NULL)
-    h_csrRowPtr_ = reinterpret_cast<Index*>(malloc((nrows_+1)*sizeof(Index)));
+    h_csrRowPtr_ = reinterpret_cast<Index*>(hostAlloc((nrows_+1)*
+        sizeof(Index)));
   if (nvals_ > 0 && h_csrColInd_ == NULL)
-    h_csrColInd_ = reinterpret_cast<Index*>(malloc(ncapacity_*sizeof(Index)));
+    h_csrColInd_ = reinterpret_cast<Index*>(hostAlloc(ncapacity_*
+        sizeof(Index)));
   if (nvals_ > 0 && h_csrVal_ == NULL)
-    h_csrVal_    = reinterpret_cast<T*>(malloc(ncapacity_*sizeof(T)));
+    h_csrVal_    = reinterpret_cast<T*>(hostAlloc(ncapacity_*sizeof(T)));
 
   if (ncols_ > 0 && h_cscColPtr_ == NULL) {
-    h_cscColPtr_ = reinterpret_cast<Index*>(malloc((ncols_+1)*sizeof(Index)));
+    h_cscColPtr_ = reinterpret_cast<Index*>(hostAlloc((ncols_+1)*
+        sizeof(Index)));
 
     std::cout << "Allocate " << ncols_ + 1 << std::endl;
   } else {
@@ -662,19 +852,30 @@ Info SparseMatrix<T>::allocateCpu() {
   }
 
   if (nvals_ > 0 && h_cscRowInd_ == NULL) {
-    h_cscRowInd_ = reinterpret_cast<Index*>(malloc(ncapacity_*sizeof(Index)));
+    h_cscRowInd_ = reinterpret_cast<Index*>(hostAlloc(ncapacity_*
+        sizeof(Index)));
     std::cout << "Allocate " << ncapacity_ << std::endl;
   } else {
     std::cout << "Do not allocate " << nvals_ << " " << h_cscRowInd_ << std::endl;
   }
 
   if (nvals_ > 0 && h_cscVal_ == NULL) {
-    h_cscVal_    = reinterpret_cast<T*>(malloc(ncapacity_*sizeof(T)));
+    h_cscVal_    = reinterpret_cast<T*>(hostAlloc(ncapacity_*sizeof(T)));
     std::cout << "Allocate " << ncapacity_ << std::endl;
   } else {
     std::cout << "Do not allocate " << nvals_ << " " << h_cscVal_ << std::endl;
   }
 
+  // Interleave before first-touch so pages are spread across all nodes
+  if (numa_policy_ == GrB_NUMA_INTERLEAVE) {
+    numaInterleave(h_csrRowPtr_, (nrows_+1)*sizeof(Index));
+    numaInterleave(h_csrColInd_, ncapacity_*sizeof(Index));
+    numaInterleave(h_csrVal_,    ncapacity_*sizeof(T));
+    numaInterleave(h_cscColPtr_, (ncols_+1)*sizeof(Index));
+    numaInterleave(h_cscRowInd_, ncapacity_*sizeof(Index));
+    numaInterleave(h_cscVal_,    ncapacity_*sizeof(T));
+  }
+
   // TODO(@ctcyang): does not need to be so strict since mxm may need to
   // only set storage type, but not allocate yet since nvals_ not known
   // if( h_csrRowPtr_==NULL || h_csrColInd_==NULL || h_csrVal_==NULL )
@@ -804,6 +1005,7 @@ Info SparseMatrix<T>::cpuToGpu() {
 template <typename T>
 Info SparseMatrix<T>::gpuToCpu(bool force_update) {
   if (need_update_ || force_update) {
+    CHECK(clearReplicas());
     CUDA_CALL(cudaMemcpy(h_csrRowPtr_, d_csrRowPtr_, (nrows_+1)*sizeof(Index),
         cudaMemcpyDeviceToHost));
     CUDA_CALL(cudaMemcpy(h_csrColInd_, d_csrColInd_, nvals_*sizeof(Index),
@@ -839,6 +1041,7 @@ Info SparseMatrix<T>::gpuToCpu(bool force_update) {
 template <typename T>
 Info SparseMatrix<T>::syncCpu() {
   CHECK(allocateCpu());
+  CHECK(clearReplicas());
   if (h_csrRowPtr_ && h_csrColInd_ && h_csrVal_ && 
       h_cscColPtr_ && h_cscRowInd_ && h_cscVal_)
     csr2csc(h_cscColPtr_, h_cscRowInd_, h_cscVal_,
@@ -847,6 +1050,56 @@ Info SparseMatrix<T>::syncCpu() {
     return GrB_INVALID_OBJECT;
   return GrB_SUCCESS;
 }
+
+template <typename T>
+Info SparseMatrix<T>::replicateCpu() {
+  CHECK(clearReplicas());
+  int nnodes = numaNodes();
+  if (nnodes < 2 || h_csrRowPtr_ == NULL)
+    return GrB_SUCCESS;
+
+  bool csc_alias = (h_cscColPtr_ == h_csrRowPtr_);
+  nrows_node_ = nrows_;
+  ncols_node_ = ncols_;
+  nvals_node_ = nvals_;
+  for (int node = 0; node < nnodes; ++node) {
+    h_csrRowPtr_node_.push_back(numaReplicate(h_csrRowPtr_, nrows_+1, node));
+    h_csrColInd_node_.push_back(numaReplicate(h_csrColInd_, nvals_,   node));
+    h_csrVal_node_.push_back(   numaReplicate(h_csrVal_,    nvals_,   node));
+    if (csc_alias) {
+      h_cscColPtr_node_.push_back(h_csrRowPtr_node_.back());
+      h_cscRowInd_node_.push_back(h_csrColInd_node_.back());
+      h_cscVal_node_.push_back(   h_csrVal_node_.back());
+    } else {
+      h_cscColPtr_node_.push_back(
+          numaReplicate(h_cscColPtr_, ncols_+1, node));
+      h_cscRowInd_node_.push_back(numaReplicate(h_cscRowInd_, nvals_, node));
+      h_cscVal_node_.push_back(   numaReplicate(h_cscVal_,    nvals_, node));
+    }
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info SparseMatrix<T>::clearReplicas() {
+  for (int node = 0; node < h_csrRowPtr_node_.size(); ++node) {
+    if (h_cscColPtr_node_[node] != h_csrRowPtr_node_[node]) {
+      numaFree(h_cscColPtr_node_[node], (ncols_node_+1)*sizeof(Index));
+      numaFree(h_cscRowInd_node_[node], nvals_node_*sizeof(Index));
+      numaFree(h_cscVal_node_[node],    nvals_node_*sizeof(T));
+    }
+    numaFree(h_csrRowPtr_node_[node], (nrows_node_+1)*sizeof(Index));
+    numaFree(h_csrColInd_node_[node], nvals_node_*sizeof(Index));
+    numaFree(h_csrVal_node_[node],    nvals_node_*sizeof(T));
+  }
+  h_csrRowPtr_node_.clear();
+  h_csrColInd_node_.clear();
+  h_csrVal_node_.clear();
+  h_cscColPtr_node_.clear();
+  h_cscRowInd_node_.clear();
+  h_cscVal_node_.clear();
+  return GrB_SUCCESS;
+}
 }  // namespace backend
 }  // namespace graphblas
 
@@ -23,11 +23,11 @@ class SparseVector {
  public:
   SparseVector()
       : nsize_(0), nvals_(0), h_ind_(NULL), h_val_(NULL),
-        d_ind_(NULL), d_val_(NULL), need_update_(0) {}
+        d_ind_(NULL), d_val_(NULL), need_update_(0), ref_count_(NULL) {}
 
   explicit SparseVector(Index nsize)
       : nsize_(nsize), nvals_(0), h_ind_(NULL), h_val_(NULL),
-        d_ind_(NULL), d_val_(NULL), need_update_(0) {
+        d_ind_(NULL), d_val_(NULL), need_update_(0), ref_count_(NULL) {
     allocate();
   }
 
@@ -71,6 +71,11 @@ class SparseVector {
   Info gpuToCpu(bool force_update = false);
   Info swap(SparseVector* rhs);
 
+  // Copy-on-write sharing, see DenseVector
+  Info share(const SparseVector* rhs);
+  Info detach(bool copy = true);
+  Info release();
+
  private:
   Index  nsize_;  // 5 ways to set: (1) Vector (2) nnew (3) dup (4) resize
                   //                (5) allocate
@@ -82,14 +87,14 @@ class SparseVector {
 
   bool  need_update_;  // set to true by changing SparseVector
                        // set to false by gpuToCpu()
+
+  int*  ref_count_;    // number of SparseVectors sharing the buffers
+                       // NULL if buffers are not shared
 };
 
 template <typename T>
 SparseVector<T>::~SparseVector() {
-  if (h_ind_ != NULL) free(h_ind_);
-  if (h_val_ != NULL) free(h_val_);
-  if (d_ind_ != NULL) CUDA_CALL(cudaFree(d_ind_));
-  if (d_ind_ != NULL) CUDA_CALL(cudaFree(d_val_));
+  release();
 }
 
 template <typename T>
@@ -101,6 +106,8 @@ Info SparseVector<T>::nnew(Index nsize) {
 
 template <typename T>
 Info SparseVector<T>::dup(const SparseVector* rhs) {
+  if (ref_count_ != NULL && rhs->d_ind_ != d_ind_)
+    CHECK(release());
   nvals_ = rhs->nvals_;
   nsize_ = rhs->nsize_;
 
@@ -151,6 +158,7 @@ Info SparseVector<T>::build(const std::vector<Index>* indices,
     std::cout << "Error: SpVec Uninitialized object!\n";
     return GrB_UNINITIALIZED_OBJECT;
   }
+  CHECK(detach());
 
   nvals_ = nvals;
 
@@ -175,6 +183,8 @@ template <typename T>
 Info SparseVector<T>::build(Index* indices,
                             T*     values,
                             Index  nvals) {
+  if (ref_count_ != NULL)
+    CHECK(release());
   d_ind_ = indices;
   d_val_ = values;
   nvals_ = nvals;
@@ -186,6 +196,7 @@ Info SparseVector<T>::build(Index* indices,
 
 template <typename T>
 Info SparseVector<T>::setElement(T val, Index index) {
+  CHECK(detach());
   CHECK(gpuToCpu());
   h_ind_[nvals_] = index;
   h_val_[nvals_] = val;
@@ -241,6 +252,7 @@ const T& SparseVector<T>::operator[](Index ind) {
 // Clears and reallocates from nsize_ x 1 to nsize x 1
 template <typename T>
 Info SparseVector<T>::resize(Index nsize) {
+  CHECK(detach());
   Index* h_temp_ind = h_ind_;
   T*     h_temp_val = h_val_;
   Index* d_temp_ind = d_ind_;
@@ -278,6 +290,7 @@ Info SparseVector<T>::resize(Index nsize) {
 
 template <typename T>
 Info SparseVector<T>::fill(Index nvals) {
+  CHECK(detach());
   for (Index i = 0; i < nvals; i++)
     h_val_[i] = i;
 
@@ -409,6 +422,88 @@ Info SparseVector<T>::swap(SparseVector* rhs) {  // NOLINT(build/include_what_yo
   need_update_      = rhs->need_update_;
   rhs->need_update_ = temp_update;
 
+  int* temp_count   = ref_count_;
+  ref_count_        = rhs->ref_count_;
+  rhs->ref_count_   = temp_count;
+
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info SparseVector<T>::share(const SparseVector* rhs) {
+  if (rhs == this || (rhs->d_ind_ == d_ind_ && d_ind_ != NULL))
+    return GrB_SUCCESS;
+  SparseVector* src = const_cast<SparseVector*>(rhs);
+  if (src->ref_count_ == NULL)
+    src->ref_count_ = new int(1);
+
+  CHECK(release());
+  nsize_       = src->nsize_;
+  nvals_       = src->nvals_;
+  h_ind_       = src->h_ind_;
+  h_val_       = src->h_val_;
+  d_ind_       = src->d_ind_;
+  d_val_       = src->d_val_;
+  need_update_ = src->need_update_;
+  ref_count_   = src->ref_count_;
+  (*ref_count_)++;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info SparseVector<T>::detach(bool copy) {
+  if (ref_count_ == NULL)
+    return GrB_SUCCESS;
+  if (*ref_count_ == 1) {
+    delete ref_count_;
+    ref_count_ = NULL;
+    return GrB_SUCCESS;
+  }
+
+  Index* h_shared_ind = h_ind_;
+  T*     h_shared_val = h_val_;
+  Index* d_shared_ind = d_ind_;
+  T*     d_shared_val = d_val_;
+  (*ref_count_)--;
+  ref_count_ = NULL;
+  h_ind_     = NULL;
+  h_val_     = NULL;
+  d_ind_     = NULL;
+  d_val_     = NULL;
+
+  CHECK(allocate());
+  if (!copy)
+    return GrB_SUCCESS;
+  CUDA_CALL(cudaMemcpy(d_ind_, d_shared_ind, nvals_*sizeof(Index),
+      cudaMemcpyDeviceToDevice));
+  CUDA_CALL(cudaMemcpy(d_val_, d_shared_val, nvals_*sizeof(T),
+      cudaMemcpyDeviceToDevice));
+  if (!need_update_) {
+    memcpy(h_ind_, h_shared_ind, nvals_*sizeof(Index));
+    memcpy(h_val_, h_shared_val, nvals_*sizeof(T));
+  }
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info SparseVector<T>::release() {
+  bool last = true;
+  if (ref_count_ != NULL) {
+    last = (--(*ref_count_) == 0);
+    if (last) delete ref_count_;
+    ref_count_ = NULL;
+  }
+
+  if (last) {
+    if (h_ind_ != NULL) free(h_ind_);
+    if (h_val_ != NULL) free(h_val_);
+    if (d_ind_ != NULL) CUDA_CALL(cudaFree(d_ind_));
+    if (d_val_ != NULL) CUDA_CALL(cudaFree(d_val_));
+  }
+  h_ind_ = NULL;
+  h_val_ = NULL;
+  d_ind_ = NULL;
+  d_val_ = NULL;
   return GrB_SUCCESS;
 }
 }  // namespace backend
@@ -6,6 +6,7 @@
 #include <cuda.h>
 #include <cusparse.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -109,6 +110,118 @@ Info spgemmMasked(SparseMatrix<c>*       C,
   return GrB_SUCCESS;
 }
 
+/*!
+ * Unmasked SpGEMM on the CPU (Gustavson), used when GrB_BACKEND is
+ * GrB_SEQUENTIAL. Each thread keeps a dense accumulator and marker of
+ * length B.ncols: a symbolic pass counts each row of C, and a numeric pass
+ * fills it and sorts its column indices. accum is ignored, as on the GPU.
+ */
+template <typename c, typename a, typename b,
+          typename BinaryOpT, typename SemiringT>
+Info spgemmCpu(SparseMatrix<c>*       C,
+               BinaryOpT              accum,
+               SemiringT              op,
+               const SparseMatrix<a>* A,
+               const SparseMatrix<b>* B,
+               Descriptor*            desc) {
+  Desc_value inp0_mode, inp1_mode;
+  CHECK(desc->get(GrB_INP0, &inp0_mode));
+  CHECK(desc->get(GrB_INP1, &inp1_mode));
+  const bool  use_tran_A = inp0_mode == GrB_TRAN;
+  const bool  use_tran_B = inp1_mode == GrB_TRAN;
+  const Index A_nrows    = (use_tran_A) ? A->ncols_ : A->nrows_;
+  const Index B_ncols    = (use_tran_B) ? B->nrows_ : B->ncols_;
+  CHECK(spmvCpuSetup(A));
+  CHECK(spmvCpuSetup(B));
+
+  auto add_op = extractAdd(op);
+  auto mul_op = extractMul(op);
+  std::vector<Index> row_ptr(A_nrows+1, 0);
+  std::vector<Index> C_colInd;
+  std::vector<c>     C_val;
+
+  #pragma omp parallel
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    const Index* B_csrRowPtr;
+    const Index* B_csrColInd;
+    const b*     B_csrVal;
+    spmvCpuArrays(A, use_tran_A, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+    spmvCpuArrays(B, use_tran_B, &B_csrRowPtr, &B_csrColInd, &B_csrVal);
+    std::vector<Index> marker(B_ncols, -1);
+    std::vector<c>     acc(B_ncols);
+
+    // 1) Symbolic: nonzeroes of each row of C
+    #pragma omp for schedule(dynamic, 256)
+    for (Index row = 0; row < A_nrows; ++row) {
+      Index count = 0;
+      for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+        Index k = A_csrColInd[j];
+        for (Index l = B_csrRowPtr[k]; l < B_csrRowPtr[k+1]; ++l) {
+          Index col = B_csrColInd[l];
+          if (marker[col] != row) {
+            marker[col] = row;
+            count++;
+          }
+        }
+      }
+      row_ptr[row+1] = count;
+    }
+
+    #pragma omp single
+    {
+      for (Index row = 0; row < A_nrows; ++row)
+        row_ptr[row+1] += row_ptr[row];
+      C_colInd.resize(row_ptr[A_nrows]);
+      C_val.resize(row_ptr[A_nrows]);
+    }
+
+    // 2) Numeric: accumulate, then emit in column order
+    std::fill(marker.begin(), marker.end(), -1);
+    #pragma omp for schedule(dynamic, 256)
+    for (Index row = 0; row < A_nrows; ++row) {
+      Index* cols = C_colInd.data() + row_ptr[row];
+      Index  n    = 0;
+      for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+        Index k = A_csrColInd[j];
+        for (Index l = B_csrRowPtr[k]; l < B_csrRowPtr[k+1]; ++l) {
+          Index col = B_csrColInd[l];
+          c     val = mul_op(A_csrVal[j], B_csrVal[l]);
+          if (marker[col] != row) {
+            marker[col] = row;
+            acc[col]    = val;
+            cols[n++]   = col;
+          } else {
+            acc[col] = add_op(acc[col], val);
+          }
+        }
+      }
+      std::sort(cols, cols + n);
+      for (Index j = 0; j < n; ++j)
+        C_val[row_ptr[row] + j] = acc[cols[j]];
+    }
+  }
+
+  const Index C_nvals = row_ptr[A_nrows];
+  CHECK(C->release());
+  C->nvals_     = C_nvals;
+  C->symmetric_ = false;
+  CHECK(C->allocateCpu());
+  std::copy(row_ptr.begin(), row_ptr.end(), C->h_csrRowPtr_);
+  std::copy(C_colInd.begin(), C_colInd.end(), C->h_csrColInd_);
+  std::copy(C_val.begin(), C_val.end(), C->h_csrVal_);
+  C->csr_initialized_ = true;
+  CHECK(C->syncCpu());
+  CHECK(C->cpuToGpu());
+
+  if (desc->debug())
+    std::cout << "spgemmCpu: " << A_nrows << "x" << B_ncols << ", " << C_nvals
+        << " nonzeroes\n";
+  return GrB_SUCCESS;
+}
+
 template <typename c, typename a, typename b, typename m,
           typename BinaryOpT,     typename SemiringT>
 Info cusparse_spgemm(SparseMatrix<c>*       C,
@@ -228,12 +341,12 @@ Info cusparse_spgemm(SparseMatrix<c>*       C,
     CUDA_CALL(cudaMalloc(&C->d_csrVal_, C->ncapacity_*sizeof(c)));
 
     if (C->h_csrColInd_ != NULL) {
-      free(C->h_csrColInd_);
-      free(C->h_csrVal_);
+      hostFree(C->h_csrColInd_);
+      hostFree(C->h_csrVal_);
     }
-    C->h_csrColInd_ = reinterpret_cast<Index*>(malloc(C->ncapacity_*sizeof(
-        Index)));
-    C->h_csrVal_    = reinterpret_cast<T*>(malloc(C->ncapacity_*sizeof(T)));
+    C->h_csrColInd_ = reinterpret_cast<Index*>(hostAlloc(C->ncapacity_*
+        sizeof(Index)));
+    C->h_csrVal_    = reinterpret_cast<T*>(hostAlloc(C->ncapacity_*sizeof(T)));
   }
 
   // Compute
@@ -453,11 +566,12 @@ Info cusparse_spgemm2(SparseMatrix<float>*       C,
     CUDA_CALL(cudaMalloc(&C->d_csrVal_, C_nvals*sizeof(float)));
 
     if (C->h_csrColInd_ != NULL) {
-      free(C->h_csrColInd_);
-      free(C->h_csrVal_);
+      hostFree(C->h_csrColInd_);
+      hostFree(C->h_csrVal_);
     }
-    C->h_csrColInd_ = reinterpret_cast<Index*>(malloc(C_nvals*sizeof(Index)));
-    C->h_csrVal_    = reinterpret_cast<T*>(malloc(C_nvals*sizeof(T)));
+    C->h_csrColInd_ = reinterpret_cast<Index*>(hostAlloc(C_nvals*
+        sizeof(Index)));
+    C->h_csrVal_    = reinterpret_cast<T*>(hostAlloc(C_nvals*sizeof(T)));
 
     C->ncapacity_ = C_nvals;
   }
@@ -6,23 +6,251 @@
 
 #include <moderngpu.cuh>
 
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
 
 namespace graphblas {
 namespace backend {
 
-template <typename c, typename a, typename b, typename m,
-          typename BinaryOpT,      typename SemiringT>
+// Active columns of a column mask (all of them if mask is NULL)
+template <typename M>
+Info spmmColumns(std::vector<Index>*   cols,
+                 const DenseVector<M>* col_mask,
+                 Index                 B_ncols) {
+  cols->clear();
+  if (col_mask != NULL) {
+    CHECK(const_cast<DenseVector<M>*>(col_mask)->gpuToCpu());
+    if (col_mask->nvals_ != B_ncols)
+      return GrB_DIMENSION_MISMATCH;
+  }
+  for (Index j = 0; j < B_ncols; ++j)
+    if (col_mask == NULL || col_mask->h_val_[j] != 0)
+      cols->push_back(j);
+  return GrB_SUCCESS;
+}
+
+// Leaves set in col_mask only the columns that changed
+template <typename M>
+Info spmmChanged(DenseVector<M>*           col_mask,
+                 Index*                    nactive,
+                 const std::vector<Index>& cols,
+                 const int*                changed) {
+  Index count = 0;
+  for (Index j = 0; j < cols.size(); ++j)
+    count += (changed[j] != 0);
+  if (nactive != NULL)
+    *nactive = count;
+  if (col_mask == NULL)
+    return GrB_SUCCESS;
+  for (Index j = 0; j < cols.size(); ++j)
+    col_mask->h_val_[cols[j]] = static_cast<M>(changed[j] != 0);
+  return col_mask->cpuToGpu();
+}
+
+/*!
+ * SpMat x DeMat on the CPU
+ *   C(:, j) = C(:, j) + A * B(:, j) for active columns j    +: accum
+ *                                                          *: op
+ *
+ * Each nonzero A(row, col) is applied across row col of B in one k-wide loop.
+ * B is row-major, so when every column is active this loop runs over
+ * contiguous memory and vectorizes. Entries of B equal to the identity of op
+ * are skipped, as are empty entries in spmv. Products go to a scratch
+ * matrix before C is written, so C may be B.
+ */
+template <typename c, typename a, typename b,
+          typename BinaryOpT, typename SemiringT>
+Info spmmCpu(DenseMatrix<c>*           C,
+             int*                      changed,
+             const std::vector<Index>& cols,
+             BinaryOpT                 accum,
+             SemiringT                 op,
+             const SparseMatrix<a>*    A,
+             bool                      use_tran,
+             const DenseMatrix<b>*     B,
+             Descriptor*               desc) {
+  std::string accum_type = typeid(accum).name();
+  bool use_accum = (accum_type.size() > 1);
+
+  CHECK(spmvCpuSetup(A));
+  CHECK(const_cast<DenseMatrix<b>*>(B)->gpuToCpu());
+  CHECK(C->gpuToCpu());
+
+  const Index A_nrows  = (use_tran) ? A->ncols_ : A->nrows_;
+  const Index B_ncols  = B->ncols_;
+  const Index ncols    = cols.size();
+  const bool  all_cols = (ncols == B_ncols);
+  const b*    B_val    = B->h_denseVal_;
+  c*          C_val    = C->h_denseVal_;
+  const c     identity = op.identity();
+  auto        add_op   = extractAdd(op);
+  auto        mul_op   = extractMul(op);
+  ApplyAccum<BinaryOpT> accum_op(accum);
+
+  std::vector<c> t(static_cast<size_t>(A_nrows)*ncols);
+  std::fill(changed, changed + ncols, 0);
+
+  #pragma omp parallel
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+    std::vector<int> changed_t(ncols, 0);
+
+    #pragma omp for schedule(dynamic, 64)
+    for (Index row = 0; row < A_nrows; ++row) {
+      c* t_row = &t[static_cast<size_t>(row)*ncols];
+      std::fill(t_row, t_row + ncols, identity);
+      for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+        const a  A_val = A_csrVal[j];
+        const b* B_row = B_val + static_cast<size_t>(A_csrColInd[j])*B_ncols;
+        if (all_cols) {
+          for (Index col = 0; col < ncols; ++col)
+            t_row[col] = add_op(t_row[col], (B_row[col] == identity) ?
+                identity : mul_op(A_val, B_row[col]));
+        } else {
+          for (Index col = 0; col < ncols; ++col)
+            if (B_row[cols[col]] != identity)
+              t_row[col] = add_op(t_row[col], mul_op(A_val,
+                  B_row[cols[col]]));
+        }
+      }
+    }
+
+    // Implicit barrier: all products are in t before C is written
+    #pragma omp for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      const c* t_row = &t[static_cast<size_t>(row)*ncols];
+      c*       C_row = C_val + static_cast<size_t>(row)*B_ncols;
+      for (Index col = 0; col < ncols; ++col) {
+        c old = C_row[cols[col]];
+        c val = (use_accum) ? accum_op(old, t_row[col]) : t_row[col];
+        if (val != old) {
+          C_row[cols[col]] = val;
+          changed_t[col] = 1;
+        }
+      }
+    }
+
+    #pragma omp critical
+    for (Index col = 0; col < ncols; ++col)
+      changed[col] |= changed_t[col];
+  }
+
+  CHECK(C->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+template <typename c, typename a, typename b,
+          typename BinaryOpT, typename SemiringT>
+Info spmmCuda(DenseMatrix<c>*           C,
+              int*                      changed,
+              const std::vector<Index>& cols,
+              BinaryOpT                 accum,
+              SemiringT                 op,
+              const SparseMatrix<a>*    A,
+              bool                      use_tran,
+              const DenseMatrix<b>*     B,
+              Descriptor*               desc) {
+  std::string accum_type = typeid(accum).name();
+  bool use_accum = (accum_type.size() > 1);
+
+  const Index  A_nrows     = (use_tran) ? A->ncols_ : A->nrows_;
+  const Index* A_csrRowPtr = (use_tran) ? A->d_cscColPtr_ : A->d_csrRowPtr_;
+  const Index* A_csrColInd = (use_tran) ? A->d_cscRowInd_ : A->d_csrColInd_;
+  const a*     A_csrVal    = (use_tran) ? A->d_cscVal_    : A->d_csrVal_;
+  const Index  ncols       = cols.size();
+  const size_t nvals       = static_cast<size_t>(A_nrows)*ncols;
+
+  // Scratch products first so they stay aligned, then columns and flags
+  CHECK(desc->resize(nvals*sizeof(c) + ncols*(sizeof(Index) + sizeof(int)),
+      "buffer"));
+  c*     d_t       = reinterpret_cast<c*>(desc->d_buffer_);
+  Index* d_cols    = reinterpret_cast<Index*>(d_t + nvals);
+  int*   d_changed = reinterpret_cast<int*>(d_cols + ncols);
+  CUDA_CALL(cudaMemcpy(d_cols, cols.data(), ncols*sizeof(Index),
+      cudaMemcpyHostToDevice));
+  CUDA_CALL(cudaMemset(d_changed, 0, ncols*sizeof(int)));
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = std::min((nvals + nt - 1) / nt, static_cast<size_t>(65535));
+  NB.y = 1;
+  NB.z = 1;
+
+  spmmColumnsKernel<<<NB, NT>>>(d_t, d_cols, ncols, op.identity(),
+      extractMul(op), extractAdd(op), A_nrows, A_csrRowPtr, A_csrColInd,
+      A_csrVal, B->d_denseVal_, B->ncols_);
+  spmmAccumChangedKernel<<<NB, NT>>>(C->d_denseVal_, d_changed, d_t, d_cols,
+      ncols, use_accum, ApplyAccum<BinaryOpT>(accum), A_nrows, C->ncols_);
+  CUDA_CALL(cudaMemcpy(changed, d_changed, ncols*sizeof(int),
+      cudaMemcpyDeviceToHost));
+
+  if (desc->debug())
+    printDevice("spmm_changed", d_changed, ncols);
+  C->need_update_ = true;
+  return GrB_SUCCESS;
+}
+
+/*!
+ * SpMat x DeMat SpMM
+ *   C(:, j) = C(:, j) + A * B(:, j)    +: accum
+ *                                      *: op
+ * for the columns j set in col_mask, or all columns if col_mask is NULL. C
+ * may be B. If col_mask is given, it is left set only at the columns where C
+ * changed, and nactive (if given) gets their count.
+ */
+template <typename c, typename a, typename b, typename M,
+          typename BinaryOpT,     typename SemiringT>
 Info spmm(DenseMatrix<c>*        C,
-          const Matrix<m>*       mask,
-          const BinaryOpT*       accum,
-          const SemiringT*       op,
+          DenseVector<M>*        col_mask,
+          Index*                 nactive,
+          BinaryOpT              accum,
+          SemiringT              op,
           const SparseMatrix<a>* A,
           const DenseMatrix<b>*  B,
           Descriptor*            desc) {
-  std::cout << "SpMat x DeMat SpMM\n";
-  std::cout << "Error: Feature not implemented yet!\n";
-  return GrB_SUCCESS;
+  Desc_value inp0_mode, inp1_mode, backend;
+  CHECK(desc->get(GrB_INP0,    &inp0_mode));
+  CHECK(desc->get(GrB_INP1,    &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
+  if (inp1_mode == GrB_TRAN) {
+    std::cout << "Error: SpMM with transposed B not implemented yet!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+
+  SparseMatrixFormat A_format;
+  bool               A_symmetric;
+  CHECK(A->getFormat(&A_format));
+  CHECK(A->getSymmetry(&A_symmetric));
+  bool use_tran = (inp0_mode == GrB_TRAN) && !A_symmetric;
+  if (use_tran && A_format == GrB_SPARSE_MATRIX_CSRONLY) {
+    std::cout << "Error: SpMM needs the CSC of an asymmetric matrix!\n";
+    return GrB_NOT_IMPLEMENTED;
+  }
+  if (desc->debug())
+    std::cout << "Executing SpMM " << ((use_tran) ? "A^T" : "A") << " x "
+        << B->ncols_ << " columns\n";
+
+  std::vector<Index> cols;
+  CHECK(spmmColumns(&cols, col_mask, B->ncols_));
+  std::vector<int> changed(cols.size());
+  if (!cols.empty()) {
+    if (backend == GrB_SEQUENTIAL)
+      CHECK(spmmCpu(C, changed.data(), cols, accum, op, A, use_tran, B,
+          desc));
+    else
+      CHECK(spmmCuda(C, changed.data(), cols, accum, op, A, use_tran, B,
+          desc));
+  }
+  return spmmChanged(col_mask, nactive, cols, changed.data());
 }
 
 template <typename c, typename a, typename b, typename m,
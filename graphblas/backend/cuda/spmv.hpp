@@ -15,6 +15,243 @@
 namespace graphblas {
 namespace backend {
 
+/*!
+ * Copies A to host and sets up placement for the CPU SpMV row loop
+ */
+template <typename a>
+Info spmvCpuSetup(const SparseMatrix<a>* A) {
+  SparseMatrix<a>* A_t = const_cast<SparseMatrix<a>*>(A);
+  CHECK(A_t->gpuToCpu());
+  if (A->numa_policy_ == GrB_NUMA_REPLICATE && A->h_csrRowPtr_node_.empty())
+    CHECK(A_t->replicateCpu());
+  numaPinThreads();
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Host CSR arrays (CSC if use_tran) of A for the calling thread. If A is
+ * replicated, these are the copy on the thread's own node. A thread on a
+ * node without a replica (node ids need not be dense) reads the shared
+ * arrays.
+ */
+template <typename a>
+void spmvCpuArrays(const SparseMatrix<a>* A,
+                   bool                   use_tran,
+                   const Index**          A_csrRowPtr,
+                   const Index**          A_csrColInd,
+                   const a**              A_csrVal) {
+  *A_csrRowPtr = (use_tran) ? A->h_cscColPtr_ : A->h_csrRowPtr_;
+  *A_csrColInd = (use_tran) ? A->h_cscRowInd_ : A->h_csrColInd_;
+  *A_csrVal    = (use_tran) ? A->h_cscVal_    : A->h_csrVal_;
+  int node = numaNode();
+  if (node < A->h_csrRowPtr_node_.size()) {
+    *A_csrRowPtr = (use_tran) ? A->h_cscColPtr_node_[node] :
+        A->h_csrRowPtr_node_[node];
+    *A_csrColInd = (use_tran) ? A->h_cscRowInd_node_[node] :
+        A->h_csrColInd_node_[node];
+    *A_csrVal    = (use_tran) ? A->h_cscVal_node_[node] :
+        A->h_csrVal_node_[node];
+  }
+}
+
+/*!
+ * CPU SpMV used when GrB_BACKEND is GrB_SEQUENTIAL. Rows are split with the
+ * same static schedule coo2csr() uses for first-touch, so with the default
+ * NUMA policy each thread reads graph arrays that live on its own node. With
+ * GRB_NUMA_POLICY=2 (REPLICATE) each thread reads its node's private copy.
+ */
+template <typename W, typename a, typename U, typename M,
+          typename BinaryOpT,      typename SemiringT>
+Info spmvCpu(DenseVector<W>*        w,
+             const Vector<M>*       mask,
+             BinaryOpT              accum,
+             SemiringT              op,
+             const SparseMatrix<a>* A,
+             const DenseVector<U>*  u,
+             bool                   use_mask,
+             bool                   use_accum,
+             bool                   use_scmp,
+             bool                   use_tran,
+             Descriptor*            desc) {
+  DenseVector<U>* u_t    = const_cast<DenseVector<U>*>(u);
+  Vector<M>*      mask_t = const_cast<Vector<M>*>(mask);
+  CHECK(spmvCpuSetup(A));
+  CHECK(u_t->gpuToCpu());
+  CHECK(w->gpuToCpu());
+  const M* mask_val = NULL;
+  if (use_mask) {
+    Storage mask_vec_type;
+    CHECK(mask->getStorage(&mask_vec_type));
+    if (mask_vec_type != GrB_DENSE) {
+      std::cout << "Error: Sparse mask CPU SpMV not implemented yet!\n";
+      return GrB_NOT_IMPLEMENTED;
+    }
+    CHECK(mask_t->dense_.gpuToCpu());
+    mask_val = mask->dense_.h_val_;
+  }
+
+  const Index A_nrows = (use_tran) ? A->ncols_ : A->nrows_;
+  const U*    u_val   = u->h_val_;
+  W*          w_val   = w->h_val_;
+  auto        add_op  = extractAdd(op);
+  auto        mul_op  = extractMul(op);
+  ApplyAccum<BinaryOpT> accum_op(accum);
+
+  // MaximumSelectSecondSemiring takes any neighbour's value, so with early
+  // exit a row can stop at the first one it finds (as on the GPU)
+  const bool  use_any = desc->earlyexit() && add_op(3, 5) == 5 &&
+      mul_op(3, 5) == 5;
+
+  #pragma omp parallel
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+    #pragma omp for schedule(static)
+    for (Index row = 0; row < A_nrows; ++row) {
+      bool allowed = true;
+      if (use_mask)
+        allowed = use_scmp ? (mask_val[row] == 0) : (mask_val[row] != 0);
+      if (!allowed) {
+        if (!use_accum) w_val[row] = op.identity();
+        continue;
+      }
+
+      W val = op.identity();
+      for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+        val = add_op(val, mul_op(A_csrVal[j], u_val[A_csrColInd[j]]));
+        if (use_any && val != op.identity())
+          break;
+      }
+      w_val[row] = (use_accum) ? accum_op(w_val[row], val) : val;
+    }
+  }
+  w->nvals_ = A_nrows;
+  CHECK(w->cpuToGpu());
+  return GrB_SUCCESS;
+}
+
+/*!
+ * Boolean CPU SpMV, picked over the one above at compile time for
+ * LogicalOrAndSemiring. u, mask and w are handled as packed 64-bit words
+ * (DenseVector::packBits()), so a word of 64 rows whose mask bits are all
+ * off is skipped without touching A, the u lookups hit a bitmap 8-32x
+ * smaller than u, and the output count is a popcount kept in w->nnz_.
+ */
+template <typename W, typename a, typename U, typename M,
+          typename BinaryOpT,
+          typename T_in1,  typename T_in2, typename T_out>
+Info spmvCpu(DenseVector<W>*                           w,
+             const Vector<M>*                          mask,
+             BinaryOpT                                 accum,
+             LogicalOrAndSemiring<T_in1, T_in2, T_out> op,
+             const SparseMatrix<a>*                    A,
+             const DenseVector<U>*                     u,
+             bool                                      use_mask,
+             bool                                      use_accum,
+             bool                                      use_scmp,
+             bool                                      use_tran,
+             Descriptor*                               desc) {
+  DenseVector<U>* u_t    = const_cast<DenseVector<U>*>(u);
+  Vector<M>*      mask_t = const_cast<Vector<M>*>(mask);
+  CHECK(spmvCpuSetup(A));
+  CHECK(u_t->packBits());
+  const uint64_t* u_bits    = u->h_bits_;
+  const uint64_t* mask_bits = NULL;
+  if (use_mask) {
+    Storage mask_vec_type;
+    CHECK(mask->getStorage(&mask_vec_type));
+    if (mask_vec_type != GrB_DENSE) {
+      std::cout << "Error: Sparse mask CPU SpMV not implemented yet!\n";
+      return GrB_NOT_IMPLEMENTED;
+    }
+    CHECK(mask_t->dense_.packBits());
+    mask_bits = mask->dense_.h_bits_;
+  }
+
+  // Accumulating ORs into the current bits of w, otherwise they are rebuilt.
+  // If w's values are still the unpacking of its bits (it was the output of
+  // this kernel and nothing wrote it since), only words that change are
+  // written back to h_val_ and d_val_, and the bits buffer is reused. When
+  // u or the mask is w, its bits are read while w is written, so w gets a
+  // new buffer and the old one is freed at the end.
+  const Index A_nrows = (use_tran) ? A->ncols_ : A->nrows_;
+  const Index nwords  = (A_nrows + 63) / 64;
+  const bool  w_read  = static_cast<const void*>(u) == w || (use_mask &&
+      static_cast<const void*>(&mask->dense_) == w);
+  const bool  w_exact = !w_read && w->bits_exact_ && !w->need_update_ &&
+      w->nvals_ == A_nrows;
+  uint64_t*   w_old   = NULL;
+  w->nvals_ = A_nrows;
+  if (use_accum) {
+    CHECK(w->packBits());
+  } else if (!w_exact) {
+    if (w_read) {
+      w_old      = w->h_bits_;
+      w->h_bits_ = NULL;
+    }
+    CHECK(w->clearBits());
+    w->h_bits_ = reinterpret_cast<uint64_t*>(hostAlloc(
+        std::max(nwords, 1)*sizeof(uint64_t)));
+  }
+  uint64_t* w_bits = w->h_bits_;
+
+  Index w_nnz      = 0;
+  Index word_begin = nwords;
+  Index word_end   = 0;
+  #pragma omp parallel reduction(+:w_nnz) reduction(min:word_begin) \
+      reduction(max:word_end)
+  {
+    const Index* A_csrRowPtr;
+    const Index* A_csrColInd;
+    const a*     A_csrVal;
+    spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+
+    #pragma omp for schedule(static)
+    for (Index word = 0; word < nwords; ++word) {
+      Index    row_base = word*64;
+      Index    nbits    = std::min(static_cast<Index>(64), A_nrows - row_base);
+      uint64_t valid    = (nbits == 64) ? ~static_cast<uint64_t>(0) :
+          (static_cast<uint64_t>(1) << nbits) - 1;
+      uint64_t allowed  = valid;
+      if (use_mask)
+        allowed &= (use_scmp) ? ~mask_bits[word] : mask_bits[word];
+
+      uint64_t found = 0;
+      while (allowed != 0) {
+        int   bit = __builtin_ctzll(allowed);
+        Index row = row_base + bit;
+        allowed  &= allowed - 1;
+        for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+          Index col = A_csrColInd[j];
+          if (static_cast<bool>(A_csrVal[j]) &&
+              ((u_bits[col/64] >> (col % 64)) & 1)) {
+            found |= static_cast<uint64_t>(1) << bit;
+            break;
+          }
+        }
+      }
+      uint64_t bits = (use_accum) ? (w_bits[word] | found) : found;
+      if (!w_exact || bits != w_bits[word]) {
+        word_begin = std::min(word_begin, word);
+        word_end   = std::max(word_end, word + 1);
+      }
+      w_bits[word] = bits;
+      w_nnz += __builtin_popcountll(bits);
+    }
+  }
+  w->nnz_ = w_nnz;
+  if (w_old != NULL)
+    hostFree(w_old);
+  if (!w_exact)
+    return w->unpackBits();
+  if (word_begin < word_end)
+    return w->unpackBits(word_begin, word_end);
+  return GrB_SUCCESS;
+}
+
 template <typename W, typename a, typename U, typename M,
           typename BinaryOpT,      typename SemiringT>
 Info spmv(DenseVector<W>*        w,
@@ -24,12 +261,13 @@ Info spmv(DenseVector<W>*        w,
           const SparseMatrix<a>* A,
           const DenseVector<U>*  u,
           Descriptor*            desc) {
-  // Get descriptor parameters for SCMP, REPL, TRAN
-  Desc_value scmp_mode, repl_mode, inp0_mode, inp1_mode;
+  // Get descriptor parameters for SCMP, REPL, TRAN, BACKEND
+  Desc_value scmp_mode, repl_mode, inp0_mode, inp1_mode, backend;
   CHECK(desc->get(GrB_MASK, &scmp_mode));
   CHECK(desc->get(GrB_OUTP, &repl_mode));
   CHECK(desc->get(GrB_INP0, &inp0_mode));
   CHECK(desc->get(GrB_INP1, &inp1_mode));
+  CHECK(desc->get(GrB_BACKEND, &backend));
 
   std::string accum_type = typeid(accum).name();
   // TODO(@ctcyang): add accum and replace support
@@ -47,6 +285,10 @@ Info spmv(DenseVector<W>*        w,
     printState(use_mask, use_accum, use_scmp, use_repl, use_tran);
   }
 
+  if (backend == GrB_SEQUENTIAL)
+    return spmvCpu(w, mask, accum, op, A, u, use_mask, use_accum, use_scmp,
+        use_tran, desc);
+
   // Transpose (default is CSR):
   const Index* A_csrRowPtr = (use_tran) ? A->d_cscColPtr_ : A->d_csrRowPtr_;
   const Index* A_csrColInd = (use_tran) ? A->d_cscRowInd_ : A->d_csrColInd_;
@@ -84,6 +326,11 @@ Info spmv(DenseVector<W>*        w,
   auto add_op = extractAdd(op);
   int functor = add_op(3, 5);
 
+  // select_second(3,5) = 5, so together with atomicMax() this identifies
+  // MaximumSelectSecondSemiring
+  auto mul_op = extractMul(op);
+  int mul_functor = mul_op(3, 5);
+
   if (desc->debug()) {
     std::cout << "Fused mask: " << desc->fusedmask() << std::endl;
     std::cout << "Functor:    " << functor << std::endl;
@@ -175,6 +422,52 @@ Info spmv(DenseVector<W>*        w,
     } else {
       return GrB_UNINITIALIZED_OBJECT;
     }
+  } else if (use_mask && desc->fusedmask() && !use_accum && functor == 5 &&
+      mul_functor == 5) {
+    Storage mask_vec_type;
+    CHECK(mask->getStorage(&mask_vec_type));
+    if (mask_vec_type != GrB_DENSE)
+      return GrB_UNINITIALIZED_OBJECT;
+
+    dim3 NT, NB;
+    NT.x = nt;
+    NT.y = 1;
+    NT.z = 1;
+    NB.x = (A_nrows+nt-1)/nt;
+    NB.y = 1;
+    NB.z = 1;
+
+    int variant = 0;
+    variant |= use_scmp          ? 2 : 0;
+    variant |= desc->earlyexit() ? 1 : 0;
+
+    switch (variant) {
+      case 0:
+        spmvDenseMaskedSelectKernel<false, false><<<NB, NT>>>(w->d_val_,
+            mask->dense_.d_val_, op.identity(), mul_op, add_op, A_nrows,
+            A_csrRowPtr, A_csrColInd, A_csrVal, u->d_val_);
+        break;
+      case 1:
+        spmvDenseMaskedSelectKernel<false, true><<<NB, NT>>>(w->d_val_,
+            mask->dense_.d_val_, op.identity(), mul_op, add_op, A_nrows,
+            A_csrRowPtr, A_csrColInd, A_csrVal, u->d_val_);
+        break;
+      case 2:
+        spmvDenseMaskedSelectKernel<true, false><<<NB, NT>>>(w->d_val_,
+            mask->dense_.d_val_, op.identity(), mul_op, add_op, A_nrows,
+            A_csrRowPtr, A_csrColInd, A_csrVal, u->d_val_);
+        break;
+      case 3:
+        spmvDenseMaskedSelectKernel<true, true><<<NB, NT>>>(w->d_val_,
+            mask->dense_.d_val_, op.identity(), mul_op, add_op, A_nrows,
+            A_csrRowPtr, A_csrColInd, A_csrVal, u->d_val_);
+        break;
+      default:
+        break;
+    }
+    w->nvals_ = A_nrows;
+    if (desc->debug())
+      printDevice("w_val", w->d_val_, A_nrows);
   } else {
     Index* w_ind;
     W*     w_val;
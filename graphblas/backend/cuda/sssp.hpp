@@ -0,0 +1,237 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_SSSP_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_SSSP_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Average degree at or above which delta is just the mean edge weight. On
+// sparser graphs delta grows so each bucket still has enough work.
+const int kDeltaSteppingDegree = 32;
+
+// Distance of an unreached vertex. Integer distances use max()/2, so adding
+// an edge weight to it cannot overflow. Floating distances keep max(), which
+// is the MinimumMonoid identity, so unreached vertices read the same whether
+// or not a min-plus product touched them; adding a weight to it rounds back
+// to max() rather than overflowing.
+template <typename T>
+inline T ssspInfinity() {
+  return (std::numeric_limits<T>::is_integer) ?
+      std::numeric_limits<T>::max()/2 : std::numeric_limits<T>::max();
+}
+
+// Atomically lowers *addr to val. Returns true if val was smaller.
+template <typename T>
+inline bool deltaAtomicMin(T* addr, T val) {
+  T old;
+  __atomic_load(addr, &old, __ATOMIC_RELAXED);
+  while (val < old) {
+    if (__atomic_compare_exchange(addr, &old, &val, true, __ATOMIC_RELAXED,
+        __ATOMIC_RELAXED))
+      return true;
+  }
+  return false;
+}
+
+/*!
+ * Delta for delta-stepping from the weights of A: the mean weight scaled up
+ * by kDeltaSteppingDegree / average degree, and at least the smallest
+ * positive weight.
+ */
+template <typename T, typename a>
+T deltaSteppingAuto(const Index* A_csrRowPtr,
+                    const a*     A_csrVal,
+                    Index        A_nrows) {
+  const Index A_nvals = A_csrRowPtr[A_nrows];
+  if (A_nvals == 0)
+    return static_cast<T>(1);
+
+  double sum = 0.;
+  double min_weight = std::numeric_limits<double>::max();
+  #pragma omp parallel for reduction(+:sum) reduction(min:min_weight)
+  for (Index i = 0; i < A_nvals; ++i) {
+    double weight = static_cast<double>(A_csrVal[i]);
+    sum += weight;
+    if (weight > 0.)
+      min_weight = std::min(min_weight, weight);
+  }
+  double degree = static_cast<double>(A_nvals) / A_nrows;
+  double delta  = sum / A_nvals * std::max(1., kDeltaSteppingDegree / degree);
+  if (min_weight != std::numeric_limits<double>::max())
+    delta = std::max(delta, min_weight);
+  T delta_t = static_cast<T>(delta);
+  return (delta_t > static_cast<T>(0)) ? delta_t : static_cast<T>(1);
+}
+
+/*!
+ * Delta-stepping SSSP on the CPU. Each row's edges are split once into light
+ * (weight <= delta) and heavy ones. Bucket b holds vertices with tentative
+ * distance in [b*delta, (b+1)*delta). Its light edges are relaxed until the
+ * bucket stops refilling, then the heavy edges of every vertex settled in it
+ * are relaxed once, since they can only reach later buckets.
+ *
+ * Each thread pushes into its own bins, so relaxations only share the
+ * distance array (updated with compare-and-swap). Stale entries whose
+ * distance has since moved to an earlier bucket are skipped when popped.
+ */
+template <typename T, typename a>
+Info deltaSteppingCpu(DenseVector<T>*        v,
+                      const SparseMatrix<a>* A,
+                      bool                   use_tran,
+                      Index                  s,
+                      T                      delta,
+                      Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  const T     inf     = ssspInfinity<T>();
+  CHECK(spmvCpuSetup(A));
+
+  const Index* A_csrRowPtr;
+  const Index* A_csrColInd;
+  const a*     A_csrVal;
+  spmvCpuArrays(A, use_tran, &A_csrRowPtr, &A_csrColInd, &A_csrVal);
+  if (delta <= static_cast<T>(0))
+    delta = deltaSteppingAuto<T>(A_csrRowPtr, A_csrVal, A_nrows);
+  if (desc->debug())
+    std::cout << "delta: " << delta << std::endl;
+
+  // Light edges first in each row, heavy ones from split[row]
+  const Index A_nvals = A_csrRowPtr[A_nrows];
+  std::vector<Index> colind(A_nvals);
+  std::vector<T>     val(A_nvals);
+  std::vector<Index> split(A_nrows);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (Index row = 0; row < A_nrows; ++row) {
+    Index light = A_csrRowPtr[row];
+    Index heavy = A_csrRowPtr[row+1];
+    for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+      T weight = static_cast<T>(A_csrVal[j]);
+      Index ind = (weight <= delta) ? light++ : --heavy;
+      colind[ind] = A_csrColInd[j];
+      val[ind]    = weight;
+    }
+    split[row] = light;
+  }
+
+  T* dist = v->h_val_;
+  std::fill(dist, dist + A_nrows, inf);
+  dist[s] = static_cast<T>(0);
+
+  // Last bucket each vertex was settled in, so heavy edges go out once
+  std::vector<Index> settled(A_nrows, -1);
+  const int nthreads = numThreads();
+  std::vector<std::vector<std::vector<Index> > > bins(nthreads);
+  std::vector<std::vector<Index> > settled_t(nthreads);
+
+  std::vector<Index> frontier(1, s);
+  Index bucket = 0;
+  Index niter  = 0;
+  while (bucket >= 0) {
+    const T bucket_lo = static_cast<T>(bucket)*delta;
+
+    // Light phase: relax until bucket stops refilling
+    while (!frontier.empty()) {
+      #pragma omp parallel
+      {
+        const int tid = threadId();
+        std::vector<std::vector<Index> >& bins_t = bins[tid];
+
+        #pragma omp for schedule(dynamic, 64) nowait
+        for (Index k = 0; k < frontier.size(); ++k) {
+          Index u = frontier[k];
+          T     dist_u;
+          __atomic_load(&dist[u], &dist_u, __ATOMIC_RELAXED);
+          if (dist_u < bucket_lo)
+            continue;
+          if (__atomic_exchange_n(&settled[u], bucket, __ATOMIC_RELAXED) !=
+              bucket)
+            settled_t[tid].push_back(u);
+          for (Index j = A_csrRowPtr[u]; j < split[u]; ++j) {
+            Index w = colind[j];
+            T     dist_w = dist_u + val[j];
+            if (deltaAtomicMin(&dist[w], dist_w)) {
+              Index b = static_cast<Index>(dist_w / delta);
+              if (b >= bins_t.size())
+                bins_t.resize(b + 1);
+              bins_t[b].push_back(w);
+            }
+          }
+        }
+      }
+
+      frontier.clear();
+      for (int t = 0; t < nthreads; ++t) {
+        if (bucket < bins[t].size()) {
+          frontier.insert(frontier.end(), bins[t][bucket].begin(),
+              bins[t][bucket].end());
+          bins[t][bucket].clear();
+        }
+      }
+      niter++;
+    }
+
+    // Heavy phase: one pass over the vertices settled in this bucket
+    frontier.clear();
+    for (int t = 0; t < nthreads; ++t) {
+      frontier.insert(frontier.end(), settled_t[t].begin(),
+          settled_t[t].end());
+      settled_t[t].clear();
+    }
+    #pragma omp parallel
+    {
+      const int tid = threadId();
+      std::vector<std::vector<Index> >& bins_t = bins[tid];
+
+      #pragma omp for schedule(dynamic, 64)
+      for (Index k = 0; k < frontier.size(); ++k) {
+        Index u = frontier[k];
+        T     dist_u = dist[u];
+        for (Index j = split[u]; j < A_csrRowPtr[u+1]; ++j) {
+          Index w = colind[j];
+          T     dist_w = dist_u + val[j];
+          if (deltaAtomicMin(&dist[w], dist_w)) {
+            Index b = static_cast<Index>(dist_w / delta);
+            if (b >= bins_t.size())
+              bins_t.resize(b + 1);
+            bins_t[b].push_back(w);
+          }
+        }
+      }
+    }
+    frontier.clear();
+
+    // Next non-empty bucket over all threads' bins
+    Index next = -1;
+    for (int t = 0; t < nthreads; ++t) {
+      for (Index b = bucket + 1; b < bins[t].size(); ++b) {
+        if (!bins[t][b].empty()) {
+          if (next == -1 || b < next)
+            next = b;
+          break;
+        }
+      }
+    }
+    bucket = next;
+    if (bucket >= 0) {
+      for (int t = 0; t < nthreads; ++t) {
+        if (bucket < bins[t].size()) {
+          frontier.insert(frontier.end(), bins[t][bucket].begin(),
+              bins[t][bucket].end());
+          bins[t][bucket].clear();
+        }
+      }
+    }
+  }
+
+  if (desc->debug())
+    std::cout << "delta-stepping: " << niter << " light phases\n";
+  CHECK(v->cpuToGpu());
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_SSSP_HPP_
@@ -1,7 +1,12 @@
 #ifndef GRAPHBLAS_BACKEND_CUDA_TRI_HPP_
 #define GRAPHBLAS_BACKEND_CUDA_TRI_HPP_
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
+#include <vector>
+
+#include "graphblas/backend/cuda/intersect.hpp"
 
 namespace graphblas {
 namespace backend {
@@ -51,6 +56,191 @@ Info trilSparse(SparseMatrix<c>* C,
   }
   return GrB_SUCCESS;
 }
+
+// Order of vertices by descending degree, ties by id. Each thread sorts a
+// chunk, then chunks are merged pairwise in parallel rounds.
+inline void trilDegreeOrder(std::vector<Index>*       perm,
+                            const std::vector<Index>& degree) {
+  const Index nrows = degree.size();
+  perm->resize(nrows);
+  for (Index i = 0; i < nrows; ++i)
+    (*perm)[i] = i;
+
+  struct DegreeGreater {
+    const Index* degree;
+    bool operator()(Index u, Index v) const {
+      return degree[u] > degree[v] || (degree[u] == degree[v] && u < v);
+    }
+  } greater = {degree.data()};
+
+  const Index nchunks = std::max(1, std::min(numThreads(), nrows));
+  const Index chunk   = (nrows + nchunks - 1) / nchunks;
+  #pragma omp parallel for schedule(static, 1)
+  for (Index k = 0; k < nchunks; ++k)
+    std::sort(perm->begin() + std::min(nrows, k*chunk),
+        perm->begin() + std::min(nrows, (k+1)*chunk), greater);
+
+  for (Index width = chunk; width < nrows; width *= 2) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (Index lo = 0; lo < nrows - width; lo += 2*width)
+      std::inplace_merge(perm->begin() + lo, perm->begin() + lo + width,
+          perm->begin() + std::min(nrows, lo + 2*width), greater);
+  }
+}
+
+/*!
+ * Degree-ordered tril on the CPU. Vertices are relabeled by descending
+ * degree, so row perm^-1(u) of C keeps the neighbours of u that have a
+ * higher degree than u. Every edge is oriented from its lower to its higher
+ * degree end, and rows stay short even on power-law graphs. Relabeling,
+ * orientation and row sorting are one pass over A; the permuted graph is
+ * never built. perm (if not NULL) gets the old id of each new vertex.
+ */
+template <typename c, typename a>
+Info trilDegreeCpu(SparseMatrix<c>*       C,
+                   Index*                 perm,
+                   const SparseMatrix<a>* A,
+                   Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+  const Index* A_csrRowPtr = A->h_csrRowPtr_;
+  const Index* A_csrColInd = A->h_csrColInd_;
+  const a*     A_csrVal    = A->h_csrVal_;
+
+  std::vector<Index> degree(A_nrows);
+  #pragma omp parallel for schedule(static)
+  for (Index row = 0; row < A_nrows; ++row)
+    degree[row] = A_csrRowPtr[row+1] - A_csrRowPtr[row];
+
+  std::vector<Index> order;
+  trilDegreeOrder(&order, degree);
+  std::vector<Index> rank(A_nrows);
+  #pragma omp parallel for schedule(static)
+  for (Index i = 0; i < A_nrows; ++i)
+    rank[order[i]] = i;
+
+  // Count, scan, then fill each new row with its lower-ranked neighbours
+  std::vector<Index> row_ptr(A_nrows+1, 0);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (Index i = 0; i < A_nrows; ++i) {
+    Index u = order[i];
+    Index count = 0;
+    for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j)
+      count += (rank[A_csrColInd[j]] < i);
+    row_ptr[i+1] = count;
+  }
+  for (Index i = 0; i < A_nrows; ++i)
+    row_ptr[i+1] += row_ptr[i];
+
+  const Index C_nvals = row_ptr[A_nrows];
+  std::vector<std::pair<Index, c> > entries(C_nvals);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (Index i = 0; i < A_nrows; ++i) {
+    Index u   = order[i];
+    Index ind = row_ptr[i];
+    for (Index j = A_csrRowPtr[u]; j < A_csrRowPtr[u+1]; ++j) {
+      Index v = rank[A_csrColInd[j]];
+      if (v < i)
+        entries[ind++] = std::make_pair(v, static_cast<c>(A_csrVal[j]));
+    }
+    std::sort(entries.begin() + row_ptr[i], entries.begin() + ind);
+  }
+
+  CHECK(C->release());
+  C->nvals_     = C_nvals;
+  C->symmetric_ = false;
+  CHECK(C->allocateCpu());
+  #pragma omp parallel for schedule(static)
+  for (Index i = 0; i < A_nrows; ++i) {
+    C->h_csrRowPtr_[i] = row_ptr[i];
+    for (Index j = row_ptr[i]; j < row_ptr[i+1]; ++j) {
+      C->h_csrColInd_[j] = entries[j].first;
+      C->h_csrVal_[j]    = entries[j].second;
+    }
+  }
+  C->h_csrRowPtr_[A_nrows] = C_nvals;
+  C->csr_initialized_ = true;
+  CHECK(C->syncCpu());
+  CHECK(C->cpuToGpu());
+
+  if (perm != NULL)
+    std::copy(order.begin(), order.end(), perm);
+  if (desc->debug())
+    std::cout << "trilDegree: " << A->nvals_ << " -> " << C_nvals
+        << " nonzeroes, max degree " << degree[order[0]] << "\n";
+  return GrB_SUCCESS;
+}
+
+// Triangles of a lower triangular L with sorted rows, by intersecting
+// L(row, :) with L(col, :) for every edge. Rows longer than
+// kIntersectHubDegree are marked in a bitmap once and probed by each col.
+template <typename T, typename a>
+Info tcIntersectCpu(T*                     ntris,
+                    const SparseMatrix<a>* L,
+                    Descriptor*            desc) {
+  const Index L_nrows = L->nrows_;
+  CHECK(spmvCpuSetup(L));
+  T count = 0;
+
+  #pragma omp parallel reduction(+:count)
+  {
+    const Index* L_csrRowPtr;
+    const Index* L_csrColInd;
+    const a*     L_csrVal;
+    spmvCpuArrays(L, false, &L_csrRowPtr, &L_csrColInd, &L_csrVal);
+    IntersectBitmap* hub = NULL;
+
+    #pragma omp for schedule(dynamic, 256)
+    for (Index row = 0; row < L_nrows; ++row) {
+      const Index* row_ind = L_csrColInd + L_csrRowPtr[row];
+      const Index  row_len = L_csrRowPtr[row+1] - L_csrRowPtr[row];
+      if (row_len > kIntersectHubDegree) {
+        if (hub == NULL)
+          hub = new IntersectBitmap(L_nrows);
+        hub->set(row_ind, row_len);
+      }
+      for (Index jj = 0; jj < row_len; ++jj) {
+        Index        col     = row_ind[jj];
+        const Index* col_ind = L_csrColInd + L_csrRowPtr[col];
+        const Index  col_len = L_csrRowPtr[col+1] - L_csrRowPtr[col];
+        IntersectCount emit;
+        // Only the part of L(row, :) before col can match L(col, :) < col
+        if (row_len > kIntersectHubDegree)
+          count += hub->probe(col_ind, col_len, &emit);
+        else
+          count += intersect(row_ind, jj, col_ind, col_len, &emit);
+      }
+      if (row_len > kIntersectHubDegree)
+        hub->unset(row_ind, row_len);
+    }
+    delete hub;
+  }
+  *ntris = count;
+  return GrB_SUCCESS;
+}
+
+template <typename T, typename a>
+Info tcIntersectCuda(T*                     ntris,
+                     const SparseMatrix<a>* L,
+                     Descriptor*            desc) {
+  const Index L_nrows = L->nrows_;
+  CHECK(desc->resize(sizeof(T), "buffer"));
+  T* d_ntris = reinterpret_cast<T*>(desc->d_buffer_);
+  CUDA_CALL(cudaMemset(d_ntris, 0, sizeof(T)));
+
+  const int nt = 256;
+  dim3 NT, NB;
+  NT.x = nt;
+  NT.y = 1;
+  NT.z = 1;
+  NB.x = (static_cast<size_t>(L_nrows)*32 + nt - 1) / nt;
+  NB.y = 1;
+  NB.z = 1;
+  tcIntersectKernel<<<NB, NT>>>(d_ntris, L_nrows, L->d_csrRowPtr_,
+      L->d_csrColInd_);
+  CUDA_CALL(cudaMemcpy(ntris, d_ntris, sizeof(T), cudaMemcpyDeviceToHost));
+  return GrB_SUCCESS;
+}
 }  // namespace backend
 }  // namespace graphblas
 
@@ -0,0 +1,274 @@
+#ifndef GRAPHBLAS_BACKEND_CUDA_TRUSS_HPP_
+#define GRAPHBLAS_BACKEND_CUDA_TRUSS_HPP_
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace graphblas {
+namespace backend {
+
+// Edge states of ktrussCpu
+const char kTrussAlive    = 0;
+const char kTrussFrontier = 1;
+const char kTrussRemoved  = 2;
+
+// Emits the edge ids of the other two sides of each triangle on an edge
+// (u, v): a_eid and b_eid are the edge ids of the rows of u and v. Self
+// loops have id -1 and close no triangle.
+struct TrussTriangles {
+  static const bool kEmit = true;
+  const Index* a_eid;
+  const Index* b_eid;
+  Index*       e1;
+  Index*       e2;
+  Index        n;
+  void operator()(Index index, Index a_pos, Index b_pos) {
+    if (a_eid[a_pos] == -1 || b_eid[b_pos] == -1)
+      return;
+    e1[n] = a_eid[a_pos];
+    e2[n] = b_eid[b_pos];
+    n++;
+  }
+};
+
+/*!
+ * k-truss on the CPU by support peeling (Kabir, Madduri, PKT, IPDPSW 2017).
+ * Each edge {u, v} has one id, the position of its u < v entry in A, and its
+ * support is the number of triangles on it.
+ *   1) support is the masked SpGEMM A .* (A * A^T) over the upper triangle,
+ *      one sorted-row intersection per edge
+ *   2) edges with support below k - 2 are removed in rounds. Only the
+ *      triangles of a removed edge are intersected again, and each of them
+ *      lowers the support of its surviving sides once (when two sides are
+ *      removed in the same round, the lower id does it)
+ *
+ * With k > 2, C gets the k-truss: the surviving edges of A, in both
+ * directions, with their support. With k == 0 this repeats for k = 3, 4,
+ * ... until no edge is left, edges sit in buckets by support so each level
+ * starts from its own, and C gets every edge of A with its truss number
+ * (the largest k of a k-truss that contains it). Rows of A must be sorted
+ * and its pattern symmetric.
+ */
+template <typename c, typename a>
+Info ktrussCpu(SparseMatrix<c>*       C,
+               const SparseMatrix<a>* A,
+               Index                  k,
+               Descriptor*            desc) {
+  const Index A_nrows = A->nrows_;
+  CHECK(spmvCpuSetup(A));
+  const Index* A_csrRowPtr = A->h_csrRowPtr_;
+  const Index* A_csrColInd = A->h_csrColInd_;
+  const Index  A_nvals     = A_csrRowPtr[A_nrows];
+  const bool   decompose   = (k == 0);
+
+  // Edge id of each entry, and the row of each entry
+  std::vector<Index> eid(A_nvals);
+  std::vector<Index> row_of(A_nvals);
+  Index max_degree = 0;
+  #pragma omp parallel for schedule(dynamic, 1024) reduction(max:max_degree)
+  for (Index row = 0; row < A_nrows; ++row) {
+    max_degree = std::max(max_degree, A_csrRowPtr[row+1] - A_csrRowPtr[row]);
+    for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+      Index col = A_csrColInd[j];
+      row_of[j] = row;
+      if (row < col) {
+        eid[j] = j;
+      } else if (row > col) {
+        const Index* col_ind = A_csrColInd + A_csrRowPtr[col];
+        const Index  col_len = A_csrRowPtr[col+1] - A_csrRowPtr[col];
+        eid[j] = A_csrRowPtr[col] + (std::lower_bound(col_ind,
+            col_ind + col_len, row) - col_ind);
+      } else {
+        eid[j] = -1;
+      }
+    }
+  }
+
+  std::vector<Index> edges;
+  for (Index j = 0; j < A_nvals; ++j)
+    if (eid[j] == j)
+      edges.push_back(j);
+  const Index nedges = edges.size();
+
+  // 1) Support of every edge
+  std::vector<Index> support(A_nvals, 0);
+  std::vector<char>  state(A_nvals, kTrussAlive);
+  const int nthreads = numThreads();
+  std::vector<std::vector<Index> > e1_t(nthreads,
+      std::vector<Index>(max_degree));
+  std::vector<std::vector<Index> > e2_t(nthreads,
+      std::vector<Index>(max_degree));
+  long long nprocessed = 0;
+
+  #pragma omp parallel for schedule(dynamic, 256) reduction(+:nprocessed)
+  for (Index idx = 0; idx < nedges; ++idx) {
+    const int   tid = threadId();
+    const Index e   = edges[idx];
+    const Index u   = row_of[e];
+    const Index v   = A_csrColInd[e];
+    TrussTriangles emit = {eid.data() + A_csrRowPtr[u],
+        eid.data() + A_csrRowPtr[v], e1_t[tid].data(), e2_t[tid].data(), 0};
+    intersect(A_csrColInd + A_csrRowPtr[u], A_csrRowPtr[u+1] - A_csrRowPtr[u],
+        A_csrColInd + A_csrRowPtr[v], A_csrRowPtr[v+1] - A_csrRowPtr[v],
+        &emit);
+    support[e] = emit.n;
+    nprocessed++;
+  }
+
+  Index max_support = 0;
+  for (Index idx = 0; idx < nedges; ++idx)
+    max_support = std::max(max_support, support[edges[idx]]);
+
+  // Buckets by support, for the levels after the first when decomposing
+  std::vector<std::vector<Index> > bucket((decompose) ? max_support + 1 : 0);
+  if (decompose)
+    for (Index idx = 0; idx < nedges; ++idx)
+      bucket[support[edges[idx]]].push_back(edges[idx]);
+
+  std::vector<Index> truss((decompose) ? A_nvals : 0, 0);
+  std::vector<Index> stamp((decompose) ? A_nvals : 0, -1);
+  std::vector<Index> frontier;
+  std::vector<std::vector<Index> > next_t(nthreads);
+  std::vector<std::vector<Index> > moved_t(nthreads);
+
+  // 2) Peel one level, or every level when decomposing. Past the first,
+  // the edges below k - 2 are exactly those left in bucket k - 3
+  const Index k_first   = (decompose) ? 3 : k;
+  Index       remaining = nedges;
+  Index       round     = 0;
+  Index       k_level;
+  for (k_level = k_first; remaining > 0; ++k_level) {
+    const Index t = k_level - 2;
+    frontier.clear();
+    if (k_level == k_first) {
+      for (Index idx = 0; idx < nedges; ++idx)
+        if (support[edges[idx]] < t)
+          frontier.push_back(edges[idx]);
+    } else {
+      for (Index idx = 0; idx < bucket[t-1].size(); ++idx) {
+        Index e = bucket[t-1][idx];
+        if (state[e] == kTrussAlive && support[e] < t)
+          frontier.push_back(e);
+      }
+      std::vector<Index>().swap(bucket[t-1]);
+    }
+
+    while (!frontier.empty()) {
+      for (Index idx = 0; idx < frontier.size(); ++idx)
+        state[frontier[idx]] = kTrussFrontier;
+      remaining -= frontier.size();
+
+      #pragma omp parallel reduction(+:nprocessed)
+      {
+        const int tid = threadId();
+        #pragma omp for schedule(dynamic, 64)
+        for (Index idx = 0; idx < frontier.size(); ++idx) {
+          const Index e = frontier[idx];
+          const Index u = row_of[e];
+          const Index v = A_csrColInd[e];
+          TrussTriangles emit = {eid.data() + A_csrRowPtr[u],
+              eid.data() + A_csrRowPtr[v], e1_t[tid].data(),
+              e2_t[tid].data(), 0};
+          intersect(A_csrColInd + A_csrRowPtr[u],
+              A_csrRowPtr[u+1] - A_csrRowPtr[u],
+              A_csrColInd + A_csrRowPtr[v],
+              A_csrRowPtr[v+1] - A_csrRowPtr[v], &emit);
+          nprocessed++;
+
+          for (Index i = 0; i < emit.n; ++i) {
+            Index side[2] = {emit.e1[i], emit.e2[i]};
+            char  s1      = state[side[0]];
+            char  s2      = state[side[1]];
+            if (s1 == kTrussRemoved || s2 == kTrussRemoved)
+              continue;
+            for (int p = 0; p < 2; ++p) {
+              Index f = side[p];
+              Index o = side[1-p];
+              char  s = state[o];
+              if (state[f] != kTrussAlive ||
+                  (s == kTrussFrontier && o < e))
+                continue;
+              Index old = __atomic_fetch_sub(&support[f], 1,
+                  __ATOMIC_RELAXED);
+              if (old == t)
+                next_t[tid].push_back(f);
+              else if (decompose && __atomic_exchange_n(&stamp[f], round,
+                  __ATOMIC_RELAXED) != round)
+                moved_t[tid].push_back(f);
+            }
+          }
+        }
+      }
+
+      for (Index idx = 0; idx < frontier.size(); ++idx) {
+        state[frontier[idx]] = kTrussRemoved;
+        if (decompose)
+          truss[frontier[idx]] = k_level - 1;
+      }
+      frontier.clear();
+      for (int th = 0; th < nthreads; ++th) {
+        frontier.insert(frontier.end(), next_t[th].begin(), next_t[th].end());
+        for (Index idx = 0; idx < moved_t[th].size(); ++idx) {
+          Index f = moved_t[th][idx];
+          if (support[f] >= t)
+            bucket[support[f]].push_back(f);
+        }
+        next_t[th].clear();
+        moved_t[th].clear();
+      }
+      round++;
+    }
+
+    if (desc->debug())
+      std::cout << "ktruss " << k_level << ": " << remaining << "/" << nedges
+          << " edges left\n";
+    if (!decompose)
+      break;
+  }
+
+  // Surviving edges with their support, or every edge with its truss number
+  std::vector<Index> row_ptr(A_nrows+1, 0);
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (Index row = 0; row < A_nrows; ++row) {
+    Index count = 0;
+    for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j)
+      count += (eid[j] != -1 && (decompose || state[eid[j]] == kTrussAlive));
+    row_ptr[row+1] = count;
+  }
+  for (Index row = 0; row < A_nrows; ++row)
+    row_ptr[row+1] += row_ptr[row];
+
+  const Index C_nvals = row_ptr[A_nrows];
+  CHECK(C->release());
+  C->nvals_     = C_nvals;
+  C->symmetric_ = false;
+  CHECK(C->allocateCpu());
+  #pragma omp parallel for schedule(dynamic, 1024)
+  for (Index row = 0; row < A_nrows; ++row) {
+    Index ind = row_ptr[row];
+    C->h_csrRowPtr_[row] = ind;
+    for (Index j = A_csrRowPtr[row]; j < A_csrRowPtr[row+1]; ++j) {
+      Index e = eid[j];
+      if (e == -1 || (!decompose && state[e] != kTrussAlive))
+        continue;
+      C->h_csrColInd_[ind] = A_csrColInd[j];
+      C->h_csrVal_[ind]    = static_cast<c>((decompose) ? truss[e] :
+          support[e]);
+      ind++;
+    }
+  }
+  C->h_csrRowPtr_[A_nrows] = C_nvals;
+  C->csr_initialized_ = true;
+  CHECK(C->syncCpu());
+  CHECK(C->cpuToGpu());
+
+  if (desc->timing_ > 0)
+    std::cout << "ktruss, " << nedges << " edges, " << nprocessed
+        << " edges processed, " << round << " rounds\n";
+  return GrB_SUCCESS;
+}
+}  // namespace backend
+}  // namespace graphblas
+
+#endif  // GRAPHBLAS_BACKEND_CUDA_TRUSS_HPP_
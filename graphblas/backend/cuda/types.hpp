@@ -15,6 +15,17 @@ enum LoadBalanceMode {
   GrB_LOAD_BALANCE_TWC,
   GrB_LOAD_BALANCE_MERGE
 };
+
+enum NumaPolicy {
+  GrB_NUMA_FIRSTTOUCH,
+  GrB_NUMA_INTERLEAVE,
+  GrB_NUMA_REPLICATE
+};
+
+enum ExecutionMode {
+  GrB_BLOCKING,
+  GrB_NONBLOCKING
+};
 }  // namespace backend
 }  // namespace graphblas
 
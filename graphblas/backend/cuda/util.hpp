@@ -73,6 +73,27 @@ void printState(bool use_mask, bool use_accum, bool use_scmp, bool use_repl,
   std::cout << "Tran: " << use_tran  << std::endl;
 }
 
+// Calls the accum op given to an op. With GrB_NULL (no accum) the new value
+// is returned, so kernels compile whether or not accum is set.
+template <typename BinaryOpT>
+struct ApplyAccum {
+  BinaryOpT accum;
+  explicit ApplyAccum(BinaryOpT op) : accum(op) {}
+  template <typename T>
+  inline GRB_HOST_DEVICE T operator()(T lhs, T rhs) {
+    return accum(lhs, rhs);
+  }
+};
+
+template <>
+struct ApplyAccum<decltype(GrB_NULL)> {
+  explicit ApplyAccum(decltype(GrB_NULL) op) {}
+  template <typename T>
+  inline GRB_HOST_DEVICE T operator()(T lhs, T rhs) {
+    return rhs;
+  }
+};
+
 /*! 
  * \brief constexpr variant of std::min, since we may not be using C++14
  */
@@ -21,18 +21,22 @@ class SparseVector;
 template <typename T>
 class DenseVector;
 
+template <typename T>
+class DeferredExpr;
+
 template <typename T>
 class Vector {
  public:
   Vector()
       : nsize_(0), nvals_(0), sparse_(0), dense_(0), vec_type_(GrB_UNKNOWN),
-        ratio_(0) {}
+        ratio_(0), pending_(NULL) {}
   explicit Vector(Index nsize)
       : nsize_(nsize), nvals_(0), sparse_(nsize), dense_(nsize),
-        vec_type_(GrB_UNKNOWN), ratio_(0) {}
+        vec_type_(GrB_UNKNOWN), ratio_(0), pending_(NULL) {}
 
-  // Default destructor is good enough for this layer
-  ~Vector() {}
+  ~Vector() {
+    if (pending_ != NULL) delete pending_;
+  }
 
   // C API Methods
   Info nnew(Index nsize_t);
@@ -72,6 +76,14 @@ class Vector {
   Info sparse2dense(T identity, Descriptor* desc = NULL);
   Info dense2sparse(T identity, Descriptor* desc);
   Info swap(Vector* rhs);
+  Info share(const Vector* rhs);
+  Info detach(bool copy = true);
+
+  // Nonblocking mode: defer() takes ownership of an element-wise expression
+  // that becomes the value of this vector, evaluate() materializes it
+  Info defer(DeferredExpr<T>* expr);
+  Info evaluate();
+  Info discard();
 
  private:
   Index           nsize_;
@@ -81,6 +93,8 @@ class Vector {
   Storage         vec_type_;
 
   float           ratio_;
+
+  DeferredExpr<T>* pending_;  // NULL unless value is a deferred expression
 };
 
 // nsize_ is not modified, because it only gets modified in size()
@@ -93,6 +107,8 @@ Info Vector<T>::nnew(Index nsize_t) {
 
 template <typename T>
 Info Vector<T>::dup(const Vector* rhs) {
+  CHECK(const_cast<Vector*>(rhs)->evaluate());
+  CHECK(discard());
   vec_type_ = rhs->vec_type_;
   if (vec_type_ == GrB_SPARSE)
     return sparse_.dup(&rhs->sparse_);
@@ -102,8 +118,38 @@ Info Vector<T>::dup(const Vector* rhs) {
   return GrB_UNINITIALIZED_OBJECT;
 }
 
+// Shallow copy of the active storage. Buffers stay shared until either
+// vector is written to, see detach()
+template <typename T>
+Info Vector<T>::share(const Vector* rhs) {
+  CHECK(const_cast<Vector*>(rhs)->evaluate());
+  CHECK(discard());
+  vec_type_ = rhs->vec_type_;
+  nsize_    = rhs->nsize_;
+  nvals_    = rhs->nvals_;
+  ratio_    = rhs->ratio_;
+  if (vec_type_ == GrB_SPARSE)
+    return sparse_.share(&rhs->sparse_);
+  else if (vec_type_ == GrB_DENSE)
+    return dense_.share(&rhs->dense_);
+  std::cout << "Error: Failed to call share!\n";
+  return GrB_UNINITIALIZED_OBJECT;
+}
+
+// Must be called by every operation that writes to this vector. copy is false
+// when the operation overwrites every value, so shared buffers need not be
+// copied first
+template <typename T>
+Info Vector<T>::detach(bool copy) {
+  CHECK(evaluate());
+  CHECK(sparse_.detach(copy));
+  CHECK(dense_.detach(copy));
+  return GrB_SUCCESS;
+}
+
 template <typename T>
 Info Vector<T>::clear() {
+  CHECK(discard());
   vec_type_ = GrB_UNKNOWN;
   nvals_    = 0;
   CHECK(sparse_.clear());
@@ -151,6 +197,7 @@ Info Vector<T>::build(const std::vector<Index>* indices,
                       const std::vector<T>*     values,
                       Index                     nvals,
                       BinaryOpT                 dup) {
+  CHECK(discard());
   vec_type_ = GrB_SPARSE;
   return sparse_.build(indices, values, nvals, dup);
 }
@@ -158,6 +205,7 @@ Info Vector<T>::build(const std::vector<Index>* indices,
 template <typename T>
 Info Vector<T>::build(const std::vector<T>* values,
                       Index                 nvals) {
+  CHECK(discard());
   vec_type_ = GrB_DENSE;
   return dense_.build(values, nvals);
 }
@@ -166,6 +214,7 @@ template <typename T>
 Info Vector<T>::build(Index* indices,
                       T*     values,
                       Index nvals) {
+  CHECK(discard());
   vec_type_ = GrB_SPARSE;
   return sparse_.build(indices, values, nvals);
 }
@@ -173,12 +222,14 @@ Info Vector<T>::build(Index* indices,
 template <typename T>
 Info Vector<T>::build(T*    values,
                       Index nvals) {
+  CHECK(discard());
   vec_type_ = GrB_DENSE;
   return dense_.build(values, nvals);
 }
 
 template <typename T>
 Info Vector<T>::setElement(T val, Index index) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE) return sparse_.setElement(val, index);
   else if (vec_type_ == GrB_DENSE) return  dense_.setElement(val, index);
   return GrB_UNINITIALIZED_OBJECT;
@@ -186,6 +237,7 @@ Info Vector<T>::setElement(T val, Index index) {
 
 template <typename T>
 Info Vector<T>::extractElement(T* val, Index index) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE)
     return sparse_.extractElement(val, index);
   else if (vec_type_ == GrB_DENSE)
@@ -197,6 +249,7 @@ template <typename T>
 Info Vector<T>::extractTuples(std::vector<Index>* indices,
                               std::vector<T>*     values,
                               Index*              n) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE)
     return sparse_.extractTuples(indices, values, n);
   else if (vec_type_ == GrB_DENSE)
@@ -207,6 +260,7 @@ Info Vector<T>::extractTuples(std::vector<Index>* indices,
 template <typename T>
 Info Vector<T>::extractTuples(std::vector<T>* values,
                               Index*          n) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE) {
     CHECK(sparse2dense(0.f));
     return dense_.extractTuples(values, n);
@@ -219,6 +273,7 @@ Info Vector<T>::extractTuples(std::vector<T>* values,
 // Handy methods:
 template <typename T>
 const T& Vector<T>::operator[](Index ind) {
+  evaluate();
   if (vec_type_ == GrB_SPARSE)
     return sparse_[ind];
   else if (vec_type_ == GrB_DENSE)
@@ -229,6 +284,7 @@ const T& Vector<T>::operator[](Index ind) {
 // Copies the val to arrays kresize_ratio x bigger than capacity
 template <typename T>
 Info Vector<T>::resize(Index nvals) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE)
     return sparse_.resize(nvals);
   else if (vec_type_ == GrB_DENSE)
@@ -239,6 +295,7 @@ Info Vector<T>::resize(Index nvals) {
 // Fill constant value
 template <typename T>
 Info Vector<T>::fill(T val) {
+  CHECK(discard());
   if (vec_type_ != GrB_DENSE)
     CHECK(setStorage(GrB_DENSE));
   return dense_.fill(val);
@@ -247,6 +304,7 @@ Info Vector<T>::fill(T val) {
 // Fill ascending
 template <typename T>
 Info Vector<T>::fillAscending(Index nvals) {
+  CHECK(discard());
   if (vec_type_ != GrB_DENSE)
     CHECK(setStorage(GrB_DENSE));
   return dense_.fillAscending(nvals);
@@ -254,6 +312,7 @@ Info Vector<T>::fillAscending(Index nvals) {
 
 template <typename T>
 Info Vector<T>::print(bool force_update) {
+  CHECK(evaluate());
   if (vec_type_ == GrB_SPARSE)
     return sparse_.print(force_update);
   else if (vec_type_ == GrB_DENSE)
@@ -281,6 +340,9 @@ inline Info Vector<T>::setStorage(Storage vec_type) {
 
 template <typename T>
 inline Info Vector<T>::getStorage(Storage* vec_type) const {
+  // Every operation asks for the storage of its inputs before reading them,
+  // so this is where deferred values get materialized
+  CHECK(const_cast<Vector*>(this)->evaluate());
   *vec_type = vec_type_;
   return GrB_SUCCESS;
 }
@@ -290,6 +352,7 @@ inline Info Vector<T>::getStorage(Storage* vec_type) const {
 // b) if less elements than desc->switchpoint(), convert DeVec->SpVec
 template <typename T>
 Info Vector<T>::convert(T identity, float switchpoint, Descriptor* desc) {
+  CHECK(evaluate());
   Index nvals_t;
   Index nsize_t;
   if (vec_type_ == GrB_SPARSE) {
@@ -338,6 +401,7 @@ Info Vector<T>::sparse2dense(T identity, Descriptor* desc) {
   // 2. Call scatter
 
   CHECK(setStorage(GrB_DENSE));
+  CHECK(dense_.detach());
   const int nt    = 128;
   const int nvals = sparse_.nvals_;
 
@@ -374,6 +438,7 @@ Info Vector<T>::dense2sparse(T identity, Descriptor* desc) {
   // 2. Run kernel
 
   CHECK(setStorage(GrB_DENSE));
+  CHECK(sparse_.detach());
   const int nt    = 128;
   const int nvals = dense_.nvals_;
 
@@ -427,6 +492,8 @@ Info Vector<T>::dense2sparse(T identity, Descriptor* desc) {
 // Assume both are of the same type to make things easier
 template <typename T>
 Info Vector<T>::swap(Vector* rhs) {  // NOLINT(build/include_what_you_use)
+  CHECK(evaluate());
+  CHECK(rhs->evaluate());
   if (vec_type_ != rhs->vec_type_ || vec_type_ == GrB_UNKNOWN)  {
     // std::cout << vec_type_ << " != " << rhs->vec_type_ << std::endl;
     // std::cout << "Error: Format not equivalent!\n";
@@ -448,6 +515,42 @@ Info Vector<T>::swap(Vector* rhs) {  // NOLINT(build/include_what_you_use)
 
   return GrB_SUCCESS;
 }
+
+template <typename T>
+Info Vector<T>::defer(DeferredExpr<T>* expr) {
+  CHECK(discard());
+  CHECK(setStorage(GrB_DENSE));
+  pending_ = expr;
+  return GrB_SUCCESS;
+}
+
+template <typename T>
+Info Vector<T>::evaluate() {
+  if (pending_ == NULL)
+    return GrB_SUCCESS;
+  DeferredExpr<T>* expr = pending_;
+  pending_ = NULL;
+
+  // Old contents are overwritten, so buffers still shared with another vector
+  // (possibly as a leaf of expr) are dropped rather than copied
+  if (dense_.ref_count_ != NULL && *dense_.ref_count_ > 1)
+    CHECK(dense_.release());
+  CHECK(setStorage(GrB_DENSE));
+  CHECK(dense_.detach());
+  CHECK(expr->evaluate(&dense_));
+  delete expr;
+  return GrB_SUCCESS;
+}
+
+// Drops a deferred value that is about to be overwritten without reading it
+template <typename T>
+Info Vector<T>::discard() {
+  if (pending_ != NULL) {
+    delete pending_;
+    pending_ = NULL;
+  }
+  return GrB_SUCCESS;
+}
 }  // namespace backend
 }  // namespace graphblas
 
@@ -92,7 +92,7 @@ Info Matrix<T>::nnew(Index nrows, Index ncols) {
 template <typename T>
 Info Matrix<T>::dup(const Matrix* rhs) {
   if (rhs == NULL) return GrB_NULL_POINTER;
-  return matrix_.dup(&rhs->matrix_);
+  return matrix_.share(&rhs->matrix_);
 }
 
 template <typename T>
@@ -194,7 +194,7 @@ Info Matrix<T>::extractTuples(std::vector<T>* values,
 // Handy methods
 template <typename T>
 void Matrix<T>::operator=(const Matrix& rhs) {
-  matrix_.dup(&rhs.matrix_);
+  matrix_.share(&rhs.matrix_);
 }
 
 template <typename T>
@@ -1,6 +1,7 @@
 #ifndef GRAPHBLAS_OPERATIONS_HPP_
 #define GRAPHBLAS_OPERATIONS_HPP_
 
+#include <utility>
 #include <vector>
 
 #define __GRB_BACKEND_OPERATIONS_HEADER <graphblas/backend/__GRB_BACKEND_ROOT/operations.hpp>
@@ -825,6 +826,473 @@ Info graphColor(Vector<W>*       w,
   return backend::graphColor(&w->vector_, &A->matrix_, desc_t);
 }
 
+/*!
+ * Extension method
+ *
+ * Multi-source BFS from up to 512 sources at once, one bit per source in
+ * per-vertex words. Row k of V (nsources x A_nrows) gets the depths from
+ * (*sources)[k] (1 for the source, 0 if unreachable) and (*ecc)[k] its
+ * eccentricity in edges. Either output may be GrB_NULL.
+ */
+template <typename T, typename a>
+Info msBfs(Matrix<T>*                V,
+           std::vector<Index>*       ecc,
+           const Matrix<a>*          A,
+           const std::vector<Index>* sources,
+           Descriptor*               desc) {
+  if (A == NULL || sources == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  if (A_nrows != A_ncols)
+    return GrB_DIMENSION_MISMATCH;
+
+  Index nsources = sources->size();
+  if (nsources == 0 || nsources > backend::kMsBfsMaxSources)
+    return GrB_INVALID_VALUE;
+  for (Index k = 0; k < nsources; ++k)
+    if ((*sources)[k] < 0 || (*sources)[k] >= A_nrows)
+      return GrB_INDEX_OUT_OF_BOUNDS;
+
+  if (V != NULL) {
+    Index V_nrows, V_ncols;
+    CHECK(V->nrows(&V_nrows));
+    CHECK(V->ncols(&V_ncols));
+    if (V_nrows != nsources || V_ncols != A_nrows)
+      return GrB_DIMENSION_MISMATCH;
+  }
+  if (ecc != NULL)
+    ecc->resize(nsources);
+
+  backend::Matrix<T>* V_t = (V == NULL) ? NULL : &V->matrix_;
+  Index* ecc_t = (ecc == NULL) ? NULL : ecc->data();
+
+  return backend::msBfs(V_t, ecc_t, &A->matrix_, sources->data(), nsources,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Single-source shortest paths from s by delta-stepping, on the CPU backend
+ * only. v(i) gets the distance to i, or ssspInfinity<T>() if unreachable:
+ * max()/2 for integer T, max() for floating T. Edge weights must be
+ * non-negative. delta <= 0 picks the bucket width from the weights and
+ * average degree of A.
+ */
+template <typename T, typename a>
+Info deltaStepping(Vector<T>*       v,
+                   const Matrix<a>* A,
+                   Index            s,
+                   T                delta,
+                   Descriptor*      desc) {
+  if (v == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+  if (s < 0 || s >= A_nrows)
+    return GrB_INDEX_OUT_OF_BOUNDS;
+
+  return backend::deltaStepping(&v->vector_, &A->matrix_, s, delta,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Speculative greedy graph coloring, on the CPU backend only. w(i) gets the
+ * color of i, starting from 1. Vertices are colored first-fit in parallel
+ * and neighbours that clash are recolored until none do. order picks who
+ * keeps a clashing color: 0 natural, 1 largest degree first, 2 smallest-last.
+ * The pattern of A must be symmetric.
+ */
+template <typename W, typename a>
+Info greedyColor(Vector<W>*       w,
+                 const Matrix<a>* A,
+                 int              order,
+                 Descriptor*      desc) {
+  if (w == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, w_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(w->size(&w_nsize));
+  if (A_nrows != A_ncols || w_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::greedyColor(&w->vector_, &A->matrix_, order,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Distance-2 graph coloring, on the CPU backend only, without forming A^2.
+ * w(i) gets the color of i, starting from 1, so that vertices adjacent to
+ * each other or to a common vertex differ; the pattern of A must be
+ * symmetric. With partial, w has A.ncols entries and only columns sharing a
+ * row must differ, which is the column grouping for compressing a sparse
+ * Jacobian A.
+ */
+template <typename W, typename a>
+Info distance2Color(Vector<W>*       w,
+                    const Matrix<a>* A,
+                    bool             partial,
+                    Descriptor*      desc) {
+  if (w == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, w_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(w->size(&w_nsize));
+  if ((!partial && A_nrows != A_ncols) || w_nsize != A_ncols)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::distance2Color(&w->vector_, &A->matrix_, partial,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Luby maximal independent set, on the CPU backend only. v(i) gets 1 if i
+ * is in the set, else 0. Priorities are hashed from (seed, vertex, round),
+ * and the candidates are compacted every round so only the edges of
+ * undecided vertices are read. The pattern of A must be symmetric.
+ */
+template <typename T, typename a>
+Info lubyMis(Vector<T>*       v,
+             const Matrix<a>* A,
+             Index            seed,
+             Descriptor*      desc) {
+  if (v == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::lubyMis(&v->vector_, &A->matrix_, seed,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Connected components by Afforest, on the CPU backend only. v(i) gets the
+ * smallest vertex id in the component of i. A few neighbours per vertex are
+ * linked first, and then only vertices outside the largest component (found
+ * by sampling with seed) read the rest of their edges. If A is not symmetric
+ * the components are weakly connected ones.
+ */
+template <typename T, typename a>
+Info afforest(Vector<T>*       v,
+              const Matrix<a>* A,
+              Index            seed,
+              Descriptor*      desc) {
+  if (v == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::afforest(&v->vector_, &A->matrix_, seed,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Residual-push PageRank with in-place (Gauss-Seidel) updates, on the CPU
+ * backend only. A is alpha*A/outdegree as for algorithm::pr. Vertices are
+ * pushed while their residual is above eps, and rank on dangling vertices is
+ * spread over all vertices.
+ */
+template <typename T, typename a>
+Info pageRankPush(Vector<T>*       p,
+                  const Matrix<a>* A,
+                  double           alpha,
+                  double           eps,
+                  Descriptor*      desc) {
+  if (p == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, p_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(p->size(&p_nsize));
+  if (A_nrows != A_ncols || p_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+  if (alpha < 0. || alpha >= 1. || eps <= 0.)
+    return GrB_INVALID_VALUE;
+
+  return backend::pageRankPush(&p->vector_, &A->matrix_, alpha, eps,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Approximate PageRank personalized to s by ACL push, with the lazy-walk
+ * updates of algorithm::lgc, on the CPU backend only. p is a sparse vector
+ * of the vertices that received rank. Only vertices reached by a push are
+ * ever stored or have their degree read, so the cost follows the size of
+ * the cluster rather than A.nrows.
+ */
+template <typename T, typename a>
+Info lgcPush(Vector<T>*       p,
+             const Matrix<a>* A,
+             Index            s,
+             double           alpha,
+             double           eps,
+             Descriptor*      desc) {
+  if (p == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, p_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(p->size(&p_nsize));
+  if (A_nrows != A_ncols || p_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+  if (s < 0 || s >= A_nrows)
+    return GrB_INDEX_OUT_OF_BOUNDS;
+  if (alpha <= 0. || alpha > 1. || eps <= 0.)
+    return GrB_INVALID_VALUE;
+
+  return backend::lgcPush(&p->vector_, &A->matrix_, s, alpha, eps,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Batched personalized PageRank with the lazy-walk updates of
+ * algorithm::lgc. Column j of P (A.nrows x seeds.size()) gets the PageRank
+ * personalized to seeds[j], approximated until no residual is above eps
+ * times the vertex degree. By default all seeds run as one dense residual
+ * matrix that is multiplied by the column-stochastic A^T D^-1 with SpMM, and
+ * converged seeds drop out of the product. With push, each seed instead
+ * pushes its own sparse residual as in lgc (CPU backend only).
+ */
+template <typename T, typename a>
+Info pprBatch(Matrix<T>*                P,
+              const Matrix<a>*          A,
+              const std::vector<Index>* seeds,
+              double                    alpha,
+              double                    eps,
+              bool                      push,
+              Descriptor*               desc) {
+  if (P == NULL || A == NULL || seeds == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, P_nrows, P_ncols;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(P->nrows(&P_nrows));
+  CHECK(P->ncols(&P_ncols));
+  Index nseeds = seeds->size();
+  if (A_nrows != A_ncols || P_nrows != A_nrows || P_ncols != nseeds)
+    return GrB_DIMENSION_MISMATCH;
+  if (nseeds == 0 || alpha <= 0. || alpha > 1. || eps <= 0.)
+    return GrB_INVALID_VALUE;
+  for (Index k = 0; k < nseeds; ++k)
+    if ((*seeds)[k] < 0 || (*seeds)[k] >= A_nrows)
+      return GrB_INDEX_OUT_OF_BOUNDS;
+
+  return backend::pprBatch(&P->matrix_, &A->matrix_, seeds->data(), nseeds,
+      alpha, eps, push, &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Betweenness centrality from the given sources by Brandes' algorithm, on
+ * the CPU backend only. v(i) gets scale times the sum over the sources s of
+ * the dependency of s on i, i.e. the fraction of shortest paths from s that
+ * pass through i. Sources run batch at a time: the forward search of a
+ * batch is a PlusTimes product of A^T and an A.nrows x batch frontier under
+ * the complement of the visited mask, and the dependencies are accumulated
+ * back with products of A.
+ */
+template <typename T, typename a>
+Info bcBatch(Vector<T>*                v,
+             const Matrix<a>*          A,
+             const std::vector<Index>* sources,
+             Index                     batch,
+             double                    scale,
+             Descriptor*               desc) {
+  if (v == NULL || A == NULL || sources == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+  Index nsources = sources->size();
+  if (nsources == 0 || batch <= 0)
+    return GrB_INVALID_VALUE;
+  for (Index k = 0; k < nsources; ++k)
+    if ((*sources)[k] < 0 || (*sources)[k] >= A_nrows)
+      return GrB_INDEX_OUT_OF_BOUNDS;
+
+  return backend::bcBatch(&v->vector_, &A->matrix_, sources->data(),
+      nsources, batch, scale, &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * k-core decomposition by parallel bucket peeling, on the CPU backend only.
+ * degree holds the degree of each vertex, e.g. the row sums of A from
+ * reduce. v(i) gets the core number of i: the largest k such that i is in a
+ * subgraph where every vertex has degree at least k. The pattern of A must
+ * be symmetric.
+ */
+template <typename T, typename a, typename U>
+Info kcorePeel(Vector<T>*       v,
+               const Matrix<a>* A,
+               const Vector<U>* degree,
+               Descriptor*      desc) {
+  if (v == NULL || A == NULL || degree == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize, degree_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  CHECK(degree->size(&degree_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows || degree_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::kcorePeel(&v->vector_, &A->matrix_, &degree->vector_,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * k-truss by support peeling, on the CPU backend only. C gets the edges of
+ * the k-truss of A (every edge in at least k - 2 triangles within it), in
+ * both directions and valued by their support. With k == 0, C gets every
+ * edge of A valued by its truss number. The pattern of A must be symmetric
+ * and its rows sorted.
+ */
+template <typename c, typename a>
+Info ktruss(Matrix<c>*       C,
+            const Matrix<a>* A,
+            Index            k,
+            Descriptor*      desc) {
+  if (C == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, C_nrows, C_ncols;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(C->nrows(&C_nrows));
+  CHECK(C->ncols(&C_ncols));
+  if (A_nrows != A_ncols || C_nrows != A_nrows || C_ncols != A_ncols)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::ktruss(&C->matrix_, &A->matrix_, k, &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Label propagation community detection, on the CPU backend only. Each
+ * vertex repeatedly takes the label of largest total edge weight among its
+ * neighbours, until no label changes or after max_niter iterations. With
+ * async, labels are updated in place instead of once per iteration. v(i)
+ * gets the label of i, the id of a vertex in its community. The pattern of
+ * A must be symmetric.
+ */
+template <typename T, typename a>
+Info labelProp(Vector<T>*       v,
+               const Matrix<a>* A,
+               bool             async,
+               Descriptor*      desc) {
+  if (v == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::labelProp(&v->vector_, &A->matrix_, async,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Louvain local moving phase, on the CPU backend only. Vertices of the
+ * weighted graph A (self loops allowed) move between communities while
+ * modularity rises. v(i) gets the community of i, numbered from 0 with no
+ * gaps, so v gives the columns of the aggregation matrix P for P^T A P.
+ */
+template <typename T, typename a>
+Info louvainMove(Vector<T>*       v,
+                 const Matrix<a>* A,
+                 Descriptor*      desc) {
+  if (v == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::louvainMove(&v->vector_, &A->matrix_, &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ *
+ * Modularity of the partition of A given by the labels in v, which must be
+ * in [0, nrows), on the CPU backend only.
+ */
+template <typename a, typename T>
+Info modularity(double*          q,
+                const Matrix<a>* A,
+                const Vector<T>* v,
+                Descriptor*      desc) {
+  if (q == NULL || A == NULL || v == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  Index A_nrows, A_ncols, v_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(v->size(&v_nsize));
+  if (A_nrows != A_ncols || v_nsize != A_nrows)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::modularity(q, &A->matrix_, &v->vector_, &desc->descriptor_);
+}
+
 /*!
  * Extension method
  * Fused apply & vector-matrix product
@@ -864,6 +1332,181 @@ Info applyVxm(Vector<W>*       w,
       &u->vector_, &A->matrix_, desc_t);
 }
 
+/*!
+ * Extension method
+ * Fused vector-matrix product & reduction
+ *   w^T = w^T + mask^T .* (u^T * A)    +: accum
+ *                                      *: op
+ *                                     .*: Boolean and
+ *   val = \sum_i w(i) for all i      sum: reduce_op
+ *
+ * Masked-out w(i) keep their value, or are cleared under GrB_REPLACE.
+ */
+template <typename W, typename T, typename M, typename U, typename a,
+          typename BinaryOpT, typename MonoidT, typename SemiringT>
+Info vxmReduce(Vector<W>*       w,
+               T*               val,
+               const Vector<M>* mask,
+               BinaryOpT        accum,
+               MonoidT          reduce_op,
+               SemiringT        op,
+               const Vector<U>* u,
+               const Matrix<a>* A,
+               Descriptor*      desc) {
+  // Null pointer check
+  if (w == NULL || val == NULL || u == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  // Dimension check
+  CHECK(checkDimRowSize(A,  u,    "A.nrows != u.size"));
+  CHECK(checkDimColSize(A,  w,    "A.ncols != w.size"));
+  CHECK(checkDimSizeSize(w, mask, "w.size  != mask.size"));
+
+  const backend::Vector<M>* mask_t = (mask == NULL) ? NULL : &mask->vector_;
+  backend::Descriptor*      desc_t = (desc == NULL) ? NULL : &desc->descriptor_;
+
+  return backend::vxmReduce<W, T, U, a, M>(&w->vector_, val, mask_t, accum,
+      reduce_op, op, &u->vector_, &A->matrix_, desc_t);
+}
+
+/*!
+ * Extension method
+ * Fused vector-matrix product & relaxation
+ *   w^T = w^T + mask^T .* (u^T * A)    +: accum
+ *                                      *: op
+ *                                     .*: Boolean and
+ *   changed(i) = w(i) if this op changed w(i), else identity of op
+ *   nchanged   = number of changed elements
+ *
+ * Masked-out w(i) keep their value, or are cleared under GrB_REPLACE without
+ * counting as changed.
+ *
+ * With MinimumPlusSemiring and accum minimum, this is one SSSP step and
+ * changed is the next frontier.
+ */
+template <typename W, typename M, typename U, typename a,
+          typename BinaryOpT, typename SemiringT>
+Info vxmAccumMask(Vector<W>*       w,
+                  Vector<W>*       changed,
+                  Index*           nchanged,
+                  const Vector<M>* mask,
+                  BinaryOpT        accum,
+                  SemiringT        op,
+                  const Vector<U>* u,
+                  const Matrix<a>* A,
+                  Descriptor*      desc) {
+  // Null pointer check
+  if (w == NULL || changed == NULL || nchanged == NULL || u == NULL ||
+      A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+  if (w == changed)
+    return GrB_INVALID_OBJECT;
+
+  // Dimension check
+  CHECK(checkDimRowSize(A,  u,       "A.nrows != u.size"));
+  CHECK(checkDimColSize(A,  w,       "A.ncols != w.size"));
+  CHECK(checkDimSizeSize(w, changed, "w.size  != changed.size"));
+  CHECK(checkDimSizeSize(w, mask,    "w.size  != mask.size"));
+
+  const backend::Vector<M>* mask_t = (mask == NULL) ? NULL : &mask->vector_;
+  backend::Descriptor*      desc_t = (desc == NULL) ? NULL : &desc->descriptor_;
+
+  return backend::vxmAccumMask<W, U, a, M>(&w->vector_, &changed->vector_,
+      nchanged, mask_t, accum, op, &u->vector_, &A->matrix_, desc_t);
+}
+
+/*!
+ * Extension method
+ * Sparse-dense matrix product over a column mask, with relaxation
+ *   C(:, j) = C(:, j) + A * B(:, j) for j with mask(j) != 0    +: accum
+ *                                                              *: op
+ *   mask(j) = 1 if this op changed C(:, j), else 0
+ *   nactive = number of changed columns
+ *
+ * A is sparse and B, C are dense (B and C may be the same matrix). With
+ * MinimumPlusSemiring and accum minimum this is one Bellman-Ford step for
+ * every source column of B, and the columns that stop changing drop out of
+ * the mask.
+ */
+template <typename c, typename M, typename a, typename b,
+          typename BinaryOpT, typename SemiringT>
+Info mxmAccumMask(Matrix<c>*       C,
+                  Vector<M>*       mask,
+                  Index*           nactive,
+                  BinaryOpT        accum,
+                  SemiringT        op,
+                  const Matrix<a>* A,
+                  const Matrix<b>* B,
+                  Descriptor*      desc) {
+  // Null pointer check
+  if (C == NULL || mask == NULL || A == NULL || B == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  // Dimension check on op(A) and op(B), transposed as the descriptor says
+  Desc_value inp0_mode, inp1_mode;
+  CHECK(desc->get(GrB_INP0, &inp0_mode));
+  CHECK(desc->get(GrB_INP1, &inp1_mode));
+  Index A_nrows, A_ncols, B_nrows, B_ncols, C_nrows, C_ncols, mask_nsize;
+  CHECK(A->nrows(&A_nrows));
+  CHECK(A->ncols(&A_ncols));
+  CHECK(B->nrows(&B_nrows));
+  CHECK(B->ncols(&B_ncols));
+  CHECK(C->nrows(&C_nrows));
+  CHECK(C->ncols(&C_ncols));
+  CHECK(mask->size(&mask_nsize));
+  if (inp0_mode == GrB_TRAN)
+    std::swap(A_nrows, A_ncols);
+  if (inp1_mode == GrB_TRAN)
+    std::swap(B_nrows, B_ncols);
+  if (B_nrows != A_ncols) {
+    std::cout << "B.nrows != A.ncols" << std::endl;
+    return GrB_DIMENSION_MISMATCH;
+  }
+  if (A_nrows != C_nrows) {
+    std::cout << "A.nrows != C.nrows" << std::endl;
+    return GrB_DIMENSION_MISMATCH;
+  }
+  if (B_ncols != C_ncols) {
+    std::cout << "B.ncols != C.ncols" << std::endl;
+    return GrB_DIMENSION_MISMATCH;
+  }
+  if (B_ncols != mask_nsize)
+    return GrB_DIMENSION_MISMATCH;
+
+  return backend::mxmAccumMask<c, a, b, M>(&C->matrix_, &mask->vector_,
+      nactive, accum, op, &A->matrix_, &B->matrix_, &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ * Fused element-wise multiply & reduction (dot product under a semiring)
+ *   val = \sum_i u(i) * v(i) for all i    sum: add of op
+ *                                           *: multiply of op
+ *
+ * Elements equal to the identity of op are skipped as in eWiseMult. For
+ * squared distance, pass the difference to eWiseMultReduce as both u and v.
+ */
+template <typename T, typename U, typename V,
+          typename BinaryOpT, typename SemiringT>
+Info eWiseMultReduce(T*               val,
+                     BinaryOpT        accum,
+                     SemiringT        op,
+                     const Vector<U>* u,
+                     const Vector<V>* v,
+                     Descriptor*      desc) {
+  // Null pointer check
+  if (val == NULL || u == NULL || v == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  // Dimension check
+  CHECK(checkDimSizeSize(u, v, "u.size != v.size"));
+
+  backend::Descriptor* desc_t = (desc == NULL) ? NULL : &desc->descriptor_;
+
+  return backend::eWiseMultReduce(val, accum, op, &u->vector_, &v->vector_,
+      desc_t);
+}
+
 /*!
  * Extension method
  * Zeroes out matrix above main diagonal
@@ -884,6 +1527,56 @@ Info tril(Matrix<c>*  C,
 
   return backend::tril(&C->matrix_, &A->matrix_, desc_t);
 }
+
+/*!
+ * Extension method
+ * Lower triangle of A after relabeling vertices by descending degree, so
+ * each edge is kept once, at its lower-degree end. Rows of C are sorted.
+ * perm (may be GrB_NULL) gets the old id of each new vertex. Runs on the
+ * host with either backend.
+ */
+template <typename c, typename a>
+Info trilDegree(Matrix<c>*          C,
+                std::vector<Index>* perm,
+                const Matrix<a>*    A,
+                Descriptor*         desc) {
+  // Null pointer check
+  if (C == NULL || A == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  // Dimension check
+  CHECK(checkDimRowCol(A, A, "A.nrows != A.ncols"));
+  CHECK(checkDimRowRow(A, C, "A.nrows != C.nrows"));
+  CHECK(checkDimColCol(A, C, "A.ncols != C.ncols"));
+
+  Index A_nrows;
+  CHECK(A->nrows(&A_nrows));
+  if (perm != NULL)
+    perm->resize(A_nrows);
+  Index* perm_t = (perm == NULL) ? NULL : perm->data();
+
+  return backend::trilDegree(&C->matrix_, perm_t, &A->matrix_,
+      &desc->descriptor_);
+}
+
+/*!
+ * Extension method
+ * Counts triangles of a lower triangular L with sorted rows (as from tril or
+ * trilDegree) by merge intersection of L(i, :) and L(j, :) for each L(i, j)
+ */
+template <typename T, typename a>
+Info tcIntersect(T*               ntris,
+                 const Matrix<a>* L,
+                 Descriptor*      desc) {
+  // Null pointer check
+  if (ntris == NULL || L == NULL || desc == NULL)
+    return GrB_UNINITIALIZED_OBJECT;
+
+  // Dimension check
+  CHECK(checkDimRowCol(L, L, "L.nrows != L.ncols"));
+
+  return backend::tcIntersect(ntris, &L->matrix_, &desc->descriptor_);
+}
 }  // namespace graphblas
 
 #endif  // GRAPHBLAS_OPERATIONS_HPP_
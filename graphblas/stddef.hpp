@@ -143,6 +143,8 @@ struct select_second {
 template <typename T_out>                                                    \
 struct M_NAME                                                                \
 {                                                                            \
+  typedef BINARYOP<T_out> op_type;                                           \
+                                                                             \
   inline T_out identity() const                                              \
   {                                                                          \
     return static_cast<T_out>(IDENTITY);                                     \
@@ -179,6 +181,8 @@ struct SR_NAME                                                            \
 {                                                                         \
   typedef T_out result_type;                                              \
   typedef T_out T_out_type;                                               \
+  typedef ADD_MONOID<T_out> add_monoid_type;                              \
+  typedef MULT_BINARYOP<T_in1, T_in2, T_out> mul_op_type;                 \
                                                                           \
   inline T_out identity() const                                           \
   { return ADD_MONOID<T_out>().identity(); }                              \
@@ -208,6 +212,7 @@ REGISTER_SEMIRING(MinimumMultipliesSemiring, MinimumMonoid, multiplies)
 REGISTER_SEMIRING(MultipliesMultipliesSemiring, MultipliesMonoid, multiplies)
 REGISTER_SEMIRING(NotEqualToPlusSemiring, NotEqualToMonoid, plus)
 REGISTER_SEMIRING(MinimumSelectSecondSemiring, MinimumMonoid, select_second)
+REGISTER_SEMIRING(MaximumSelectSecondSemiring, MaximumMonoid, select_second)
 REGISTER_SEMIRING(PlusNotEqualToSemiring, PlusMonoid, not_equal_to)
 REGISTER_SEMIRING(CustomLessLessSemiring, CustomLessMonoid, less)
 REGISTER_SEMIRING(MinimumNotEqualToSemiring, MinimumMonoid, not_equal_to)
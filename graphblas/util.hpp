@@ -3,10 +3,18 @@
 
 #include <sys/resource.h>
 #include <sys/time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
 #include <libgen.h>
+#include <sched.h>
+#include <unistd.h>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <vector>
+#include <map>
+#include <utility>
 #include <tuple>
 #include <algorithm>
 #include <string>
@@ -15,19 +23,31 @@
 // for commandline arguments
 #include <boost/program_options.hpp>
 
-#define CHECK(x) do {                                           \
-  graphblas::Info err = x;                                      \
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// for NUMA interleaving and replication (link with -lnuma)
+#ifdef GRB_USE_NUMA
+#include <numa.h>
+#include <numaif.h>
+#endif
+
+// Variadic so that calls with explicit template arguments, such as
+// CHECK(vxm<float, float, float, float>(...)), are one macro argument
+#define CHECK(...) do {                                         \
+  graphblas::Info err = __VA_ARGS__;                            \
   if (err != graphblas::GrB_SUCCESS) {                          \
     fprintf(stderr, "Runtime error: %s returned %d at %s:%d\n", \
-            #x, err, __FILE__, __LINE__);                       \
+            #__VA_ARGS__, err, __FILE__, __LINE__);             \
     return err;                                                 \
   } } while (0)
 
-#define CHECKVOID(x) do {                                       \
-  graphblas::Info err = x;                                      \
+#define CHECKVOID(...) do {                                     \
+  graphblas::Info err = __VA_ARGS__;                            \
   if (err != graphblas::GrB_SUCCESS) {                          \
     fprintf(stderr, "Runtime error: %s returned %d at %s:%d\n", \
-            #x, err, __FILE__, __LINE__);                       \
+            #__VA_ARGS__, err, __FILE__, __LINE__);             \
     return;                                                     \
   } } while (0)
 
@@ -99,17 +119,45 @@ void parseArgs(int argc, char**argv, po::variables_map* vm) {
 
     // mxv (spmv/pull) params
     ("earlyexit", po::value<bool>()->default_value(true),
-        "True means use early exit, False means do not use it when using Boolean LogicalOrAndSemiring")  // NOLINT(whitespace/line_length)
+        "True means use early exit, False means do not use it when using Boolean LogicalOrAndSemiring or MaximumSelectSecondSemiring")  // NOLINT(whitespace/line_length)
     ("fusedmask", po::value<bool>()->default_value(true),
-        "True means use fused mask in pull direction when using LogicalOrAnd semiring, False means do not do it")  // NOLINT(whitespace/line_length)
+        "True means use fused mask in pull direction when using LogicalOrAnd or MaximumSelectSecond semiring, False means do not do it")  // NOLINT(whitespace/line_length)
 
     // algorithm-specific params
     ("maxcolors", po::value<int>()->default_value(10000),
         "Upper bound on colors when graph coloring algorithm is used")
     ("gcalgo", po::value<int>()->default_value(0),
-        "0: Jones-Plassman, 1: Maximal independent set, 2: Independent set")
+        "0: Jones-Plassman, 1: Maximal independent set, 2: Independent set, 3: Speculative greedy (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("gcorder", po::value<int>()->default_value(0),
+        "Vertex order for speculative greedy coloring, 0: Natural, 1: Largest degree first, 2: Smallest-last")  // NOLINT(whitespace/line_length)
+    ("partial", po::value<bool>()->default_value(false),
+        "True means distance-2 coloring colors the columns so no two in a row share a color (Jacobian compression)")  // NOLINT(whitespace/line_length)
+    ("mesh", po::value<int>()->default_value(0),
+        "Side of a synthetic 2D 9-point stencil mesh to use instead of a matrix file, 0 means read the file")  // NOLINT(whitespace/line_length)
+    ("misalgo", po::value<int>()->default_value(0),
+        "0: Luby by vxm, 1: Luby with compacted candidate bitmap (CPU backend)")  // NOLINT(whitespace/line_length)
     ("ccalgo", po::value<int>()->default_value(0),
-        "0: LACC")
+        "0: FastSV, 1: Afforest (CPU backend)")
+    ("tcalgo", po::value<int>()->default_value(0),
+        "0: Masked SpGEMM in file order, 1: Masked SpGEMM after degree ordering, 2: Merge intersection after degree ordering")  // NOLINT(whitespace/line_length)
+    ("pralgo", po::value<int>()->default_value(0),
+        "0: Power iteration, 1: Residual push, 2: Residual push with in-place updates (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("lgcalgo", po::value<int>()->default_value(0),
+        "0: Single-seed LGC, 1: Batched personalized PageRank by SpMM, 2: Batched personalized PageRank by push (CPU backend), 3: Single-seed ACL push with sparse vectors (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("kcorealgo", po::value<int>()->default_value(0),
+        "0: Peeling by masked vxm and assign, 1: Parallel bucket peeling (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("communityalgo", po::value<int>()->default_value(0),
+        "0: Louvain, 1: Label propagation, 2: Label propagation with in-place updates (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("ktrussk", po::value<int>()->default_value(0),
+        "k of the k-truss to extract, 0 means full truss decomposition (CPU backend)")  // NOLINT(whitespace/line_length)
+    ("bcbatch", po::value<int>()->default_value(64),
+        "Sources per batch in betweenness centrality")
+    ("bcsamples", po::value<int>()->default_value(0),
+        "Sources sampled for approximate betweenness centrality, 0 means exact (every vertex is a source)")  // NOLINT(whitespace/line_length)
+    ("parent", po::value<bool>()->default_value(false),
+        "True means BFS also computes and verifies the BFS tree (parent of each vertex)")  // NOLINT(whitespace/line_length)
+    ("delta", po::value<float>()->default_value(-1.f),
+        "Bucket width for delta-stepping SSSP on the CPU backend, 0 means pick it from edge weights, negative means use Bellman-Ford SSSP")  // NOLINT(whitespace/line_length)
     ("seed", po::value<int>()->default_value(-1),
         "Random number generator seed for algorithms with random component i.e. SSSP for determining edge weight, GC for determining random vertex weight")  // NOLINT(whitespace/line_length)
 
@@ -498,6 +546,285 @@ struct CpuTimer {
 
 using namespace graphblas;
 
+/*!
+ * NUMA helpers for host-side graph arrays. Without GRB_USE_NUMA these fall
+ * back to a single node and plain malloc, so placement is by first-touch.
+ */
+inline int numaNodes() {
+#ifdef GRB_USE_NUMA
+  if (numa_available() >= 0)
+    return numa_num_configured_nodes();
+#endif
+  return 1;
+}
+
+// Node of the CPU the calling thread is currently running on
+inline int numaNode() {
+#ifdef GRB_USE_NUMA
+  if (numa_available() >= 0) {
+    int node = numa_node_of_cpu(sched_getcpu());
+    return (node < 0) ? 0 : node;
+  }
+#endif
+  return 0;
+}
+
+inline int numThreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// Id of the calling thread in the enclosing parallel region
+inline int threadId() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+// Spreads pages of [ptr, ptr+bytes) round-robin across all nodes. Only whole
+// pages inside the range are affected, so the first and last partial pages
+// keep their first-touch placement.
+inline void numaInterleave(void* ptr, size_t bytes) {
+#ifdef GRB_USE_NUMA
+  if (ptr == NULL || numa_available() < 0) return;
+  size_t page  = sysconf(_SC_PAGESIZE);
+  size_t start = (reinterpret_cast<size_t>(ptr) + page - 1) & ~(page - 1);
+  size_t end   = (reinterpret_cast<size_t>(ptr) + bytes) & ~(page - 1);
+  if (end <= start) return;
+  struct bitmask* nodes = numa_get_mems_allowed();
+  if (mbind(reinterpret_cast<void*>(start), end - start, MPOL_INTERLEAVE,
+      nodes->maskp, nodes->size + 1, MPOL_MF_MOVE) != 0)
+    std::cout << "Warning: mbind interleave failed!\n";
+  numa_bitmask_free(nodes);
+#endif
+}
+
+inline void* numaAllocOnNode(size_t bytes, int node) {
+#ifdef GRB_USE_NUMA
+  if (numa_available() >= 0)
+    return numa_alloc_onnode(bytes, node);
+#endif
+  return malloc(bytes);
+}
+
+inline void numaFree(void* ptr, size_t bytes) {
+  if (ptr == NULL) return;
+#ifdef GRB_USE_NUMA
+  if (numa_available() >= 0) {
+    numa_free(ptr, bytes);
+    return;
+  }
+#endif
+  free(ptr);
+}
+
+// Copies n elements of src into memory bound to node
+template <typename T>
+T* numaReplicate(const T* src, size_t n, int node) {
+  if (src == NULL) return NULL;
+  T* dst = reinterpret_cast<T*>(numaAllocOnNode(n*sizeof(T), node));
+  memcpy(dst, src, n*sizeof(T));
+  return dst;
+}
+
+/*!
+ * Pins each OpenMP thread to one CPU so that the row range a thread touches
+ * during construction stays on the same node for later computation.
+ *   GRB_NUMA_PIN_THREADS=1 (compact): fill all CPUs of node 0, then node 1...
+ *   GRB_NUMA_PIN_THREADS=2 (scatter): round-robin threads across nodes
+ * Pinning is done once per process unless force is set.
+ */
+inline void numaPinThreads(bool force = false) {
+  static bool pinned = false;
+  int mode = getEnv("GRB_NUMA_PIN_THREADS", 0);
+  if (mode == 0 || (pinned && !force)) return;
+  pinned = true;
+
+  // Build CPU order grouped by node
+  std::vector<std::vector<int> > node_cpus(numaNodes());
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &allowed)) continue;
+    int node = 0;
+#ifdef GRB_USE_NUMA
+    if (numa_available() >= 0) node = numa_node_of_cpu(cpu);
+#endif
+    if (node >= 0 && node < static_cast<int>(node_cpus.size()))
+      node_cpus[node].push_back(cpu);
+  }
+
+  std::vector<int> order;
+  if (mode == 1) {
+    for (int node = 0; node < node_cpus.size(); ++node)
+      order.insert(order.end(), node_cpus[node].begin(), node_cpus[node].end());
+  } else {
+    for (int i = 0; order.size() < CPU_COUNT(&allowed); ++i)
+      for (int node = 0; node < node_cpus.size(); ++node)
+        if (i < node_cpus[node].size())
+          order.push_back(node_cpus[node][i]);
+  }
+  if (order.empty()) return;
+
+  #pragma omp parallel
+  {
+    int tid = 0;
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(order[tid % order.size()], &cpus);
+    sched_setaffinity(0, sizeof(cpus), &cpus);
+  }
+}
+
+/*!
+ * Huge page backed host allocation for large graph arrays. Random gathers
+ * into multi-GB colInd/val arrays otherwise thrash the TLB. Requests of at
+ * least GRB_HUGEPAGE_THRESHOLD MB are mmap'ed instead of malloc'ed:
+ *   GRB_HUGEPAGE=1: anonymous 2MB-aligned mapping with MADV_HUGEPAGE (THP)
+ *   GRB_HUGEPAGE=2: MAP_HUGETLB from the hugetlbfs pool with page size
+ *                   GRB_HUGEPAGE_SIZE MB (2 or 1024), falling back to THP
+ * Anything else, or any failure, falls back to malloc. Memory must be freed
+ * with hostFree(), which also accepts malloc'ed pointers.
+ */
+inline std::map<void*, std::pair<void*, size_t> >& hostMappings() {
+  static std::map<void*, std::pair<void*, size_t> > mappings;
+  return mappings;
+}
+
+inline void* hostAlloc(size_t bytes) {
+  int    mode      = getEnv("GRB_HUGEPAGE", 0);
+  size_t threshold = getEnv("GRB_HUGEPAGE_THRESHOLD", 32);
+  if (mode == 0 || bytes < (threshold << 20))
+    return malloc(bytes);
+
+#ifdef MAP_HUGETLB
+  if (mode == 2) {
+    size_t page = static_cast<size_t>(getEnv("GRB_HUGEPAGE_SIZE", 2)) << 20;
+    size_t length = (bytes + page - 1) & ~(page - 1);
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    flags |= ((page == (1 << 30)) ? 30 : 21) << MAP_HUGE_SHIFT;
+#endif
+    void* ptr = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr != MAP_FAILED) {
+      hostMappings()[ptr] = std::make_pair(ptr, length);
+      return ptr;
+    }
+    std::cout << "Warning: hugetlbfs allocation of " << bytes <<
+        " bytes failed, falling back to THP!\n";
+  }
+#endif
+
+#ifdef MADV_HUGEPAGE
+  // Over-allocate so the usable range starts on a 2MB boundary, since THP
+  // can only back aligned 2MB extents
+  size_t page   = 1 << 21;
+  size_t length = bytes + page;
+  void*  base   = mmap(NULL, length, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base != MAP_FAILED) {
+    void* ptr = reinterpret_cast<void*>(
+        (reinterpret_cast<size_t>(base) + page - 1) & ~(page - 1));
+    if (madvise(ptr, bytes, MADV_HUGEPAGE) != 0)
+      std::cout << "Warning: madvise(MADV_HUGEPAGE) failed!\n";
+    hostMappings()[ptr] = std::make_pair(base, length);
+    return ptr;
+  }
+#endif
+  return malloc(bytes);
+}
+
+inline void hostFree(void* ptr) {
+  if (ptr == NULL) return;
+  std::map<void*, std::pair<void*, size_t> >::iterator it =
+      hostMappings().find(ptr);
+  if (it == hostMappings().end()) {
+    free(ptr);
+  } else {
+    munmap(it->second.first, it->second.second);
+    hostMappings().erase(it);
+  }
+}
+
+/*!
+ * Maps a whole file read-only and asks for huge pages (honoured for files on
+ * hugetlbfs/tmpfs, or when the kernel supports read-only THP for page cache).
+ * Returns NULL on failure.
+ */
+inline void* mmapFile(const char* fname, size_t* bytes) {
+  int fd = open(fname, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return NULL;
+  }
+  *bytes = st.st_size;
+  void* ptr = mmap(NULL, *bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) return NULL;
+#ifdef MADV_HUGEPAGE
+  if (getEnv("GRB_HUGEPAGE", 0) != 0)
+    madvise(ptr, *bytes, MADV_HUGEPAGE);
+#endif
+  madvise(ptr, *bytes, MADV_SEQUENTIAL);
+  return ptr;
+}
+
+inline void munmapFile(void* ptr, size_t bytes) {
+  if (ptr != NULL) munmap(ptr, bytes);
+}
+
+/*!
+ * Prints page size statistics from /proc/self/smaps for the mapping that
+ * contains ptr if GRB_HUGEPAGE_STATS=1. Only pages touched so far count
+ * towards AnonHugePages, so call this after the array has been written.
+ */
+inline void printPageStats(const char* str, const void* ptr) {
+  if (ptr == NULL || getEnv("GRB_HUGEPAGE_STATS", 0) == 0) return;
+  std::ifstream smaps("/proc/self/smaps");
+  if (smaps.fail()) return;
+
+  size_t addr = reinterpret_cast<size_t>(ptr);
+  std::string line;
+  bool found = false;
+  size_t size_kb = 0, kernel_kb = 0, anon_huge_kb = 0, hugetlb_kb = 0;
+  while (std::getline(smaps, line)) {
+    size_t start, end;
+    if (sscanf(line.c_str(), "%zx-%zx ", &start, &end) == 2 &&
+        line.find(':') > line.find(' ')) {
+      if (found) break;
+      found = (start <= addr && addr < end);
+      continue;
+    }
+    if (!found) continue;
+    sscanf(line.c_str(), "Size: %zu kB", &size_kb);
+    sscanf(line.c_str(), "KernelPageSize: %zu kB", &kernel_kb);
+    sscanf(line.c_str(), "AnonHugePages: %zu kB", &anon_huge_kb);
+    sscanf(line.c_str(), "Private_Hugetlb: %zu kB", &hugetlb_kb);
+  }
+  if (!found) return;
+  std::cout << str << ": mapping " << size_kb << " kB, page size " <<
+      kernel_kb << " kB, THP " << anon_huge_kb << " kB, hugetlb " <<
+      hugetlb_kb << " kB\n";
+}
+
+/*!
+ * Requires COO to be sorted by row, then column, so element i of the sorted
+ * COO goes to slot i of csrColInd. This lets each thread write exactly the row
+ * range it owns under the same static schedule the CPU backend uses, so with
+ * first-touch placement the pages of csrRowPtr, csrColInd and csrVal land on
+ * the node of the thread that later reads them.
+ */
 template <typename T>
 void coo2csr(Index*                    csrRowPtr,
              Index*                    csrColInd,
@@ -507,7 +834,6 @@ void coo2csr(Index*                    csrRowPtr,
              const std::vector<T>&     values,
              Index                     nrows,
              Index                     ncols) {
-  Index temp, row, col, dest, cumsum = 0;
   Index nvals = row_indices.size();
 
   std::vector<Index> row_indices_t = row_indices;
@@ -516,46 +842,35 @@ void coo2csr(Index*                    csrRowPtr,
 
   customSort<T>(&row_indices_t, &col_indices_t, &values_t);
 
-  // Set all rowPtr to 0
-  for (Index i = 0; i <= nrows; i++)
-    csrRowPtr[i] = 0;
-
   // Go through all elements to see how many fall in each row
+  // -done in temporary storage so csrRowPtr is not touched by one thread
+  std::vector<Index> row_ptr_t(nrows+1, 0);
   for (Index i = 0; i < nvals; i++) {
-    row = row_indices_t[i];
-    if (row >= nrows) std::cout << "Error: Index out of bounds!\n";
-    csrRowPtr[row]++;
+    Index row = row_indices_t[i];
+    if (row >= nrows)
+      std::cout << "Error: Index out of bounds!\n";
+    else
+      row_ptr_t[row+1]++;
   }
 
   // Cumulative sum to obtain rowPtr
-  for (Index i = 0; i < nrows; i++) {
-    temp = csrRowPtr[i];
-    csrRowPtr[i] = cumsum;
-    cumsum += temp;
-  }
-  csrRowPtr[nrows] = nvals;
-
-  // Store colInd and val
-  for (Index i = 0; i < nvals; i++) {
-    row = row_indices_t[i];
-    dest = csrRowPtr[row];
-    col = col_indices_t[i];
-    if (col >= ncols) std::cout << "Error: Index out of bounds!\n";
-    csrColInd[dest] = col;
-    csrVal[dest] = values_t[i];
-    csrRowPtr[row]++;
-  }
-  cumsum = 0;
-
-  // Undo damage done to rowPtr
-  for (Index i = 0; i < nrows; i++) {
-    temp = csrRowPtr[i];
-    csrRowPtr[i] = cumsum;
-    cumsum = temp;
+  for (Index i = 0; i < nrows; i++)
+    row_ptr_t[i+1] += row_ptr_t[i];
+
+  numaPinThreads();
+
+  // Store rowPtr, colInd and val (first-touch)
+  #pragma omp parallel for schedule(static)
+  for (Index row = 0; row < nrows; row++) {
+    csrRowPtr[row] = row_ptr_t[row];
+    for (Index i = row_ptr_t[row]; i < row_ptr_t[row+1]; i++) {
+      Index col = col_indices_t[i];
+      if (col >= ncols) std::cout << "Error: Index out of bounds!\n";
+      csrColInd[i] = col;
+      csrVal[i] = values_t[i];
+    }
   }
-  temp = csrRowPtr[nrows];
-  csrRowPtr[nrows] = cumsum;
-  cumsum = temp;
+  csrRowPtr[nrows] = row_ptr_t[nrows];
 }
 
 template <typename T>
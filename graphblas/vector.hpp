@@ -72,7 +72,8 @@ Info Vector<T>::nnew(Index nsize) {
 
 template <typename T>
 Info Vector<T>::dup(const Vector* rhs) {
-  return vector_.dup(&rhs->vector_);
+  if (rhs == NULL) return GrB_NULL_POINTER;
+  return vector_.share(&rhs->vector_);
 }
 
 template <typename T>
@@ -157,7 +158,7 @@ Info Vector<T>::extractTuples(std::vector<T>* values,
 
 template <typename T>
 void Vector<T>::operator=(const Vector& rhs) {
-  vector_.dup(&rhs.vector_);
+  vector_.share(&rhs.vector_);
 }
 
 template <typename T>
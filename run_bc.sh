@@ -0,0 +1,11 @@
+for file in test_bc test_cc test_mesh test_mis test_pr small chesapeake
+do
+  echo bin/gbc --niter 10 --timing 1 --directed 1 data/small/$file.mtx
+  bin/gbc --niter 10 --timing 1 --directed 1 data/small/$file.mtx
+done
+
+for samples in 64 256 1024
+do
+  echo bin/gbc --niter 5 --timing 1 --directed 2 --bcsamples $samples data/small/chesapeake.mtx
+  bin/gbc --niter 5 --timing 1 --directed 2 --bcsamples $samples data/small/chesapeake.mtx
+done
@@ -0,0 +1,8 @@
+for algo in 0 1 2
+do
+  for file in simulated_blockmodel_graph_50_nodes simulated_blockmodel_graph_100_nodes test_cc test_mesh small chesapeake
+  do
+    echo bin/gcommunity --communityalgo $algo --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+    bin/gcommunity --communityalgo $algo --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+  done
+done
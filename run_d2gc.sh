@@ -0,0 +1,11 @@
+for file in test_bc test_cc test_mesh test_mis test_pr small chesapeake
+do
+  echo bin/gd2gc --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+  bin/gd2gc --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+done
+
+for side in 64 256 1024
+do
+  echo bin/gd2gc --niter 10 --timing 1 --mesh $side
+  bin/gd2gc --niter 10 --timing 1 --mesh $side
+done
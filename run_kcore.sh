@@ -0,0 +1,8 @@
+for algo in 0 1
+do
+  for file in test_bc test_cc test_mesh test_mis test_pr small chesapeake
+  do
+    echo bin/gkcore --kcorealgo $algo --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+    bin/gkcore --kcorealgo $algo --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+  done
+done
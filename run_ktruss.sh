@@ -0,0 +1,8 @@
+for k in 0 3 4 5
+do
+  for file in test_bc test_cc test_mesh test_mis test_pr small chesapeake
+  do
+    echo bin/gktruss --ktrussk $k --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+    bin/gktruss --ktrussk $k --niter 10 --timing 1 --directed 2 data/small/$file.mtx
+  done
+done
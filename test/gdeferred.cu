@@ -0,0 +1,98 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <vector>
+#include <iostream>
+#include <string>
+#include <cmath>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "graphblas/graphblas.hpp"
+#include "test/test.hpp"
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE deferred_suite
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+// PageRank error check: error = sum((p - p_prev)^2) with p = p_swap + c.
+// In nonblocking mode all three element-wise ops are deferred and fused into
+// the reduction.
+float l2loss(const std::vector<float>& swap_val,
+             const std::vector<float>& prev_val,
+             float                     c,
+             bool                      nonblocking) {
+  setenv("GRB_EXECUTION_MODE", nonblocking ? "1" : "0", 1);
+  graphblas::Index n = swap_val.size();
+  graphblas::Descriptor desc;
+
+  graphblas::Vector<float> p_swap(n);
+  graphblas::Vector<float> p_prev(n);
+  graphblas::Vector<float> p(n);
+  graphblas::Vector<float> r(n);
+  graphblas::Vector<float> r_temp(n);
+  CHECK(p_swap.build(&swap_val, n));
+  CHECK(p_prev.build(&prev_val, n));
+
+  CHECK(graphblas::eWiseAdd<float, float, float, float>(&p, GrB_NULL,
+      GrB_NULL, graphblas::PlusMultipliesSemiring<float>(), &p_swap, c,
+      &desc));
+  CHECK(graphblas::eWiseMult<float, float, float, float>(&r, GrB_NULL,
+      GrB_NULL, graphblas::PlusMinusSemiring<float>(), &p, &p_prev, &desc));
+  CHECK(graphblas::eWiseAdd<float, float, float, float>(&r_temp, GrB_NULL,
+      GrB_NULL, graphblas::MultipliesMultipliesSemiring<float>(), &r, &r,
+      &desc));
+  if (nonblocking) {
+    BOOST_ASSERT(p.vector_.pending_ != NULL);
+    BOOST_ASSERT(r_temp.vector_.pending_ != NULL);
+  }
+
+  float error = 0.f;
+  CHECK(graphblas::reduce<float, float>(&error, GrB_NULL,
+      graphblas::PlusMonoid<float>(), &r_temp, &desc));
+
+  // Observing p must still give p_swap + c
+  std::vector<float> p_val;
+  graphblas::Index p_nvals = n;
+  CHECK(p.extractTuples(&p_val, &p_nvals));
+  for (graphblas::Index i = 0; i < n; ++i)
+    BOOST_ASSERT(std::fabs(p_val[i] - (swap_val[i] + c)) < 1e-6);
+
+  setenv("GRB_EXECUTION_MODE", "0", 1);
+  return error;
+}
+
+struct TestVector {
+  TestVector() :
+    DEBUG(true) {}
+
+  bool DEBUG;
+};
+
+BOOST_AUTO_TEST_SUITE(deferred_suite)
+
+BOOST_FIXTURE_TEST_CASE(deferred1, TestVector) {
+  std::vector<float> swap_val{0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f, 0.7f};
+  std::vector<float> prev_val{0.2f, 0.2f, 0.1f, 0.9f, 0.5f, 0.3f, 0.1f};
+  float blocking    = l2loss(swap_val, prev_val, 0.05f, false);
+  float nonblocking = l2loss(swap_val, prev_val, 0.05f, true);
+  BOOST_ASSERT(std::fabs(blocking - nonblocking) < 1e-5);
+}
+
+BOOST_FIXTURE_TEST_CASE(deferred2, TestVector) {
+  graphblas::Index n = 100000;
+  std::vector<float> swap_val(n);
+  std::vector<float> prev_val(n);
+  for (graphblas::Index i = 0; i < n; ++i) {
+    swap_val[i] = static_cast<float>(i % 97)/97.f;
+    prev_val[i] = static_cast<float>(i % 89)/89.f;
+  }
+  float blocking    = l2loss(swap_val, prev_val, 0.001f, false);
+  float nonblocking = l2loss(swap_val, prev_val, 0.001f, true);
+  BOOST_ASSERT(std::fabs(blocking - nonblocking) < 1e-3*blocking);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
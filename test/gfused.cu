@@ -0,0 +1,386 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "graphblas/graphblas.hpp"
+#include "test/test.hpp"
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE fused_suite
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+void testEWiseMultReduce( const std::vector<float>& u_val,
+                          const std::vector<float>& v_val,
+                          graphblas::Desc_value     backend,
+                          po::variables_map&        vm )
+{
+  float correct = 0.f;
+  for (graphblas::Index i = 0; i < u_val.size(); ++i)
+    correct += u_val[i]*v_val[i];
+
+  graphblas::Vector<float> u(u_val.size());
+  graphblas::Vector<float> v(v_val.size());
+  CHECKVOID(u.build(&u_val, u_val.size()));
+  CHECKVOID(v.build(&v_val, v_val.size()));
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+
+  float val = 0.f;
+  CHECKVOID(graphblas::eWiseMultReduce<float, float, float>(&val, GrB_NULL,
+      graphblas::PlusMultipliesSemiring<float>(), &u, &v, &desc));
+  BOOST_ASSERT( val == correct );
+}
+
+void testVxmReduce( char const*               mtx,
+                    const std::vector<float>& vec,
+                    graphblas::Desc_value     backend,
+                    po::variables_map&        vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  std::vector<float> correct(ncols, 0.f);
+  for (graphblas::Index row = 0; row < nrows; ++row)
+  {
+    graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+    graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+    for (; row_start < row_end; ++row_start)
+    {
+      graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+      correct[col] += a.matrix_.sparse_.h_csrVal_[row_start]*vec[row];
+    }
+  }
+  float correct_sum = 0.f;
+  for (graphblas::Index i = 0; i < ncols; ++i)
+    correct_sum += correct[i];
+
+  graphblas::Vector<float> x(nrows);
+  CHECKVOID(x.build(&vec, vec.size()));
+  graphblas::Vector<float> y(ncols);
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+
+  float sum = 0.f;
+  CHECKVOID(graphblas::vxmReduce<float, float, float, float, float>(&y, &sum,
+      GrB_NULL, GrB_NULL, graphblas::PlusMonoid<float>(),
+      graphblas::PlusMultipliesSemiring<float>(), &x, &a, &desc));
+
+  y.vector_.sparse2dense(0.f, &desc.descriptor_);
+  y.extractTuples( &values, &ncols );
+  BOOST_ASSERT( ncols == correct.size() );
+  BOOST_ASSERT_LIST( values, correct, ncols );
+  BOOST_ASSERT( sum == correct_sum );
+}
+
+// Masked-out rows of y keep their old value, or become 0 under GrB_REPLACE
+void testVxmReduceMask( char const*               mtx,
+                        const std::vector<float>& vec,
+                        const std::vector<float>& mask_val,
+                        bool                      use_repl,
+                        graphblas::Desc_value     backend,
+                        po::variables_map&        vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+  const float old_val = 7.f;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  std::vector<float> product(ncols, 0.f);
+  for (graphblas::Index row = 0; row < nrows; ++row)
+  {
+    graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+    graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+    for (; row_start < row_end; ++row_start)
+    {
+      graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+      product[col] += a.matrix_.sparse_.h_csrVal_[row_start]*vec[row];
+    }
+  }
+  std::vector<float> correct(ncols);
+  float correct_sum = 0.f;
+  for (graphblas::Index i = 0; i < ncols; ++i)
+  {
+    if (mask_val[i] != 0.f)
+      correct[i] = product[i];
+    else
+      correct[i] = (use_repl) ? 0.f : old_val;
+    correct_sum += correct[i];
+  }
+
+  graphblas::Vector<float> x(nrows);
+  CHECKVOID(x.build(&vec, vec.size()));
+  graphblas::Vector<float> mask(ncols);
+  CHECKVOID(mask.build(&mask_val, mask_val.size()));
+  std::vector<float> y_val(ncols, old_val);
+  graphblas::Vector<float> y(ncols);
+  CHECKVOID(y.build(&y_val, y_val.size()));
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+  if (use_repl)
+    CHECKVOID(desc.set(graphblas::GrB_OUTP, graphblas::GrB_REPLACE));
+
+  float sum = 0.f;
+  CHECKVOID(graphblas::vxmReduce<float, float, float, float, float>(&y, &sum,
+      &mask, GrB_NULL, graphblas::PlusMonoid<float>(),
+      graphblas::PlusMultipliesSemiring<float>(), &x, &a, &desc));
+
+  y.extractTuples( &values, &ncols );
+  BOOST_ASSERT( ncols == correct.size() );
+  BOOST_ASSERT_LIST( values, correct, ncols );
+  BOOST_ASSERT( sum == correct_sum );
+}
+
+void testVxmAccumMask( char const*               mtx,
+                       const std::vector<float>& dist,
+                       const std::vector<float>& frontier,
+                       graphblas::Desc_value     backend,
+                       po::variables_map&        vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+  const float inf = std::numeric_limits<float>::max();
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  // One min-plus relaxation from the frontier
+  std::vector<float> correct = dist;
+  for (graphblas::Index row = 0; row < nrows; ++row)
+  {
+    if (frontier[row] == inf)
+      continue;
+    graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+    graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+    for (; row_start < row_end; ++row_start)
+    {
+      graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+      correct[col] = std::min(correct[col],
+          frontier[row] + a.matrix_.sparse_.h_csrVal_[row_start]);
+    }
+  }
+  std::vector<float> correct_changed(ncols, inf);
+  graphblas::Index correct_nchanged = 0;
+  for (graphblas::Index i = 0; i < ncols; ++i)
+  {
+    if (correct[i] != dist[i])
+    {
+      correct_changed[i] = correct[i];
+      correct_nchanged++;
+    }
+  }
+
+  graphblas::Vector<float> v(nrows);
+  graphblas::Vector<float> f(nrows);
+  graphblas::Vector<float> changed(nrows);
+  CHECKVOID(v.build(&dist, dist.size()));
+  CHECKVOID(f.build(&frontier, frontier.size()));
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+
+  graphblas::Index nchanged = 0;
+  CHECKVOID(graphblas::vxmAccumMask<float, float, float, float>(&v, &changed,
+      &nchanged, GrB_NULL, graphblas::minimum<float>(),
+      graphblas::MinimumPlusSemiring<float>(), &f, &a, &desc));
+
+  BOOST_ASSERT( nchanged == correct_nchanged );
+  v.extractTuples( &values, &ncols );
+  BOOST_ASSERT_LIST( values, correct, ncols );
+  changed.extractTuples( &values, &ncols );
+  BOOST_ASSERT_LIST( values, correct_changed, ncols );
+}
+
+void testMxmAccumMask( char const*             mtx,
+                       const std::vector<int>& col_mask,
+                       graphblas::Desc_value   backend,
+                       po::variables_map&      vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+  const float inf = std::numeric_limits<float>::max();
+  const graphblas::Index k = col_mask.size();
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  // Source j of column j at distance j, everything else unreached
+  std::vector<float> dist(nrows*k, inf);
+  for (graphblas::Index j = 0; j < k; ++j)
+    dist[j*k + j] = static_cast<float>(j);
+
+  // One min-plus relaxation along out-edges of the masked columns
+  std::vector<float> correct = dist;
+  for (graphblas::Index row = 0; row < nrows; ++row)
+  {
+    graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+    graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+    for (; row_start < row_end; ++row_start)
+    {
+      graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+      for (graphblas::Index j = 0; j < k; ++j)
+        if (col_mask[j] != 0 && dist[row*k + j] != inf)
+          correct[col*k + j] = std::min(correct[col*k + j],
+              dist[row*k + j] + a.matrix_.sparse_.h_csrVal_[row_start]);
+    }
+  }
+  std::vector<int> correct_mask(k, 0);
+  graphblas::Index correct_nactive = 0;
+  for (graphblas::Index j = 0; j < k; ++j)
+  {
+    for (graphblas::Index i = 0; i < nrows; ++i)
+      if (correct[i*k + j] != dist[i*k + j])
+        correct_mask[j] = 1;
+    correct_nactive += correct_mask[j];
+  }
+
+  graphblas::Matrix<float> d(nrows, k);
+  CHECKVOID(d.build(&dist, dist.size()));
+  graphblas::Vector<int> mask(k);
+  CHECKVOID(mask.build(&col_mask, k));
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+  CHECKVOID(desc.toggle(graphblas::GrB_INP0));
+
+  graphblas::Index nactive = 0;
+  CHECKVOID(graphblas::mxmAccumMask<float, int, float, float>(&d, &mask,
+      &nactive, graphblas::minimum<float>(),
+      graphblas::MinimumPlusSemiring<float>(), &a, &d, &desc));
+
+  BOOST_ASSERT( nactive == correct_nactive );
+  graphblas::Index d_nvals = nrows*k;
+  d.extractTuples( &values, &d_nvals );
+  BOOST_ASSERT_LIST( values, correct, d_nvals );
+  std::vector<int> mask_val;
+  graphblas::Index k_nvals = k;
+  mask.extractTuples( &mask_val, &k_nvals );
+  BOOST_ASSERT_LIST( mask_val, correct_mask, k );
+}
+
+struct TestMatrix
+{
+  TestMatrix() :
+    DEBUG(true) {}
+
+  bool DEBUG;
+};
+
+BOOST_AUTO_TEST_SUITE(fused_suite)
+
+BOOST_FIXTURE_TEST_CASE( fused1, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<float> u_val{1., 2., 0., 4., 5., 0., 7., 8.};
+  std::vector<float> v_val{2., 0., 3., 1., 2., 0., 1., 3.};
+  testEWiseMultReduce( u_val, v_val, graphblas::GrB_CUDA, vm );
+  testEWiseMultReduce( u_val, v_val, graphblas::GrB_SEQUENTIAL, vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( fused2, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<float> vec{1., 2., 0., 4., 0., 1., 3., 0., 2., 1., 5.};
+  testVxmReduce( "data/small/test_cc.mtx", vec, graphblas::GrB_CUDA, vm );
+  testVxmReduce( "data/small/test_cc.mtx", vec, graphblas::GrB_SEQUENTIAL,
+      vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( fused3, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  const float inf = std::numeric_limits<float>::max();
+  std::vector<float> dist{0., 1., inf, inf, 1., inf, inf, inf, inf, inf,
+                          inf};
+  std::vector<float> frontier{inf, 1., inf, inf, 1., inf, inf, inf, inf, inf,
+                              inf};
+  testVxmAccumMask( "data/small/test_cc.mtx", dist, frontier,
+      graphblas::GrB_CUDA, vm );
+  testVxmAccumMask( "data/small/test_cc.mtx", dist, frontier,
+      graphblas::GrB_SEQUENTIAL, vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( fused4, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<int> col_mask{1, 0, 1, 1, 0};
+  testMxmAccumMask( "data/small/test_cc.mtx", col_mask, graphblas::GrB_CUDA,
+      vm );
+  testMxmAccumMask( "data/small/test_cc.mtx", col_mask,
+      graphblas::GrB_SEQUENTIAL, vm );
+}
+BOOST_FIXTURE_TEST_CASE( fused5, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<float> vec{1., 2., 0., 4., 0., 1., 3., 0., 2., 1., 5.};
+  std::vector<float> mask{1., 0., 1., 1., 0., 0., 1., 0., 1., 1., 0.};
+  testVxmReduceMask( "data/small/test_cc.mtx", vec, mask, false,
+      graphblas::GrB_SEQUENTIAL, vm );
+  testVxmReduceMask( "data/small/test_cc.mtx", vec, mask, true,
+      graphblas::GrB_SEQUENTIAL, vm );
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "graphblas/graphblas.hpp"
+#include "test/test.hpp"
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE intersect_suite
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+// Sorted list of up to n distinct indices in [0, range)
+std::vector<graphblas::Index> randomList( int n, int range )
+{
+  std::vector<graphblas::Index> list;
+  for (int i = 0; i < n; ++i)
+    list.push_back(rand() % range);
+  std::sort(list.begin(), list.end());
+  list.erase(std::unique(list.begin(), list.end()), list.end());
+  return list;
+}
+
+// Every mode and the bitmap probe against std::set_intersection
+void testIntersect( int na, int nb, int range )
+{
+  using graphblas::Index;
+  std::vector<Index> a = randomList(na, range);
+  std::vector<Index> b = randomList(nb, range);
+  std::vector<Index> correct;
+  std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+      std::back_inserter(correct));
+  const Index ncorrect = correct.size();
+
+  BOOST_ASSERT( graphblas::backend::intersectCount(a.data(), a.size(),
+      b.data(), b.size()) == ncorrect );
+
+  std::vector<Index> a_ind(ncorrect);
+  std::vector<Index> b_ind(ncorrect);
+  BOOST_ASSERT( graphblas::backend::intersectIndices(a.data(), a.size(),
+      b.data(), b.size(), a_ind.data(), b_ind.data()) == ncorrect );
+  for (Index k = 0; k < ncorrect; ++k)
+    BOOST_ASSERT( a[a_ind[k]] == correct[k] && b[b_ind[k]] == correct[k] );
+
+  std::vector<float> a_val(a.begin(), a.end());
+  std::vector<float> b_val(b.begin(), b.end());
+  std::vector<Index> c_ind(ncorrect);
+  std::vector<float> c_val(ncorrect);
+  BOOST_ASSERT( graphblas::backend::intersectValues(a.data(), a_val.data(),
+      static_cast<Index>(a.size()), b.data(), b_val.data(),
+      static_cast<Index>(b.size()), c_ind.data(), c_val.data(),
+      std::plus<float>()) == ncorrect );
+  for (Index k = 0; k < ncorrect; ++k)
+    BOOST_ASSERT( c_ind[k] == correct[k] && c_val[k] == 2.f*correct[k] );
+
+  graphblas::backend::IntersectBitmap hub(range);
+  graphblas::backend::IntersectIndices emit = {a_ind.data(), b_ind.data(),
+      0};
+  hub.set(a.data(), a.size());
+  BOOST_ASSERT( hub.probe(b.data(), b.size(), &emit) == ncorrect );
+  hub.unset(a.data(), a.size());
+  for (Index k = 0; k < ncorrect; ++k)
+    BOOST_ASSERT( a[a_ind[k]] == correct[k] && b[b_ind[k]] == correct[k] );
+}
+
+struct TestMatrix
+{
+  TestMatrix() :
+    DEBUG(true) {}
+
+  bool DEBUG;
+};
+
+BOOST_AUTO_TEST_SUITE(intersect_suite)
+
+// Short lists: scalar merge
+BOOST_FIXTURE_TEST_CASE( intersect1, TestMatrix )
+{
+  srand(1);
+  for (int t = 0; t < 1000; ++t)
+    testIntersect(rand() % 8, rand() % 8, 16);
+}
+
+// Similar lengths: SIMD blocks when built for AVX2 or AVX-512
+BOOST_FIXTURE_TEST_CASE( intersect2, TestMatrix )
+{
+  srand(2);
+  for (int t = 0; t < 1000; ++t)
+    testIntersect(rand() % 300, rand() % 300, 1 + rand() % 1000);
+}
+
+// Skewed lengths: galloping
+BOOST_FIXTURE_TEST_CASE( intersect3, TestMatrix )
+{
+  srand(3);
+  for (int t = 0; t < 1000; ++t)
+    testIntersect(2000 + rand() % 2000, rand() % 40, 1 + rand() % 10000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
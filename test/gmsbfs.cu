@@ -0,0 +1,103 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/bfs.hpp"
+#include "graphblas/algorithm/msbfs.hpp"
+#include "test/test.hpp"
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE msbfs_suite
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+// Every source of the graph in one batch, checked row by row against the CPU
+// reference BFS
+void testMsBfs( char const*           mtx,
+                graphblas::Desc_value backend,
+                po::variables_map&    vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+
+  std::vector<graphblas::Index> sources;
+  for (graphblas::Index s = 0; s < nrows; ++s)
+    sources.push_back(s);
+
+  graphblas::Matrix<int> v(sources.size(), nrows);
+  std::vector<graphblas::Index> ecc;
+  CHECKVOID(graphblas::msBfs<int, float>(&v, &ecc, &a, &sources, &desc));
+
+  std::vector<int> v_val;
+  graphblas::Index v_nvals = sources.size()*nrows;
+  CHECKVOID(v.extractTuples(&v_val, &v_nvals));
+
+  std::vector<graphblas::Index> h_bfs_cpu(nrows);
+  for (graphblas::Index k = 0; k < sources.size(); ++k)
+  {
+    graphblas::algorithm::bfsCpu(sources[k], &a, h_bfs_cpu.data(), 10000);
+    std::vector<int> row(v_val.begin() + k*nrows,
+                         v_val.begin() + (k+1)*nrows);
+    BOOST_ASSERT_LIST( h_bfs_cpu, row, nrows );
+
+    graphblas::Index correct_ecc = *std::max_element(h_bfs_cpu.begin(),
+        h_bfs_cpu.end()) - 1;
+    BOOST_ASSERT( ecc[k] == correct_ecc );
+  }
+}
+
+struct TestMatrix
+{
+  TestMatrix() :
+    DEBUG(true) {}
+
+  bool DEBUG;
+};
+
+BOOST_AUTO_TEST_SUITE(msbfs_suite)
+
+BOOST_FIXTURE_TEST_CASE( msbfs1, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "0"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  testMsBfs( "data/small/chesapeake.mtx", graphblas::GrB_CUDA, vm );
+  testMsBfs( "data/small/chesapeake.mtx", graphblas::GrB_SEQUENTIAL, vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( msbfs2, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "0"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  testMsBfs( "data/small/simulated_blockmodel_graph_100_nodes.mtx",
+      graphblas::GrB_CUDA, vm );
+  testMsBfs( "data/small/simulated_blockmodel_graph_100_nodes.mtx",
+      graphblas::GrB_SEQUENTIAL, vm );
+}
+BOOST_AUTO_TEST_SUITE_END()
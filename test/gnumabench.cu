@@ -0,0 +1,101 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <boost/program_options.hpp>
+
+#include "graphblas/graphblas.hpp"
+#include "test/test.hpp"
+
+// Measures CPU-backend SpMV scaling from one socket to all sockets. Threads
+// are pinned compactly, so n sockets means the first n nodes are fully used.
+// Placement of graph arrays is controlled by GRB_NUMA_POLICY.
+int main(int argc, char** argv) {
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Parse arguments
+  bool debug;
+  bool mtxinfo;
+  int  directed;
+  int  niter;
+  po::variables_map vm;
+
+  // Read in sparse matrix
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s [matrix-market-filename]\n", argv[0]);
+    exit(1);
+  } else {
+    parseArgs(argc, argv, &vm);
+    debug    = vm["debug"   ].as<bool>();
+    mtxinfo  = vm["mtxinfo" ].as<bool>();
+    directed = vm["directed"].as<int>();
+    niter    = vm["niter"   ].as<int>();
+    readMtx(argv[argc-1], &row_indices, &col_indices, &values, &nrows, &ncols,
+        &nvals, directed, mtxinfo);
+  }
+
+  // Compact pinning unless user asked for something else
+  setEnv("GRB_NUMA_PIN_THREADS", 1);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECK(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+  CHECK(a.nrows(&nrows));
+  CHECK(a.ncols(&ncols));
+  CHECK(a.nvals(&nvals));
+  if (debug) CHECK(a.print());
+
+  // Vector x
+  graphblas::Vector<float> x(nrows);
+  CHECK(x.fill(1.f));
+
+  // Vector y
+  graphblas::Vector<float> y(nrows);
+
+  // Descriptor
+  graphblas::Descriptor desc;
+  CHECK(desc.loadArgs(vm));
+  CHECK(desc.set(graphblas::GrB_MXVMODE, graphblas::GrB_PULLONLY));
+  CHECK(desc.set(graphblas::GrB_BACKEND, graphblas::GrB_SEQUENTIAL));
+
+  int nsockets = numaNodes();
+  int nthreads = numThreads();
+  int threads_per_socket = std::max(1, nthreads/nsockets);
+  std::cout << "policy, " << getEnv("GRB_NUMA_POLICY", 0) << std::endl;
+  std::cout << "sockets, threads, ms, gflops\n";
+
+  for (int socket = 1; socket <= nsockets; ++socket) {
+    int threads = (socket == nsockets) ? nthreads : socket*threads_per_socket;
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+    numaPinThreads(true);
+
+    // Warmup
+    graphblas::vxm<float, float, float, float>(&y, GrB_NULL, GrB_NULL,
+        graphblas::PlusMultipliesSemiring<float>(), &x, &a, &desc);
+
+    CpuTimer cpu_vxm;
+    cpu_vxm.Start();
+    for (int i = 0; i < niter; ++i)
+      graphblas::vxm<float, float, float, float>(&y, GrB_NULL, GrB_NULL,
+          graphblas::PlusMultipliesSemiring<float>(), &x, &a, &desc);
+    cpu_vxm.Stop();
+
+    float elapsed = cpu_vxm.ElapsedMillis()/niter;
+    std::cout << socket << ", " << threads << ", " << elapsed << ", " <<
+        2.0*nvals/elapsed/1000000.0 << std::endl;
+  }
+
+  if (debug) CHECK(y.print());
+  return 0;
+}
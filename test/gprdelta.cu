@@ -0,0 +1,111 @@
+#define GRB_USE_CUDA
+#define private public
+
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "graphblas/graphblas.hpp"
+#include "graphblas/algorithm/pr.hpp"
+#include "test/test.hpp"
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE prdelta_suite
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/program_options.hpp>
+
+// Delta PageRank against power-iteration PageRank on the same matrix. Both
+// stop at eps, so they are compared within a tolerance
+void testPrDelta( char const*           mtx,
+                  bool                  in_place,
+                  graphblas::Desc_value backend,
+                  po::variables_map&    vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+
+  float alpha = 0.85;
+  float eps   = 1e-8;
+
+  // Matrix A = alpha*A/outdegrees
+  graphblas::Matrix<float> a(nrows, ncols);
+  values.clear();
+  values.insert(values.begin(), nvals, 1.f);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  graphblas::Vector<float> outdegrees(nrows);
+  graphblas::reduce<float, float, float>(&outdegrees, GrB_NULL, GrB_NULL,
+      graphblas::PlusMonoid<float>(), &a, &desc);
+  graphblas::eWiseMult<float, float, float, float>(&a, GrB_NULL, GrB_NULL,
+      graphblas::PlusMultipliesSemiring<float>(), &a, alpha, &desc);
+  graphblas::eWiseMult<float, float, float, float>(&a, GrB_NULL, GrB_NULL,
+      graphblas::PlusDividesSemiring<float>(), &a, &outdegrees, &desc);
+
+  graphblas::Vector<float> p(nrows);
+  graphblas::Vector<float> p_delta(nrows);
+  graphblas::algorithm::pr(&p, &a, alpha, eps, &desc);
+  graphblas::algorithm::prDelta(&p_delta, &a, alpha, eps, in_place, &desc);
+
+  std::vector<float> p_val;
+  std::vector<float> p_delta_val;
+  graphblas::Index p_nvals = nrows;
+  CHECKVOID(p.extractTuples(&p_val, &p_nvals));
+  p_nvals = nrows;
+  CHECKVOID(p_delta.extractTuples(&p_delta_val, &p_nvals));
+
+  BOOST_ASSERT( p_nvals == nrows );
+  for (graphblas::Index i = 0; i < nrows; ++i)
+    BOOST_ASSERT_FLOAT( p_delta_val[i], p_val[i], 1e-4f );
+}
+
+struct TestMatrix
+{
+  TestMatrix() :
+    DEBUG(true) {}
+
+  bool DEBUG;
+};
+
+BOOST_AUTO_TEST_SUITE(prdelta_suite)
+
+BOOST_FIXTURE_TEST_CASE( prdelta1, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "0"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  testPrDelta( "data/small/test_pr.mtx", false, graphblas::GrB_CUDA, vm );
+  testPrDelta( "data/small/test_pr.mtx", false, graphblas::GrB_SEQUENTIAL,
+      vm );
+  testPrDelta( "data/small/test_pr.mtx", true, graphblas::GrB_SEQUENTIAL,
+      vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( prdelta2, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "0"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  testPrDelta( "data/small/chesapeake.mtx", false, graphblas::GrB_CUDA, vm );
+  testPrDelta( "data/small/chesapeake.mtx", false, graphblas::GrB_SEQUENTIAL,
+      vm );
+  testPrDelta( "data/small/chesapeake.mtx", true, graphblas::GrB_SEQUENTIAL,
+      vm );
+}
+BOOST_AUTO_TEST_SUITE_END()
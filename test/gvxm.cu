@@ -220,6 +220,207 @@ void testVxmSparseSparseDenseMask(
   BOOST_ASSERT( nrows == correct.size() );
   BOOST_ASSERT_LIST( values, correct, nrows );
 }
+void testVxmBooleanCpu( char const*               mtx,
+                        const std::vector<float>& vec,
+                        const std::vector<float>& mask_val,
+                        int                       use_mask,
+                        po::variables_map&        vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  std::vector<float> correct(ncols, 0.f);
+  for (graphblas::Index row = 0; row < nrows; ++row)
+  {
+    graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+    graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+    for (; row_start < row_end; ++row_start)
+    {
+      graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+      if (vec[row] != 0.f)
+        correct[col] = 1.f;
+    }
+  }
+  graphblas::Index correct_nnz = 0;
+  for (graphblas::Index i = 0; i < correct.size(); ++i)
+  {
+    if (use_mask == 0 && mask_val[i] == 0)
+      correct[i] = 0.f;
+    else if (use_mask == 1 && mask_val[i] != 0)
+      correct[i] = 0.f;
+    if (correct[i] != 0.f)
+      correct_nnz++;
+  }
+
+  graphblas::Vector<float> x(nrows);
+  CHECKVOID(x.build(&vec, vec.size()));
+  graphblas::Vector<float> mask(nrows);
+  CHECKVOID(mask.build(&mask_val, mask_val.size()));
+  graphblas::Vector<float> y(nrows);
+
+  // Pull-only CPU backend takes the packed-word LogicalOrAnd kernel
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, graphblas::GrB_SEQUENTIAL));
+  CHECKVOID(desc.set(graphblas::GrB_MXVMODE, graphblas::GrB_PULLONLY));
+  if (use_mask == 1)
+    CHECKVOID(desc.set(graphblas::GrB_MASK, graphblas::GrB_SCMP));
+
+  CHECKVOID(graphblas::vxm<float, float, float, float>(&y, &mask, GrB_NULL,
+      graphblas::LogicalOrAndSemiring<float>(), &x, &a, &desc));
+  BOOST_ASSERT( y.vector_.dense_.nnz_ == correct_nnz );
+
+  y.extractTuples( &values, &ncols );
+  BOOST_ASSERT( ncols == correct.size() );
+  BOOST_ASSERT_LIST( values, correct, ncols );
+}
+
+// Pull vxm with MaximumSelectSecondSemiring under a complemented mask, as in
+// one step of BFS with parents. vec holds vertex id + 1 for frontier vertices
+// and 0 elsewhere. With early exit any frontier neighbour is a valid answer.
+void testVxmParent( char const*               mtx,
+                    const std::vector<int>&   vec,
+                    const std::vector<float>& mask_val,
+                    graphblas::Desc_value     backend,
+                    po::variables_map&        vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  graphblas::Vector<int> x(nrows);
+  CHECKVOID(x.build(&vec, vec.size()));
+  graphblas::Vector<float> mask(nrows);
+  CHECKVOID(mask.build(&mask_val, mask_val.size()));
+  graphblas::Vector<int> y(nrows);
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, backend));
+  CHECKVOID(desc.set(graphblas::GrB_MXVMODE, graphblas::GrB_PULLONLY));
+  CHECKVOID(desc.set(graphblas::GrB_MASK, graphblas::GrB_SCMP));
+
+  CHECKVOID(graphblas::vxm<int, float, int, float>(&y, &mask, GrB_NULL,
+      graphblas::MaximumSelectSecondSemiring<float, int, int>(), &x, &a,
+      &desc));
+
+  std::vector<int> y_val;
+  y.extractTuples( &y_val, &ncols );
+  BOOST_ASSERT( ncols == nrows );
+  for (graphblas::Index col = 0; col < ncols; ++col)
+  {
+    bool discoverable = false;
+    bool valid = (y_val[col] == 0);
+    for (graphblas::Index row = 0; row < nrows; ++row)
+    {
+      if (vec[row] == 0)
+        continue;
+      graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+      graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+      for (; row_start < row_end; ++row_start)
+      {
+        if (a.matrix_.sparse_.h_csrColInd_[row_start] == col)
+        {
+          discoverable = true;
+          if (y_val[col] == vec[row])
+            valid = true;
+        }
+      }
+    }
+    if (mask_val[col] != 0.f)
+      BOOST_ASSERT( y_val[col] == 0 );
+    else
+      BOOST_ASSERT( valid && (discoverable == (y_val[col] != 0)) );
+  }
+}
+
+// Bool-typed packed LogicalOrAnd vxm on the CPU backend, twice into the same
+// output. The second call takes the path that only writes back the words
+// of y that change.
+void testVxmBooleanCpuBool( char const*              mtx,
+                            const std::vector<bool>& vec1,
+                            const std::vector<bool>& vec2,
+                            const std::vector<bool>& mask_val,
+                            po::variables_map&       vm )
+{
+  std::vector<graphblas::Index> row_indices;
+  std::vector<graphblas::Index> col_indices;
+  std::vector<float> values;
+  graphblas::Index nrows, ncols, nvals;
+
+  // Read in sparse matrix
+  readMtx(mtx, &row_indices, &col_indices, &values, &nrows, &ncols, &nvals, 0,
+          false);
+
+  // Matrix A
+  graphblas::Matrix<float> a(nrows, ncols);
+  CHECKVOID(a.build(&row_indices, &col_indices, &values, nvals, GrB_NULL));
+
+  graphblas::Vector<bool> mask(nrows);
+  CHECKVOID(mask.build(&mask_val, mask_val.size()));
+  graphblas::Vector<bool> y(nrows);
+
+  graphblas::Descriptor desc;
+  CHECKVOID(desc.loadArgs(vm));
+  CHECKVOID(desc.set(graphblas::GrB_BACKEND, graphblas::GrB_SEQUENTIAL));
+  CHECKVOID(desc.set(graphblas::GrB_MXVMODE, graphblas::GrB_PULLONLY));
+
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    const std::vector<bool>& vec = (pass == 0) ? vec1 : vec2;
+    std::vector<bool> correct(ncols, false);
+    for (graphblas::Index row = 0; row < nrows; ++row)
+    {
+      graphblas::Index row_start = a.matrix_.sparse_.h_csrRowPtr_[row];
+      graphblas::Index row_end   = a.matrix_.sparse_.h_csrRowPtr_[row+1];
+      for (; row_start < row_end; ++row_start)
+      {
+        graphblas::Index col = a.matrix_.sparse_.h_csrColInd_[row_start];
+        if (vec[row] && mask_val[col])
+          correct[col] = true;
+      }
+    }
+    graphblas::Index correct_nnz = std::count(correct.begin(), correct.end(),
+        true);
+
+    graphblas::Vector<bool> x(nrows);
+    CHECKVOID(x.build(&vec, vec.size()));
+    CHECKVOID(graphblas::vxm<bool, bool, bool, float>(&y, &mask, GrB_NULL,
+        graphblas::LogicalOrAndSemiring<float, bool, bool>(), &x, &a, &desc));
+    BOOST_ASSERT( y.vector_.dense_.nnz_ == correct_nnz );
+
+    std::vector<bool> y_val;
+    graphblas::Index y_nvals = nrows;
+    CHECKVOID(y.extractTuples(&y_val, &y_nvals));
+    BOOST_ASSERT( y_nvals == correct.size() );
+    BOOST_ASSERT_LIST( y_val, correct, y_nvals );
+
+    // The device copy must match too, words that did not change included
+    CHECKVOID(y.vector_.dense_.gpuToCpu(true));
+    y.extractTuples(&y_val, &y_nvals);
+    BOOST_ASSERT_LIST( y_val, correct, y_nvals );
+  }
+}
+
 struct TestMatrix
 {
   TestMatrix() :
@@ -299,4 +500,40 @@ BOOST_FIXTURE_TEST_CASE( dup6, TestMatrix )
   testVxmSparseSparseDenseMask("data/small/test_sgm.mtx", vec_ind, vec_val, mask_val,
                                0, vm);
 }
+BOOST_FIXTURE_TEST_CASE( dup7, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<float> vec{1., 0., 0., 1., 0., 0., 0., 0., 1., 0., 0.};
+  std::vector<float> mask_val{1., 0., 0., 1., 0., 1., 1., 1., 1., 1., 0.};
+  testVxmBooleanCpu( "data/small/test_cc.mtx", vec, mask_val, 0, vm );
+  testVxmBooleanCpu( "data/small/test_cc.mtx", vec, mask_val, 1, vm );
+}
+
+BOOST_FIXTURE_TEST_CASE( dup8, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<int> vec{1, 0, 0, 4, 0, 0, 0, 0, 9, 0, 0};
+  std::vector<float> mask_val{1., 0., 0., 1., 0., 1., 1., 1., 1., 1., 0.};
+  testVxmParent( "data/small/test_cc.mtx", vec, mask_val, graphblas::GrB_CUDA,
+      vm );
+  testVxmParent( "data/small/test_cc.mtx", vec, mask_val,
+      graphblas::GrB_SEQUENTIAL, vm );
+}
+BOOST_FIXTURE_TEST_CASE( dup9, TestMatrix )
+{
+  int argc = 3;
+  char* argv[] = {"app", "--debug", "1"};
+  po::variables_map vm;
+  parseArgs(argc, argv, &vm);
+  std::vector<bool> vec1{1, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0};
+  std::vector<bool> vec2{0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 0};
+  std::vector<bool> mask_val{1, 0, 0, 1, 0, 1, 1, 1, 1, 1, 0};
+  testVxmBooleanCpuBool( "data/small/test_cc.mtx", vec1, vec2, mask_val, vm );
+}
 BOOST_AUTO_TEST_SUITE_END()